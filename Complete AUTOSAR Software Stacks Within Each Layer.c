@@ -103,38 +103,364 @@ FUNC(void, SensorControl_CODE) SensorControl_10msRunnable(void) {
         
         // Step 6: Provide to other SWCs
         (void)Rte_Write_PP_DoorSwitch_DoorSwitch(conditioned_signal);
+        
+        // Every edge is queued for the logger, not just the latest value
+        static boolean previous_signal = FALSE;
+        if (conditioned_signal != previous_signal) {
+            (void)Rte_Send_PP_DoorEvent_DoorEvent(conditioned_signal);
+            previous_signal = conditioned_signal;
+        }
     }
 }
 
+// File: DoorLogger_Swc.c - Door Event Logging SWC
+#include "Rte_DoorLogger.h"
+
+#define DOORLOGGER_BATCH_SIZE       8u
+#define DOORLOGGER_HISTORY_SIZE     64u
+
+static boolean DoorLogger_History[DOORLOGGER_HISTORY_SIZE];
+static uint16 DoorLogger_HistoryPos = 0;
+static uint16 DoorLogger_LostEvents = 0;
+
+FUNC(void, DoorLogger_CODE) DoorLogger_10msRunnable(void) {
+    // Drain the door event queue in batches
+    boolean events[DOORLOGGER_BATCH_SIZE];
+    uint8 count = 0;
+    uint8 i;
+    Std_ReturnType ret;
+    
+    do {
+        ret = Rte_ReceiveBatch_RP_DoorEvent_DoorEvent(events, DOORLOGGER_BATCH_SIZE, &count);
+        if (ret == RTE_E_LOST_DATA) {
+            DoorLogger_LostEvents++;    // Queue overflowed since the last receive
+        }
+        for (i = 0; i < count; i++) {
+            DoorLogger_History[DoorLogger_HistoryPos % DOORLOGGER_HISTORY_SIZE] = events[i];
+            DoorLogger_HistoryPos++;
+        }
+    } while (count == DOORLOGGER_BATCH_SIZE);
+}
+
 /* =========================================================================
  * RUNTIME ENVIRONMENT (RTE) - COMPLETE RTE STACK
  * ========================================================================= */
 
+/* RTE CONFIGURATION */
+// File: Rte_Cfg.h (Auto-generated)
+/* Task context checks. The generator derives from the runnable-to-task
+ * mapping which tasks can reach each port API. Where every such task is
+ * allowed to call it, the context is proven: the API calls the BSW directly
+ * and keeps the runtime check only in development builds. APIs without such
+ * a proof go through the RTE Core wrappers, which always check. */
+#if (RTE_DEV_ERROR_DETECT == STD_ON)
+#define RTE_CHECK_PROVEN_CONTEXT()      Rte_CheckTaskContext()
+#else
+#define RTE_CHECK_PROVEN_CONTEXT()      ((void)0)
+#endif
+
 /* RTE INTERFACE LAYER */
 // File: Rte_DoorControl.c (Auto-generated)
 FUNC(Std_ReturnType, RTE_CODE) Rte_Write_DoorControl_PP_DoorStatus_DoorStatus(boolean data) {
     // Step 7: RTE Interface - Data conversion and validation
     uint8 signal_data = (data == TRUE) ? 1U : 0U;
     
-    // Step 8: Call RTE Core for routing
-    return Rte_Com_SendSignal(ComConf_ComSignal_DoorStatus, &signal_data);
+    // Step 8: Route to COM. DoorControl_MainRunnable only runs in Task_Rte_10ms,
+    // so the context is proven and COM is called without the RTE Core wrapper
+    RTE_CHECK_PROVEN_CONTEXT();
+    return Com_SendSignal(ComConf_ComSignal_DoorStatus, &signal_data);
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_Read_DoorControl_RP_DoorSwitch_DoorSwitch(P2VAR(boolean, AUTOMATIC, RTE_APPL_DATA) data) {
+    // Intra-ECU port: last-is-best value written by SensorControl
+    RTE_CHECK_PROVEN_CONTEXT();
+#if (RTE_IMPLICIT_COMMUNICATION == STD_ON)
+    // Only mapped to Task_Rte_10ms, so the task's snapshot is the data source
+    *data = Rte_Implicit_Task_Rte_10ms.DoorSwitch;
+#else
+    *data = (boolean)atomic_load_explicit(&Rte_Buf_DoorSwitch_DoorSwitch, memory_order_acquire);
+#endif
+    return RTE_E_OK;
+}
+
+// File: Rte_SensorControl.c (Auto-generated)
+FUNC(Std_ReturnType, RTE_CODE) Rte_Send_SensorControl_PP_DoorEvent_DoorEvent(boolean data) {
+    // Queued port, single sender: SPSC ring
+    RTE_CHECK_PROVEN_CONTEXT();
+    return Rte_SpscSend(&Rte_Queue_DoorEvent_DoorEvent, &data);
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_Write_SensorControl_PP_DoorSwitch_DoorSwitch(boolean data) {
+    RTE_CHECK_PROVEN_CONTEXT();
+#if (RTE_IMPLICIT_COMMUNICATION == STD_ON)
+    Rte_Implicit_Task_Rte_10ms.DoorSwitch = data;
+#else
+    atomic_store_explicit(&Rte_Buf_DoorSwitch_DoorSwitch, (uint64)data, memory_order_release);
+#endif
+    return RTE_E_OK;
+}
+
+// File: Rte_DoorLogger.c (Auto-generated)
+FUNC(Std_ReturnType, RTE_CODE) Rte_Receive_DoorLogger_RP_DoorEvent_DoorEvent(P2VAR(boolean, AUTOMATIC, RTE_APPL_DATA) data) {
+    uint8 Count;
+
+    RTE_CHECK_PROVEN_CONTEXT();
+    return Rte_QueueReceive(&Rte_Queue_DoorEvent_DoorEvent, data, 1u, &Count);
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_ReceiveBatch_DoorLogger_RP_DoorEvent_DoorEvent(P2VAR(boolean, AUTOMATIC, RTE_APPL_DATA) data, uint8 MaxCount, P2VAR(uint8, AUTOMATIC, RTE_APPL_DATA) Count) {
+    RTE_CHECK_PROVEN_CONTEXT();
+    return Rte_QueueReceive(&Rte_Queue_DoorEvent_DoorEvent, data, MaxCount, Count);
+}
+
+/* RTE DATA LAYER */
+// File: Rte_Buffer.c
+/* Last-is-best storage behind intra-ECU sender-receiver ports. One writer (the
+ * runnable providing the port), any number of readers on any core:
+ * - Data elements up to 8 bytes are generated as one 64-bit atomic word, so
+ *   Rte_Write is a single store and Rte_Read a single load, both wait-free.
+ * - Larger data elements use a two-copy seqlock ("latch"). The writer bumps
+ *   Sequence before updating copy 0 and again before copy 1, so a reader
+ *   starts on the copy that is not being written. It retries if Sequence
+ *   moved while it copied, i.e. the writer began the next half-update: the
+ *   writer never waits, the read is lock-free with retries, not wait-free. */
+#include <string.h>
+#include <stdatomic.h>
+
+typedef struct {
+    atomic_uint_least32_t Sequence;     // Odd: copy 0 being written, even: copy 1 being written (or idle)
+    uint16 Size;
+    P2VAR(uint8, AUTOMATIC, RTE_VAR_NOINIT) Copy[2];
+} Rte_LatchBufferType;
+
+FUNC(void, RTE_CODE) Rte_LatchWrite(P2VAR(Rte_LatchBufferType, AUTOMATIC, RTE_VAR_NOINIT) Buffer, P2CONST(void, AUTOMATIC, RTE_APPL_DATA) Data) {
+    uint32 Seq = atomic_load_explicit(&Buffer->Sequence, memory_order_relaxed);
+
+    atomic_store_explicit(&Buffer->Sequence, Seq + 1u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    (void)memcpy(Buffer->Copy[0], Data, Buffer->Size);
+    atomic_store_explicit(&Buffer->Sequence, Seq + 2u, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    (void)memcpy(Buffer->Copy[1], Data, Buffer->Size);
+}
+
+FUNC(void, RTE_CODE) Rte_LatchRead(P2VAR(Rte_LatchBufferType, AUTOMATIC, RTE_VAR_NOINIT) Buffer, P2VAR(void, AUTOMATIC, RTE_APPL_DATA) Data) {
+    uint32 Seq;
+
+    // Lock-free: repeats only while the writer keeps advancing Sequence during the copy
+    do {
+        Seq = atomic_load_explicit(&Buffer->Sequence, memory_order_acquire);
+        (void)memcpy(Data, Buffer->Copy[Seq & 1u], Buffer->Size);
+        atomic_thread_fence(memory_order_acquire);
+    } while (atomic_load_explicit(&Buffer->Sequence, memory_order_relaxed) != Seq);
+}
+
+/* Queued sender-receiver ports: a bounded ring per receiver port with a
+ * power-of-two capacity (OsQueueLength rounded up by the generator). One
+ * sender runnable gets the SPSC variant (two indices, no read-modify-write);
+ * several senders get the MPSC variant with a sequence number per cell. The
+ * single receiver drains either with Rte_QueueReceive. A full queue drops
+ * the new element, returns RTE_E_LIMIT to the sender and reports
+ * RTE_E_LOST_DATA with the next receive. */
+typedef struct {
+    _Alignas(64) atomic_uint_least32_t Tail;        // Next position to send (claimed by senders)
+    _Alignas(64) atomic_uint_least32_t Head;        // Next position to receive
+    atomic_bool Overflow;
+    uint16 Capacity;                                // Power of two
+    uint16 ElementSize;
+    P2VAR(uint8, AUTOMATIC, RTE_VAR_NOINIT) Storage;
+    P2VAR(atomic_uint_least32_t, AUTOMATIC, RTE_VAR_NOINIT) Sequence;  // MPSC only, NULL_PTR for SPSC
+} Rte_QueueType;
+
+FUNC(void, RTE_CODE) Rte_QueueInit(P2VAR(Rte_QueueType, AUTOMATIC, RTE_VAR_NOINIT) Queue) {
+    uint16 i;
+
+    atomic_init(&Queue->Tail, 0u);
+    atomic_init(&Queue->Head, 0u);
+    atomic_init(&Queue->Overflow, false);
+    if (Queue->Sequence != NULL_PTR) {
+        for (i = 0u; i < Queue->Capacity; i++) {
+            atomic_init(&Queue->Sequence[i], i);
+        }
+    }
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_SpscSend(P2VAR(Rte_QueueType, AUTOMATIC, RTE_VAR_NOINIT) Queue, P2CONST(void, AUTOMATIC, RTE_APPL_DATA) Data) {
+    uint32 Tail = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+
+    if ((Tail - atomic_load_explicit(&Queue->Head, memory_order_acquire)) == Queue->Capacity) {
+        atomic_store_explicit(&Queue->Overflow, true, memory_order_relaxed);
+        return RTE_E_LIMIT;
+    }
+    (void)memcpy(&Queue->Storage[(Tail & (Queue->Capacity - 1u)) * Queue->ElementSize], Data, Queue->ElementSize);
+    atomic_store_explicit(&Queue->Tail, Tail + 1u, memory_order_release);
+    return RTE_E_OK;
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_MpscSend(P2VAR(Rte_QueueType, AUTOMATIC, RTE_VAR_NOINIT) Queue, P2CONST(void, AUTOMATIC, RTE_APPL_DATA) Data) {
+    uint32 Pos = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+    uint32 Index;
+
+    for (;;) {
+        sint32 Diff;
+
+        Index = Pos & (Queue->Capacity - 1u);
+        Diff = (sint32)(atomic_load_explicit(&Queue->Sequence[Index], memory_order_acquire) - Pos);
+        if (Diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&Queue->Tail, &Pos, Pos + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (Diff < 0) {
+            // Cell not yet released by the receiver: queue full
+            atomic_store_explicit(&Queue->Overflow, true, memory_order_relaxed);
+            return RTE_E_LIMIT;
+        } else {
+            Pos = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+        }
+    }
+
+    (void)memcpy(&Queue->Storage[Index * Queue->ElementSize], Data, Queue->ElementSize);
+    atomic_store_explicit(&Queue->Sequence[Index], Pos + 1u, memory_order_release);
+    return RTE_E_OK;
+}
+
+FUNC(Std_ReturnType, RTE_CODE) Rte_QueueReceive(P2VAR(Rte_QueueType, AUTOMATIC, RTE_VAR_NOINIT) Queue, P2VAR(void, AUTOMATIC, RTE_APPL_DATA) Data,
+                                                uint8 MaxCount, P2VAR(uint8, AUTOMATIC, RTE_APPL_DATA) Count) {
+    // Copy up to MaxCount elements in FIFO order and release them with one store
+    uint32 Head = atomic_load_explicit(&Queue->Head, memory_order_relaxed);
+    uint32 Available;
+    uint8 n;
+
+    if (Queue->Sequence == NULL_PTR) {
+        Available = atomic_load_explicit(&Queue->Tail, memory_order_acquire) - Head;
+    } else {
+        // MPSC: stop at the first cell whose sender has not published yet
+        Available = 0u;
+        while ((Available < MaxCount) && (Available < Queue->Capacity) &&
+               (atomic_load_explicit(&Queue->Sequence[(Head + Available) & (Queue->Capacity - 1u)], memory_order_acquire) == (Head + Available + 1u))) {
+            Available++;
+        }
+    }
+    if (Available > MaxCount) {
+        Available = MaxCount;
+    }
+
+    for (n = 0u; n < (uint8)Available; n++) {
+        (void)memcpy(&((uint8*)Data)[n * Queue->ElementSize],
+                     &Queue->Storage[((Head + n) & (Queue->Capacity - 1u)) * Queue->ElementSize], Queue->ElementSize);
+        if (Queue->Sequence != NULL_PTR) {
+            atomic_store_explicit(&Queue->Sequence[(Head + n) & (Queue->Capacity - 1u)], Head + n + Queue->Capacity, memory_order_release);
+        }
+    }
+    atomic_store_explicit(&Queue->Head, Head + Available, memory_order_release);
+    *Count = (uint8)Available;
+
+    if (atomic_load_explicit(&Queue->Overflow, memory_order_relaxed) &&
+        atomic_exchange_explicit(&Queue->Overflow, false, memory_order_relaxed)) {
+        return RTE_E_LOST_DATA;
+    }
+    return (Available == 0u) ? RTE_E_NO_DATA : RTE_E_OK;
+}
+
+// File: Rte_Data.c (Auto-generated)
+/* Implicit communication (RTE_IMPLICIT_COMMUNICATION): every task gets one
+ * snapshot of the data elements its runnables access. The task copies it in
+ * from the shared buffers once per start and copies the elements it writes
+ * back once at the end, so runnables see stable values and each access is a
+ * plain load or store. */
+VAR(atomic_uint_least64_t, RTE_VAR_NOINIT) Rte_Buf_DoorSwitch_DoorSwitch;
+
+// DoorEvent: SensorControl (single sender) -> DoorLogger, OsQueueLength 16
+static VAR(boolean, RTE_VAR_NOINIT) Rte_QueueStorage_DoorEvent_DoorEvent[16];
+VAR(Rte_QueueType, RTE_VAR_NOINIT) Rte_Queue_DoorEvent_DoorEvent = {
+    .Capacity = 16u, .ElementSize = sizeof(boolean), .Storage = (uint8*)Rte_QueueStorage_DoorEvent_DoorEvent, .Sequence = NULL_PTR
+};
+
+#if (RTE_IMPLICIT_COMMUNICATION == STD_ON)
+typedef struct {
+    boolean DoorSwitch;             // Written by SensorControl_10msRunnable, read by DoorControl_MainRunnable
+} Rte_Implicit_Task_Rte_10msType;
+
+VAR(Rte_Implicit_Task_Rte_10msType, RTE_VAR_NOINIT) Rte_Implicit_Task_Rte_10ms;
+
+FUNC(void, RTE_CODE) Rte_CopyIn_Task_Rte_10ms(void) {
+    Rte_Implicit_Task_Rte_10ms.DoorSwitch = (boolean)atomic_load_explicit(&Rte_Buf_DoorSwitch_DoorSwitch, memory_order_acquire);
+}
+
+FUNC(void, RTE_CODE) Rte_CopyOut_Task_Rte_10ms(void) {
+    atomic_store_explicit(&Rte_Buf_DoorSwitch_DoorSwitch, (uint64)Rte_Implicit_Task_Rte_10ms.DoorSwitch, memory_order_release);
 }
+#endif
 
 /* RTE CORE LAYER */
 // File: Rte_Core.c (Auto-generated)
 FUNC(Std_ReturnType, RTE_CODE) Rte_Com_SendSignal(Com_SignalIdType SignalId, P2CONST(void, AUTOMATIC, RTE_APPL_DATA) data) {
     // Step 9: RTE Core - Scheduling and task management
+    // Used by port APIs whose calling context could not be proven at generation time
     Rte_CheckTaskContext();  // Verify calling context
     
     // Step 10: Route to Service Layer
     return Com_SendSignal(SignalId, data);
 }
 
+FUNC(Std_ReturnType, RTE_CODE) Rte_Com_SendSignalBatch(P2CONST(Com_SignalBatchEntryType, AUTOMATIC, RTE_APPL_DATA) Entries, uint16 NumEntries) {
+    // Batched variant: one context check and one PduR call per affected I-PDU
+    Rte_CheckTaskContext();
+    
+    return Com_SendSignalBatch(Entries, NumEntries);
+}
+
 /* RTE SCHEDULING LAYER */
 // File: Rte_Schedule.c (Auto-generated)
-FUNC(void, RTE_CODE) Rte_ActivateTask_DoorControl(void) {
-    // Step 11: RTE Scheduler activates application runnables
-    ActivateTask(Task_DoorControl_10ms);
+/* Time-triggered runnables of the 10 ms cluster. Schedule table
+ * Rte_ScheduleTable_10ms (duration 10 ticks of the 1 ms counter) sets one
+ * event of Task_Rte_10ms per expiry point, and the task runs the runnables
+ * mapped to that phase, so the cluster's load is spread over the period
+ * instead of all runnables starting on the same tick. */
+typedef struct {
+    EventMaskType PhaseEvent;       // Set by the expiry point at the phase offset
+    P2FUNC(void, RTE_APPL_CODE, Runnable)(void);
+} Rte_PhaseRunnableType;
+
+static CONST(Rte_PhaseRunnableType, RTE_CONST) Rte_Phase10ms[] = {
+    { Rte_Ev_10ms_Phase0, SensorControl_10msRunnable },  // Offset 0: sample the door switch
+    { Rte_Ev_10ms_Phase5, DoorControl_MainRunnable },    // Offset 5: consume the fresh sample
+    { Rte_Ev_10ms_Phase8, DoorLogger_10msRunnable },     // Offset 8: drain the door event queue
+};
+
+#define RTE_NUM_OF_PHASE_10MS_RUNNABLES    (sizeof(Rte_Phase10ms) / sizeof(Rte_Phase10ms[0]))
+
+FUNC(void, RTE_CODE) Rte_Start(void) {
+    // Step 11: RTE Scheduler starts the time-triggered runnable dispatch
+    Rte_QueueInit(&Rte_Queue_DoorEvent_DoorEvent);
+    (void)ActivateTask(Task_Rte_10ms);
+    (void)StartScheduleTableRel(Rte_ScheduleTable_10ms, 1u);
+}
+
+TASK(Task_Rte_10ms) {
+    // Extended task: one wake-up per phase, runnables in configured order
+    EventMaskType Events;
+    uint8 i;
+
+    for (;;) {
+        (void)WaitEvent(Rte_Ev_10ms_AllPhases);
+        (void)GetEvent(Task_Rte_10ms, &Events);
+        Events &= Rte_Ev_10ms_AllPhases;
+        (void)ClearEvent(Events);
+
+#if (RTE_IMPLICIT_COMMUNICATION == STD_ON)
+        Rte_CopyIn_Task_Rte_10ms();
+#endif
+        for (i = 0u; i < RTE_NUM_OF_PHASE_10MS_RUNNABLES; i++) {
+            if ((Events & Rte_Phase10ms[i].PhaseEvent) != 0u) {
+                Rte_Phase10ms[i].Runnable();
+            }
+        }
+#if (RTE_IMPLICIT_COMMUNICATION == STD_ON)
+        Rte_CopyOut_Task_Rte_10ms();
+#endif
+    }
 }
 
 /* =========================================================================
@@ -143,328 +469,8966 @@ FUNC(void, RTE_CODE) Rte_ActivateTask_DoorControl(void) {
 
 /* COMMUNICATION STACK - COM */
 // File: Com.c
-FUNC(Std_ReturnType, COM_CODE) Com_SendSignal(Com_SignalIdType SignalId, P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr) {
-    // Step 12: COM Signal Management
-    P2CONST(Com_TxSignalType, AUTOMATIC, COM_CONST) SignalPtr = &Com_ConfigPtr->ComTxSignal[SignalId];
-    
-    // Step 13: Pack signal into I-PDU buffer
-    P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) IpduBuffer = Com_GetTxIpduBuffer(SignalPtr->ComIPduRef);
-    Com_PackSignal(SignalPtr, SignalDataPtr, IpduBuffer);
-    
-    // Step 14: Trigger transmission based on transmission mode
-    Com_SetTxIPduTransmissionMode(SignalPtr->ComIPduRef, COM_TX_MODE_TRUE);
-    
-    // Step 15: Route to PduR
-    return PduR_ComTransmit(SignalPtr->ComIPduRef, &Com_TxIPduInfo[SignalPtr->ComIPduRef]);
+
+/* Precomputed packing layout of one ComTxSignal (built once in Com_Init).
+ * Intel signals are placed through a little-endian 64-bit view of the I-PDU,
+ * Motorola signals through a big-endian view; in both views a signal is a
+ * contiguous bit field, so packing is one masked shift per 64-bit word.
+ * UINT8_N and UINT8_DYN signals are byte-aligned arrays of ComSignalLength
+ * bytes: they are staged in Com_TxSignalBytes and copied into the I-PDU as is. */
+typedef struct {
+    uint64  LoMask;         // Signal bits inside WordIdx
+    uint64  HiMask;         // Signal bits spilling into HiWordIdx (0 if none)
+    uint8   WordIdx;        // 64-bit word holding the signal LSB
+    uint8   HiWordIdx;      // Neighbour word for straddling signals
+    uint8   Shift;          // Position of the signal LSB inside WordIdx
+    uint8   FirstByte;      // Byte span touched by the signal
+    uint8   LastByte;
+    boolean BigEndian;
+    boolean ByteArray;      // UINT8_N/UINT8_DYN: copied bytewise, not part of the word views
+} Com_TxSignalPackInfoType;
+
+#define COM_MAX_IPDU_WORDS      ((COM_MAX_IPDU_LENGTH + 7u) / 8u)
+
+#ifndef COM_TX_SIGNAL_BYTES
+#define COM_TX_SIGNAL_BYTES     64u     // Generated: sum of ComSignalLength over UINT8_N/UINT8_DYN Tx signals
+#endif
+#define COM_TX_SIGNAL_BYTES_NONE    0xFFFFu
+
+// Development and runtime error reporting (AUTOSAR Com module and service IDs)
+#define COM_MODULE_ID                   50u
+#define COM_INSTANCE_ID                 0u
+#define COM_SID_INIT                    0x01u
+#define COM_SID_SENDSIGNAL              0x0Au
+#define COM_E_INIT_FAILED               0x04u
+#define COM_E_SKIPPED_TRANSMISSION      0x05u
+
+/* One (SignalId, data) pair of a Com_SendSignalBatch call */
+typedef struct {
+    Com_SignalIdType SignalId;
+    P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr;
+} Com_SignalBatchEntryType;
+
+static VAR(Com_TxSignalPackInfoType, COM_VAR_NOINIT) Com_TxSignalPackInfo[COM_NUM_OF_TX_SIGNALS];
+static VAR(uint64, COM_VAR_NOINIT) Com_TxSignalValue[COM_NUM_OF_TX_SIGNALS];
+static VAR(boolean, COM_VAR_NOINIT) Com_TxSignalDirty[COM_NUM_OF_TX_SIGNALS];
+
+// Staged values of array signals, one region of ComSignalLength bytes per signal
+static VAR(uint8, COM_VAR_NOINIT) Com_TxSignalBytes[COM_TX_SIGNAL_BYTES];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxSignalBytesStart[COM_NUM_OF_TX_SIGNALS];   // COM_TX_SIGNAL_BYTES_NONE: no region
+
+// Dirty signals per I-PDU, stored as one list region per I-PDU
+static VAR(Com_SignalIdType, COM_VAR_NOINIT) Com_TxDirtyList[COM_NUM_OF_TX_SIGNALS];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxDirtyListStart[COM_NUM_OF_TX_IPDUS];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxDirtyCount[COM_NUM_OF_TX_IPDUS];
+
+/* Deferred transmission: triggered I-PDUs are coalesced into one pending entry
+ * and sent from Com_MainFunctionTx. Cyclic I-PDUs live on a timing wheel of
+ * COM_TX_WHEEL_SLOTS main-function ticks; longer periods use a rounds count.
+ * Signals are staged and I-PDUs triggered from any task, so the staged-signal
+ * lists, the pack pass that consumes them and the pending list are updated
+ * inside COM_EXCLUSIVE_AREA_0. PduR_ComTransmit is called outside it. */
+#define COM_TX_WHEEL_SLOTS      64u     // Power of two
+#define COM_TX_WHEEL_NIL        0xFFFFu
+
+static VAR(uint16, COM_VAR_NOINIT) Com_TxWheelHead[COM_TX_WHEEL_SLOTS];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxWheelNext[COM_NUM_OF_TX_IPDUS];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxWheelRounds[COM_NUM_OF_TX_IPDUS];
+static VAR(uint32, COM_VAR_NOINIT) Com_TxWheelTick;
+
+static VAR(boolean, COM_VAR_NOINIT) Com_TxPending[COM_NUM_OF_TX_IPDUS];
+static VAR(PduIdType, COM_VAR_NOINIT) Com_TxPendingList[COM_NUM_OF_TX_IPDUS];
+static VAR(uint16, COM_VAR_NOINIT) Com_TxPendingCount;
+static VAR(uint16, COM_VAR_NOINIT) Com_TxMdtCounter[COM_NUM_OF_TX_IPDUS];
+
+static FUNC(void, COM_CODE) Com_TxWheelInsert(PduIdType ComTxPduId, uint16 Delay) {
+    // Delay is in main-function ticks (>= 1); the slot is visited every COM_TX_WHEEL_SLOTS ticks
+    uint8 Slot = (uint8)((Com_TxWheelTick + Delay) & (COM_TX_WHEEL_SLOTS - 1u));
+
+    Com_TxWheelRounds[ComTxPduId] = (uint16)((Delay - 1u) / COM_TX_WHEEL_SLOTS);
+    Com_TxWheelNext[ComTxPduId] = Com_TxWheelHead[Slot];
+    Com_TxWheelHead[Slot] = ComTxPduId;
 }
 
-/* COMMUNICATION STACK - PDUR */
-// File: PduR.c
-FUNC(Std_ReturnType, PDUR_CODE) PduR_ComTransmit(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info) {
-    // Step 16: PDU Router - Message routing logic
-    P2CONST(PduR_DestPduType, AUTOMATIC, PDUR_CONST) DestPdu = &PduR_ConfigPtr->PduRDestPdu[id];
-    
-    // Step 17: Route based on destination module
-    switch(DestPdu->DestModuleAPIRef) {
-        case PDUR_CANIF:
-            return CanIf_Transmit(DestPdu->DestPduRef, info);
-        case PDUR_LINIF:
-            return LinIf_Transmit(DestPdu->DestPduRef, info);
-        default:
-            return E_NOT_OK;
+FUNC(void, COM_CODE) Com_TriggerTxIPdu(PduIdType ComTxPduId) {
+    // Coalescing: any number of triggers within one cycle yields a single frame
+    SchM_Enter_Com_COM_EXCLUSIVE_AREA_0();
+    if (Com_TxPending[ComTxPduId] == FALSE) {
+        Com_TxPending[ComTxPduId] = TRUE;
+        Com_TxPendingList[Com_TxPendingCount] = ComTxPduId;
+        Com_TxPendingCount++;
     }
+    SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
 }
 
-/* DIAGNOSTIC STACK - DEM */
-// File: Dem.c
-FUNC(void, DEM_CODE) Dem_ReportErrorStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
-    // Step 18: Diagnostic Event Manager - Error monitoring
-    Dem_EventMemoryEntryType* EventEntry = &Dem_EventMemory[EventId];
-    
-    if (EventStatus == DEM_EVENT_STATUS_FAILED) {
-        EventEntry->EventStatus = DEM_EVENT_STATUS_FAILED;
-        EventEntry->OccurrenceCounter++;
-        
-        // Trigger DCM notification if configured
-        if (Dem_EventConfig[EventId].ReportToDcm == TRUE) {
-            Dcm_DemTriggerOnDTCStatus(EventId, DEM_DTC_STATUS_MASK_TESTFAILED);
-        }
+static FUNC(void, COM_CODE) Com_BuildTxSignalPackInfo(Com_SignalIdType SignalId) {
+    P2CONST(Com_TxSignalType, AUTOMATIC, COM_CONST) SignalPtr = &Com_ConfigPtr->ComTxSignal[SignalId];
+    P2VAR(Com_TxSignalPackInfoType, AUTOMATIC, COM_VAR_NOINIT) Info = &Com_TxSignalPackInfo[SignalId];
+    uint16 BitPos = SignalPtr->ComBitPosition;      // LSB position (sawtooth numbering)
+    uint8 BitSize = SignalPtr->ComBitSize;          // 1..64
+    uint8 LsbByte = (uint8)(BitPos / 8u);
+    uint64 ValueMask = (BitSize >= 64u) ? ~(uint64)0u : (((uint64)1u << BitSize) - 1u);
+    uint8 SpanBits;
+
+    Info->ByteArray = ((SignalPtr->ComSignalType == COM_UINT8_N) || (SignalPtr->ComSignalType == COM_UINT8_DYN)) ? TRUE : FALSE;
+    if (Info->ByteArray == TRUE) {
+        // Byte order does not apply to arrays; no masks, only the byte span
+        Info->BigEndian = FALSE;
+        Info->FirstByte = LsbByte;
+        Info->LastByte = (uint8)(LsbByte + SignalPtr->ComSignalLength - 1u);
+        Info->LoMask = 0u;
+        Info->HiMask = 0u;
+        return;
     }
-}
 
-/* DIAGNOSTIC STACK - DCM */
-// File: Dcm.c
-FUNC(void, DCM_CODE) Dcm_DemTriggerOnDTCStatus(uint32 DTC, uint8 DTCStatus) {
-    // Step 19: Diagnostic Communication Manager
-    // Handle diagnostic trouble codes for door system
-    Dcm_DTCStatusType* DTCEntry = &Dcm_DTCStatus[DTC];
-    DTCEntry->Status |= DTCStatus;
-    DTCEntry->Timestamp = Dcm_GetCurrentTimestamp();
-}
+    Info->BigEndian = (SignalPtr->ComSignalEndianness == COM_BIG_ENDIAN) ? TRUE : FALSE;
+    Info->WordIdx = (uint8)(LsbByte / 8u);
 
-/* MEMORY STACK - NVM */
-// File: NvM.c
-FUNC(Std_ReturnType, NVM_CODE) NvM_WriteBlock(NvM_BlockIdType BlockId, P2CONST(void, AUTOMATIC, NVM_APPL_DATA) NvM_SrcPtr) {
-    // Step 20: Non-Volatile Memory Manager
-    // Store door configuration parameters
-    P2CONST(NvM_BlockDescriptorType, AUTOMATIC, NVM_CONST) BlockDesc = &NvM_BlockDescriptor[BlockId];
-    
-    return MemIf_Write(BlockDesc->DeviceId, BlockDesc->NvBlockBaseNumber, NvM_SrcPtr);
+    if (Info->BigEndian == TRUE) {
+        // Motorola: LSB byte is the last byte, the signal grows towards lower byte indices
+        Info->Shift = (uint8)(((7u - (LsbByte % 8u)) * 8u) + (BitPos % 8u));
+        Info->HiWordIdx = (uint8)(Info->WordIdx - 1u);
+        Info->LastByte = LsbByte;
+        Info->FirstByte = (uint8)(LsbByte - (((BitPos % 8u) + BitSize - 1u) / 8u));
+    } else {
+        // Intel: LSB byte is the first byte, the signal grows towards higher byte indices
+        Info->Shift = (uint8)(BitPos % 64u);
+        Info->HiWordIdx = (uint8)(Info->WordIdx + 1u);
+        Info->FirstByte = LsbByte;
+        Info->LastByte = (uint8)(LsbByte + (((BitPos % 8u) + BitSize - 1u) / 8u));
+    }
+
+    Info->LoMask = ValueMask << Info->Shift;
+    SpanBits = (uint8)(Info->Shift + BitSize);
+    Info->HiMask = (SpanBits > 64u) ? (ValueMask >> (64u - Info->Shift)) : 0u;
 }
 
-/* MODE MANAGEMENT - BSWM */
-// File: BswM.c
-FUNC(void, BSWM_CODE) BswM_RequestMode(BswM_UserType requesting_user, BswM_ModeType requested_mode) {
-    // Step 21: Basic Software Mode Manager
-    // Handle mode transitions (e.g., sleep/wake based on door status)
-    BswM_CurrentMode[requesting_user] = requested_mode;
-    
-    if (requested_mode == BSWM_MODE_SLEEP) {
-        ComM_RequestComMode(COMM_USER_DOOR_SYSTEM, COMM_NO_COMMUNICATION);
+FUNC(void, COM_CODE) Com_Init(P2CONST(Com_ConfigType, AUTOMATIC, COM_CONST) config) {
+    // Resolve signal layouts once so the transmit path is pure table lookups.
+    // I-PDU buffers come from the PduBuf pools: PduBuf_Init must run before Com_Init.
+    Com_SignalIdType SignalId;
+    PduIdType IpduId;
+    uint16 Start = 0u;
+    uint16 ByteStart = 0u;
+    uint8 Slot;
+
+    Com_ConfigPtr = config;
+
+    for (IpduId = 0u; IpduId < COM_NUM_OF_TX_IPDUS; IpduId++) {
+        Com_TxDirtyListStart[IpduId] = Start;
+        Com_TxDirtyCount[IpduId] = 0u;
+        Start += Com_ConfigPtr->ComTxIPdu[IpduId].ComNumOfSignals;
+
+        // Com holds one reference on each I-PDU buffer for its whole lifetime
+        Com_TxIPduInfo[IpduId].SduLength = Com_ConfigPtr->ComTxIPdu[IpduId].ComIPduLength;
+        Com_TxIPduInfo[IpduId].SduDataPtr = PduBuf_Alloc(Com_TxIPduInfo[IpduId].SduLength);
+        if (Com_TxIPduInfo[IpduId].SduDataPtr != NULL_PTR) {
+            (void)memset(Com_TxIPduInfo[IpduId].SduDataPtr, (int)Com_ConfigPtr->ComTxIPdu[IpduId].ComTxIPduUnusedAreasDefault, Com_TxIPduInfo[IpduId].SduLength);
+        } else {
+            // Pool too small for the configuration; the first successful pack allocates it
+            (void)Det_ReportError(COM_MODULE_ID, COM_INSTANCE_ID, COM_SID_INIT, COM_E_INIT_FAILED);
+        }
     }
-}
 
-/* COMMUNICATION MANAGEMENT - COMM */
-// File: ComM.c
-FUNC(Std_ReturnType, COMM_CODE) ComM_RequestComMode(ComM_UserHandleType User, ComM_ModeType ComMode) {
-    // Step 22: Communication Manager
-    // Manage CAN network state
-    ComM_UserModeType[User] = ComMode;
-    
-    if (ComMode == COMM_FULL_COMMUNICATION) {
-        CanSM_RequestComMode(CANSM_NETWORK_HANDLE_CAN0, COMM_FULL_COMMUNICATION);
+    for (SignalId = 0u; SignalId < COM_NUM_OF_TX_SIGNALS; SignalId++) {
+        Com_BuildTxSignalPackInfo(SignalId);
+        Com_TxSignalValue[SignalId] = 0u;
+        Com_TxSignalDirty[SignalId] = FALSE;
+        Com_TxSignalBytesStart[SignalId] = COM_TX_SIGNAL_BYTES_NONE;
+        if (Com_TxSignalPackInfo[SignalId].ByteArray == TRUE) {
+            uint16 Length = Com_ConfigPtr->ComTxSignal[SignalId].ComSignalLength;
+
+            if ((ByteStart + Length) <= COM_TX_SIGNAL_BYTES) {
+                Com_TxSignalBytesStart[SignalId] = ByteStart;
+                ByteStart += Length;
+            } else {
+                // COM_TX_SIGNAL_BYTES too small for the configuration; the signal is never sent
+                (void)Det_ReportError(COM_MODULE_ID, COM_INSTANCE_ID, COM_SID_INIT, COM_E_INIT_FAILED);
+            }
+        }
     }
-}
 
-/* ECU STATE MANAGEMENT - ECUM */
-// File: EcuM.c
-FUNC(void, ECUM_CODE) EcuM_SetWakeupEvent(EcuM_WakeupSourceType sources) {
-    // Step 23: ECU State Manager
-    // Handle door-triggered wakeup events
-    EcuM_WakeupSourceType current_sources = EcuM_GetPendingWakeupEvents();
-    EcuM_SetPendingWakeupEvents(current_sources | sources);
-}
+    // Arm cyclic I-PDUs on the Tx timing wheel at their configured offset
+    Com_TxWheelTick = 0u;
+    Com_TxPendingCount = 0u;
+    for (Slot = 0u; Slot < COM_TX_WHEEL_SLOTS; Slot++) {
+        Com_TxWheelHead[Slot] = COM_TX_WHEEL_NIL;
+    }
+    for (IpduId = 0u; IpduId < COM_NUM_OF_TX_IPDUS; IpduId++) {
+        P2CONST(Com_TxIPduType, AUTOMATIC, COM_CONST) IpduCfg = &Com_ConfigPtr->ComTxIPdu[IpduId];
 
-/* OPERATING SYSTEM - OS */
-// File: Os.c
-FUNC(StatusType, OS_CODE) ActivateTask(TaskType TaskID) {
-    // Step 24: Operating System
-    // Schedule door control task
-    if (Os_TaskState[TaskID] == SUSPENDED) {
-        Os_TaskState[TaskID] = READY;
-        Os_InsertIntoReadyQueue(TaskID);
-        return E_OK;
+        Com_TxPending[IpduId] = FALSE;
+        Com_TxMdtCounter[IpduId] = 0u;
+        if (IpduCfg->ComTxModeTimePeriod > 0u) {
+            Com_TxWheelInsert(IpduId, (IpduCfg->ComTxModeTimeOffset > 0u) ? IpduCfg->ComTxModeTimeOffset : 1u);
+        }
     }
-    return E_OS_LIMIT;
 }
 
-/* =========================================================================
- * ECU ABSTRACTION LAYER (ECUAL) - ALL INTERFACE STACKS
- * ========================================================================= */
+static FUNC(uint64, COM_CODE) Com_ReadTxSignalValue(uint8 SignalType, P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr) {
+    // Widen the application value; bits above ComBitSize are dropped by the masks
+    uint32 Bits32;
+    uint64 Bits64;
 
-/* CAN INTERFACE STACK - CANIF */
-// File: CanIf.c
-FUNC(Std_ReturnType, CANIF_CODE) CanIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, CANIF_APPL_CONST) PduInfoPtr) {
-    // Step 25: CAN Interface - Message preparation
-    P2CONST(CanIf_TxPduConfigType, AUTOMATIC, CANIF_CONST) TxPduConfig = &CanIf_ConfigPtr->CanIfTxPduConfig[TxPduId];
-    
-    // Step 26: Create hardware-independent CAN PDU
-    Can_PduType CanPdu;
-    CanPdu.id = TxPduConfig->CanIfTxPduCanId;        // From configuration
-    CanPdu.length = PduInfoPtr->SduLength;
-    CanPdu.sdu = PduInfoPtr->SduDataPtr;
-    CanPdu.swPduHandle = TxPduId;
-    
-    // Step 27: Call MCAL CAN driver
-    return Can_Write(TxPduConfig->CanIfTxPduCanHwObjectRef, &CanPdu);
+    switch (SignalType) {
+        case COM_BOOLEAN:
+            return (*(const boolean*)SignalDataPtr == TRUE) ? 1u : 0u;
+        case COM_UINT8:
+        case COM_SINT8:
+            return *(const uint8*)SignalDataPtr;
+        case COM_UINT16:
+        case COM_SINT16:
+            return *(const uint16*)SignalDataPtr;
+        case COM_UINT32:
+        case COM_SINT32:
+            return *(const uint32*)SignalDataPtr;
+        case COM_UINT64:
+        case COM_SINT64:
+            return *(const uint64*)SignalDataPtr;
+        case COM_FLOAT32:
+            // IEEE 754 bit pattern; memcpy avoids reading a float through an integer pointer
+            (void)memcpy(&Bits32, SignalDataPtr, sizeof(Bits32));
+            return Bits32;
+        case COM_FLOAT64:
+            (void)memcpy(&Bits64, SignalDataPtr, sizeof(Bits64));
+            return Bits64;
+        default:
+            // UINT8_N/UINT8_DYN are staged bytewise by Com_StageTxSignal and never get here
+            return 0u;
+    }
 }
 
-/* LIN INTERFACE STACK - LINIF */
-// File: LinIf.c
-FUNC(Std_ReturnType, LINIF_CODE) LinIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, LINIF_APPL_CONST) PduInfoPtr) {
-    // Step 28: LIN Interface (if LIN communication used)
-    P2CONST(LinIf_TxPduConfigType, AUTOMATIC, LINIF_CONST) TxPduConfig = &LinIf_TxPduConfig[TxPduId];
-    return Lin_SendFrame(TxPduConfig->LinChannelRef, PduInfoPtr);
+static FUNC(boolean, COM_CODE) Com_StageTxSignalLocked(Com_SignalIdType SignalId, P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr) {
+    // Caller holds COM_EXCLUSIVE_AREA_0; TRUE if this is the first staged signal of its I-PDU
+    P2CONST(Com_TxSignalType, AUTOMATIC, COM_CONST) SignalPtr = &Com_ConfigPtr->ComTxSignal[SignalId];
+    PduIdType IpduId = SignalPtr->ComIPduRef;
+    boolean First = (Com_TxDirtyCount[IpduId] == 0u) ? TRUE : FALSE;
+
+    if (Com_TxSignalPackInfo[SignalId].ByteArray == TRUE) {
+        if (Com_TxSignalBytesStart[SignalId] == COM_TX_SIGNAL_BYTES_NONE) {
+            return FALSE;
+        }
+        // Com_SendSignal carries no length: a UINT8_DYN signal is sent at its configured maximum
+        (void)memcpy(&Com_TxSignalBytes[Com_TxSignalBytesStart[SignalId]], SignalDataPtr, SignalPtr->ComSignalLength);
+    } else {
+        Com_TxSignalValue[SignalId] = Com_ReadTxSignalValue(SignalPtr->ComSignalType, SignalDataPtr);
+    }
+
+    if (Com_TxSignalDirty[SignalId] == FALSE) {
+        Com_TxSignalDirty[SignalId] = TRUE;
+        Com_TxDirtyList[Com_TxDirtyListStart[IpduId] + Com_TxDirtyCount[IpduId]] = SignalId;
+        Com_TxDirtyCount[IpduId]++;
+    }
+    return First;
 }
 
-/* FLEXRAY INTERFACE STACK - FRIF */
-// File: FrIf.c
-FUNC(Std_ReturnType, FRIF_CODE) FrIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, FRIF_APPL_CONST) PduInfoPtr) {
-    // Step 29: FlexRay Interface (if FlexRay used)
-    P2CONST(FrIf_TxPduConfigType, AUTOMATIC, FRIF_CONST) TxPduConfig = &FrIf_TxPduConfig[TxPduId];
-    return Fr_TransmitTxLPdu(TxPduConfig->FrCtrlRef, TxPduConfig->FrLPduRef, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+FUNC(PduIdType, COM_CODE) Com_StageTxSignal(Com_SignalIdType SignalId, P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr) {
+    // Latch the new value and queue the signal for the next pack pass of its I-PDU
+    SchM_Enter_Com_COM_EXCLUSIVE_AREA_0();
+    (void)Com_StageTxSignalLocked(SignalId, SignalDataPtr);
+    SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+    return Com_ConfigPtr->ComTxSignal[SignalId].ComIPduRef;
 }
 
-/* ETHERNET INTERFACE STACK - ETHIF */
-// File: EthIf.c
-FUNC(Std_ReturnType, ETHIF_CODE) EthIf_Transmit(uint8 CtrlIdx, PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, ETHIF_APPL_DATA) PduInfoPtr) {
-    // Step 30: Ethernet Interface (if Ethernet used)
-    return Eth_Transmit(CtrlIdx, TxPduId, PduInfoPtr);
+FUNC_P2VAR(uint8, COM_VAR_NOINIT, COM_CODE) Com_GetTxIpduBuffer(PduIdType ComTxPduId) {
+    // I-PDU buffers are pool-owned and handed down the stack by reference
+    return Com_TxIPduInfo[ComTxPduId].SduDataPtr;
 }
 
-/* MEMORY INTERFACE STACK - MEMIF */
-// File: MemIf.c
-FUNC(Std_ReturnType, MEMIF_CODE) MemIf_Write(uint8 DeviceIndex, uint16 BlockNumber, P2CONST(uint8, AUTOMATIC, MEMIF_APPL_DATA) DataBufferPtr) {
-    // Step 31: Memory Interface abstraction
-    switch(MemIf_ConfigPtr->MemIfDeviceConfig[DeviceIndex].MemIfDeviceType) {
-        case MEMIF_FEE_DEVICE:
-            return Fee_Write(BlockNumber, DataBufferPtr);
-        case MEMIF_EA_DEVICE:
-            return Ea_Write(BlockNumber, DataBufferPtr);
-        default:
-            return E_NOT_OK;
+static FUNC(Std_ReturnType, COM_CODE) Com_PrepareTxIPduBuffer(PduIdType ComTxPduId) {
+    // Copy-on-write: never modify a payload that a lower layer is still transmitting
+    P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) OldBuffer = Com_TxIPduInfo[ComTxPduId].SduDataPtr;
+    P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) NewBuffer;
+
+    if ((OldBuffer != NULL_PTR) && (PduBuf_IsShared(OldBuffer) == FALSE)) {
+        return E_OK;
     }
+
+    NewBuffer = PduBuf_Alloc(Com_TxIPduInfo[ComTxPduId].SduLength);
+    if (NewBuffer == NULL_PTR) {
+        // Pool exhausted: the staged values stay dirty and are packed on a later attempt
+        (void)Det_ReportRuntimeError(COM_MODULE_ID, COM_INSTANCE_ID, COM_SID_SENDSIGNAL, COM_E_SKIPPED_TRANSMISSION);
+        return E_NOT_OK;
+    }
+    if (OldBuffer != NULL_PTR) {
+        (void)memcpy(NewBuffer, OldBuffer, Com_TxIPduInfo[ComTxPduId].SduLength);
+        PduBuf_Release(OldBuffer);
+    } else {
+        (void)memset(NewBuffer, (int)Com_ConfigPtr->ComTxIPdu[ComTxPduId].ComTxIPduUnusedAreasDefault, Com_TxIPduInfo[ComTxPduId].SduLength);
+    }
+    Com_TxIPduInfo[ComTxPduId].SduDataPtr = NewBuffer;
+    return E_OK;
 }
 
-/* WATCHDOG INTERFACE STACK - WDGIF */
-// File: WdgIf.c
-FUNC(Std_ReturnType, WDGIF_CODE) WdgIf_SetTriggerCondition(uint8 DeviceIndex, uint16 Timeout) {
-    // Step 32: Watchdog Interface
-    P2CONST(WdgIf_DeviceConfigType, AUTOMATIC, WDGIF_CONST) DeviceConfig = &WdgIf_DeviceConfig[DeviceIndex];
-    
-    switch(DeviceConfig->WdgIfDevice) {
-        case WDGIF_INTERNAL_WDG:
-            return Wdg_SetTriggerCondition(Timeout);
-        case WDGIF_EXTERNAL_WDG:
-            return WdgExt_SetTriggerCondition(DeviceConfig->WdgIfDeviceIndex, Timeout);
-        default:
-            return E_NOT_OK;
+static FUNC(uint64, COM_CODE) Com_LoadWord(P2CONST(uint8, AUTOMATIC, COM_VAR_NOINIT) Buffer, uint16 Length, uint8 WordIdx, boolean BigEndian) {
+    uint64 Word = 0u;
+    uint16 Base = (uint16)WordIdx * 8u;
+    uint8 i;
+
+    for (i = 0u; (i < 8u) && ((Base + i) < Length); i++) {
+        uint8 Pos = (BigEndian == TRUE) ? (uint8)((7u - i) * 8u) : (uint8)(i * 8u);
+        Word |= (uint64)Buffer[Base + i] << Pos;
     }
+    return Word;
 }
 
-/* =========================================================================
- * COMPLEX DEVICE DRIVERS (CDD) - CUSTOM DRIVER STACKS
- * ========================================================================= */
+static FUNC(void, COM_CODE) Com_StoreWord(P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) Buffer, uint16 Length, uint8 WordIdx, boolean BigEndian, uint64 Word) {
+    uint16 Base = (uint16)WordIdx * 8u;
+    uint8 i;
 
-/* HIGH-SPEED SENSOR CDD */
-// File: Cdd_HighSpeedSensor.c
-FUNC(void, CDD_CODE) Cdd_HighSpeedSensor_MainFunction(void) {
-    // Step 33: Complex Device Driver for time-critical sensors
-    // Direct MCAL access for microsecond-precision timing
+    for (i = 0u; (i < 8u) && ((Base + i) < Length); i++) {
+        uint8 Pos = (BigEndian == TRUE) ? (uint8)((7u - i) * 8u) : (uint8)(i * 8u);
+        Buffer[Base + i] = (uint8)(Word >> Pos);
+    }
+}
+
+static FUNC(void, COM_CODE) Com_PackTxIPduView(PduIdType ComTxPduId, boolean BigEndian) {
+    // One pass over the dirty signals of one byte order: load words, merge, store back
+    P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) IpduBuffer = Com_GetTxIpduBuffer(ComTxPduId);
+    uint16 Length = Com_TxIPduInfo[ComTxPduId].SduLength;
+    P2CONST(Com_SignalIdType, AUTOMATIC, COM_VAR_NOINIT) DirtyList = &Com_TxDirtyList[Com_TxDirtyListStart[ComTxPduId]];
+    uint64 Words[COM_MAX_IPDU_WORDS];
+    uint8 FirstWord = 0xFFu;
+    uint8 LastWord = 0u;
+    uint8 w;
+    uint16 i;
+
+    for (i = 0u; i < Com_TxDirtyCount[ComTxPduId]; i++) {
+        P2CONST(Com_TxSignalPackInfoType, AUTOMATIC, COM_VAR_NOINIT) Info = &Com_TxSignalPackInfo[DirtyList[i]];
+        if ((Info->ByteArray == FALSE) && (Info->BigEndian == BigEndian)) {
+            uint8 Lo = (uint8)(Info->FirstByte / 8u);
+            uint8 Hi = (uint8)(Info->LastByte / 8u);
+            FirstWord = (Lo < FirstWord) ? Lo : FirstWord;
+            LastWord = (Hi > LastWord) ? Hi : LastWord;
+        }
+    }
+
+    if (FirstWord == 0xFFu) {
+        return;
+    }
+
+    for (w = FirstWord; w <= LastWord; w++) {
+        Words[w] = Com_LoadWord(IpduBuffer, Length, w, BigEndian);
+    }
+
+    for (i = 0u; i < Com_TxDirtyCount[ComTxPduId]; i++) {
+        P2CONST(Com_TxSignalPackInfoType, AUTOMATIC, COM_VAR_NOINIT) Info = &Com_TxSignalPackInfo[DirtyList[i]];
+        uint64 Value = Com_TxSignalValue[DirtyList[i]];
+        if ((Info->ByteArray == TRUE) || (Info->BigEndian != BigEndian)) {
+            continue;
+        }
+        Words[Info->WordIdx] = (Words[Info->WordIdx] & ~Info->LoMask) | ((Value << Info->Shift) & Info->LoMask);
+        if (Info->HiMask != 0u) {
+            Words[Info->HiWordIdx] = (Words[Info->HiWordIdx] & ~Info->HiMask) | ((Value >> (64u - Info->Shift)) & Info->HiMask);
+        }
+    }
+
+    for (w = FirstWord; w <= LastWord; w++) {
+        Com_StoreWord(IpduBuffer, Length, w, BigEndian, Words[w]);
+    }
+}
+
+static FUNC(void, COM_CODE) Com_PackTxIPduBytes(PduIdType ComTxPduId) {
+    // Array signals: copy the staged bytes over their span of the I-PDU
+    P2VAR(uint8, AUTOMATIC, COM_VAR_NOINIT) IpduBuffer = Com_GetTxIpduBuffer(ComTxPduId);
+    uint16 Length = Com_TxIPduInfo[ComTxPduId].SduLength;
+    P2CONST(Com_SignalIdType, AUTOMATIC, COM_VAR_NOINIT) DirtyList = &Com_TxDirtyList[Com_TxDirtyListStart[ComTxPduId]];
+    uint16 i;
+
+    for (i = 0u; i < Com_TxDirtyCount[ComTxPduId]; i++) {
+        P2CONST(Com_TxSignalPackInfoType, AUTOMATIC, COM_VAR_NOINIT) Info = &Com_TxSignalPackInfo[DirtyList[i]];
+        if ((Info->ByteArray == TRUE) && (Info->LastByte < Length)) {
+            (void)memcpy(&IpduBuffer[Info->FirstByte], &Com_TxSignalBytes[Com_TxSignalBytesStart[DirtyList[i]]],
+                         (size_t)Info->LastByte - Info->FirstByte + 1u);
+        }
+    }
+}
+
+FUNC(Std_ReturnType, COM_CODE) Com_PackTxIPdu(PduIdType ComTxPduId) {
+    // Pack every dirty signal of the I-PDU (replaces per-signal Com_PackSignal calls)
+    P2CONST(Com_SignalIdType, AUTOMATIC, COM_VAR_NOINIT) DirtyList = &Com_TxDirtyList[Com_TxDirtyListStart[ComTxPduId]];
+    uint16 i;
+
+    // Held from the pack to the list reset, so a value staged meanwhile is not dropped as already packed
+    SchM_Enter_Com_COM_EXCLUSIVE_AREA_0();
+    if (Com_TxDirtyCount[ComTxPduId] == 0u) {
+        SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+        return E_OK;
+    }
+
+    if (Com_PrepareTxIPduBuffer(ComTxPduId) != E_OK) {
+        SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+        return E_NOT_OK;    // No private buffer: delay the update rather than write under the lower layer
+    }
+    Com_PackTxIPduView(ComTxPduId, FALSE);
+    Com_PackTxIPduView(ComTxPduId, TRUE);
+    Com_PackTxIPduBytes(ComTxPduId);
+
+    for (i = 0u; i < Com_TxDirtyCount[ComTxPduId]; i++) {
+        Com_TxSignalDirty[DirtyList[i]] = FALSE;
+    }
+    Com_TxDirtyCount[ComTxPduId] = 0u;
+    SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+    return E_OK;
+}
+
+FUNC(Std_ReturnType, COM_CODE) Com_SendSignal(Com_SignalIdType SignalId, P2CONST(void, AUTOMATIC, COM_APPL_DATA) SignalDataPtr) {
+    // Step 12: COM Signal Management
+    P2CONST(Com_TxSignalType, AUTOMATIC, COM_CONST) SignalPtr = &Com_ConfigPtr->ComTxSignal[SignalId];
     
-    Gpt_ValueType timestamp = Gpt_GetTimeElapsed(GPT_CHANNEL_TIMESTAMP);
-    Adc_ValueType sensor_value = 0;
+    // Step 13: Pack signal into I-PDU buffer (precomputed layout, 64-bit word merge);
+    // if no buffer is free the value stays staged and Com_MainFunctionTx packs it before sending
+    (void)Com_StageTxSignal(SignalId, SignalDataPtr);
+    (void)Com_PackTxIPdu(SignalPtr->ComIPduRef);
     
-    if (Adc_ReadGroup(ADC_GROUP_HIGH_SPEED_SENSORS, &sensor_value) == E_OK) {
-        // Process high-speed sensor data with precise timing
-        Cdd_ProcessSensorData(sensor_value, timestamp);
+    // Step 14: Trigger transmission based on transmission mode
+    Com_SetTxIPduTransmissionMode(SignalPtr->ComIPduRef, COM_TX_MODE_TRUE);
+    
+    // Step 15: Route to PduR (deferred to Com_MainFunctionTx, coalesced per cycle)
+    Com_TriggerTxIPdu(SignalPtr->ComIPduRef);
+    return E_OK;
+}
+
+FUNC(Std_ReturnType, COM_CODE) Com_SendSignalBatch(P2CONST(Com_SignalBatchEntryType, AUTOMATIC, COM_APPL_DATA) Entries, uint16 NumEntries) {
+    // Stage all signals first, then pack and trigger each affected I-PDU exactly once
+    PduIdType AffectedIpdu[COM_NUM_OF_TX_IPDUS];
+    uint16 NumAffected = 0u;
+    uint16 i;
+
+    SchM_Enter_Com_COM_EXCLUSIVE_AREA_0();
+    for (i = 0u; i < NumEntries; i++) {
+        // First dirty signal of an I-PDU marks it as affected by this batch
+        if (Com_StageTxSignalLocked(Entries[i].SignalId, Entries[i].SignalDataPtr) == TRUE) {
+            AffectedIpdu[NumAffected] = Com_ConfigPtr->ComTxSignal[Entries[i].SignalId].ComIPduRef;
+            NumAffected++;
+        }
     }
+    SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+
+    for (i = 0u; i < NumAffected; i++) {
+        PduIdType IpduId = AffectedIpdu[i];
+
+        (void)Com_PackTxIPdu(IpduId);
+        Com_SetTxIPduTransmissionMode(IpduId, COM_TX_MODE_TRUE);
+        Com_TriggerTxIPdu(IpduId);
+    }
+
+    return E_OK;
 }
 
-/* SAFETY MONITORING CDD */
-// File: Cdd_SafetyMonitor.c
-FUNC(void, CDD_CODE) Cdd_SafetyMonitor_CheckDoorSafety(void) {
-    // Step 34: Safety-critical monitoring
-    // Bypass upper layers for safety-critical checks
+FUNC(void, COM_CODE) Com_MainFunctionTx(void) {
+    // Cyclic Tx scheduling: advance the timing wheel and collect I-PDUs whose period elapsed
+    uint8 Slot;
+    uint16 Node;
+    uint16 Prev = COM_TX_WHEEL_NIL;
+    uint16 Due = COM_TX_WHEEL_NIL;
+    uint16 i;
+    PduIdType Work[COM_NUM_OF_TX_IPDUS];
+    uint16 NumWork;
+
+    Com_TxWheelTick++;
+    Slot = (uint8)(Com_TxWheelTick & (COM_TX_WHEEL_SLOTS - 1u));
+    Node = Com_TxWheelHead[Slot];
+
+    while (Node != COM_TX_WHEEL_NIL) {
+        uint16 Next = Com_TxWheelNext[Node];
+
+        if (Com_TxWheelRounds[Node] > 0u) {
+            Com_TxWheelRounds[Node]--;
+            Prev = Node;
+        } else {
+            // Unlink onto the local due chain; re-armed after the walk
+            if (Prev == COM_TX_WHEEL_NIL) {
+                Com_TxWheelHead[Slot] = Next;
+            } else {
+                Com_TxWheelNext[Prev] = Next;
+            }
+            Com_TxWheelNext[Node] = Due;
+            Due = Node;
+        }
+        Node = Next;
+    }
+
+    while (Due != COM_TX_WHEEL_NIL) {
+        uint16 Next = Com_TxWheelNext[Due];
+
+        Com_TriggerTxIPdu((PduIdType)Due);
+        Com_TxWheelInsert((PduIdType)Due, Com_ConfigPtr->ComTxIPdu[Due].ComTxModeTimePeriod);
+        Due = Next;
+    }
+
+    // Minimum delay time: count down the per-I-PDU inhibit timers
+    for (i = 0u; i < COM_NUM_OF_TX_IPDUS; i++) {
+        if (Com_TxMdtCounter[i] > 0u) {
+            Com_TxMdtCounter[i]--;
+        }
+    }
+
+    // Take the pending list; a trigger from now on queues the I-PDU again and is not lost
+    SchM_Enter_Com_COM_EXCLUSIVE_AREA_0();
+    NumWork = Com_TxPendingCount;
+    for (i = 0u; i < NumWork; i++) {
+        Work[i] = Com_TxPendingList[i];
+        Com_TxPending[Work[i]] = FALSE;
+    }
+    Com_TxPendingCount = 0u;
+    SchM_Exit_Com_COM_EXCLUSIVE_AREA_0();
+
+    // Send each pending I-PDU once; blocked, unpacked or rejected ones are queued again for the next cycle
+    for (i = 0u; i < NumWork; i++) {
+        PduIdType IpduId = Work[i];
+
+        if ((Com_TxMdtCounter[IpduId] == 0u) &&
+            (Com_PackTxIPdu(IpduId) == E_OK) &&
+            (Com_TxIPduInfo[IpduId].SduDataPtr != NULL_PTR) &&
+            (PduR_ComTransmit(IpduId, &Com_TxIPduInfo[IpduId]) == E_OK)) {
+            Com_TxMdtCounter[IpduId] = Com_ConfigPtr->ComTxIPdu[IpduId].ComMinimumDelayTime;
+        } else {
+            Com_TriggerTxIPdu(IpduId);
+        }
+    }
+}
+
+/* COMMUNICATION STACK - PDUR */
+// File: PduR_Types.h
+/* Routing destinations are resolved by the generator to the lower layer's
+ * transmit function, so PduR_ComTransmit needs no module switch at runtime. */
+typedef P2FUNC(Std_ReturnType, PDUR_CODE, PduR_TransmitFctPtrType)(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) PduInfoPtr);
+
+typedef struct {
+    PduR_TransmitFctPtrType TransmitFct;    // CanIf_Transmit, LinIf_Transmit, FrIf_Transmit or EthIf thunk
+    PduIdType DestPduId;                    // PDU handle of the destination module
+} PduR_RoutingDestType;
+
+typedef struct {
+    uint16 FirstDest;                       // Index into the destination table
+    uint8 NumDest;                          // 1 = unicast, >1 = fan-out (1:N)
+} PduR_RoutingPathType;
+
+// File: PduR_PBcfg.c (Auto-generated)
+// EthIf_Transmit carries the controller index, so the generator emits one thunk per controller
+static FUNC(Std_ReturnType, PDUR_CODE) PduR_EthIfTransmit_Ctrl0(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) PduInfoPtr) {
+    return EthIf_Transmit(0u, TxPduId, PduInfoPtr);
+}
+
+static CONST(PduR_RoutingDestType, PDUR_CONST) PduR_ComTxDest[] = {
+    /* ComConf_ComIPdu_DoorStatus -> CAN */
+    { &CanIf_Transmit,           CanIfConf_CanIfTxPduCfg_DoorStatus },
+    /* ComConf_ComIPdu_BodyGateway -> CAN, LIN, FlexRay, Ethernet */
+    { &CanIf_Transmit,           CanIfConf_CanIfTxPduCfg_BodyGateway },
+    { &LinIf_Transmit,           LinIfConf_LinIfTxPdu_BodyGateway },
+    { &FrIf_Transmit,            FrIfConf_FrIfTxPdu_BodyGateway },
+    { &PduR_EthIfTransmit_Ctrl0, EthIfConf_EthIfTxPdu_BodyGateway },
+};
+
+static CONST(PduR_RoutingPathType, PDUR_CONST) PduR_ComTxRoutingPath[PDUR_NUM_OF_COM_TX_PDUS] = {
+    { 0u, 1u },     /* ComConf_ComIPdu_DoorStatus */
+    { 1u, 4u },     /* ComConf_ComIPdu_BodyGateway */
+};
+
+// DoIP tester connections -> DCM: every connection maps to DCM's DoIP protocol Rx/Tx PDU pair
+static CONST(PduIdType, PDUR_CONST) PduR_DoIPDcmRxPduId = DcmConf_DcmDslProtocolRxPdu_DoIP;
+static CONST(PduIdType, PDUR_CONST) PduR_DoIPDcmTxPduId = DcmConf_DcmDslProtocolTxPdu_DoIP;
+
+// File: PduR.c
+FUNC(Std_ReturnType, PDUR_CODE) PduR_ComTransmit(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info) {
+    // Step 16: PDU Router - Message routing logic
+    P2CONST(PduR_RoutingPathType, AUTOMATIC, PDUR_CONST) Path = &PduR_ComTxRoutingPath[id];
+    P2CONST(PduR_RoutingDestType, AUTOMATIC, PDUR_CONST) Dest = &PduR_ComTxDest[Path->FirstDest];
+    Std_ReturnType Result = E_NOT_OK;
+    uint8 i;
     
-    Dio_LevelType door_sensor_primary = Dio_ReadChannel(DIO_CHANNEL_DOOR_PRIMARY);
-    Dio_LevelType door_sensor_secondary = Dio_ReadChannel(DIO_CHANNEL_DOOR_SECONDARY);
+    // Step 17: Route via the generated destination table (direct call for unicast)
+    if (Path->NumDest == 1u) {
+        return Dest->TransmitFct(Dest->DestPduId, info);
+    }
     
-    // Cross-check multiple sensors for safety
-    if (door_sensor_primary != door_sensor_secondary) {
-        // Report safety violation directly to DEM
-        Dem_ReportErrorStatus(DEM_EVENT_DOOR_SENSOR_MISMATCH, DEM_EVENT_STATUS_FAILED);
+    // Fan-out: the I-PDU counts as transmitted if at least one destination accepted it
+    for (i = 0u; i < Path->NumDest; i++) {
+        if (Dest[i].TransmitFct(Dest[i].DestPduId, info) == E_OK) {
+            Result = E_OK;
+        }
     }
+    return Result;
 }
 
-/* =========================================================================
- * MICROCONTROLLER ABSTRACTION LAYER (MCAL) - ALL DRIVER STACKS
- * ========================================================================= */
+/* DCM over DoIP. DoIP numbers its N-SDUs by tester connection slot, DCM has
+ * one Rx/Tx PDU pair for the DoIP protocol and serves one request at a time.
+ * The connection whose request DCM accepts is bound to the pair until the
+ * next accepted request; the response and the calls of other connections
+ * are routed by that binding. */
+#define PDUR_NO_CONNECTION  0xFFFFu
 
-/* CAN DRIVER STACK */
-// File: Can.c
-FUNC(Std_ReturnType, CAN_CODE) Can_Write(Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CAN_APPL_CONST) PduInfo) {
-    // Step 35: CAN MCAL Driver
-    P2CONST(Can_HwObjectConfigType, AUTOMATIC, CAN_CONST) HwObjConfig = &Can_ConfigPtr->CanHwObjectConfig[Hth];
-    uint8 Controller = HwObjConfig->CanControllerRef;
-    
-    return Can_Infineon_TC39x_Transmit(Controller, Hth, PduInfo);
+static VAR(PduIdType, PDUR_VAR) PduR_DoIPDcmConnection = PDUR_NO_CONNECTION;
+
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_DoIPStartOfReception(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                             PduLengthType TpSduLength, P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) bufferSizePtr) {
+    // BUFREQ_E_BUSY while DCM serves another request, over DoIP or any other transport
+    BufReq_ReturnType Result = Dcm_StartOfReception(PduR_DoIPDcmRxPduId, info, TpSduLength, bufferSizePtr);
+
+    if (Result == BUFREQ_OK) {
+        PduR_DoIPDcmConnection = id;
+    }
+    return Result;
 }
 
-/* DIO DRIVER STACK */
-// File: Dio.c
-FUNC(Dio_LevelType, DIO_CODE) Dio_ReadChannel(Dio_ChannelType ChannelId) {
-    // Step 36: Digital I/O MCAL Driver
-    P2CONST(Dio_ChannelConfigType, AUTOMATIC, DIO_CONST) ChannelConfig = &Dio_ConfigPtr->DioChannel[ChannelId];
-    
-    return Dio_Infineon_TC39x_ReadChannel(ChannelConfig->DioPortRef, ChannelConfig->DioBitPosition);
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_DoIPCopyRxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                       P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) bufferSizePtr) {
+    if (id != PduR_DoIPDcmConnection) {
+        return BUFREQ_E_NOT_OK;
+    }
+    return Dcm_CopyRxData(PduR_DoIPDcmRxPduId, info, bufferSizePtr);
 }
 
-/* PWM DRIVER STACK */
-// File: Pwm.c
-FUNC(void, PWM_CODE) Pwm_SetDutyCycle(Pwm_ChannelType ChannelNumber, uint16 DutyCycle) {
-    // Step 37: PWM MCAL Driver
-    P2CONST(Pwm_ChannelConfigType, AUTOMATIC, PWM_CONST) ChannelConfig = &Pwm_ConfigPtr->PwmChannel[ChannelNumber];
-    
-    Pwm_Infineon_TC39x_SetDutyCycle(ChannelConfig->PwmHwChannel, DutyCycle);
+FUNC(void, PDUR_CODE) PduR_DoIPRxIndication(PduIdType id, Std_ReturnType result) {
+    if (id == PduR_DoIPDcmConnection) {
+        Dcm_TpRxIndication(PduR_DoIPDcmRxPduId, result);
+    }
 }
 
-/* ADC DRIVER STACK */
-// File: Adc.c
-FUNC(Std_ReturnType, ADC_CODE) Adc_ReadGroup(Adc_GroupType Group, P2VAR(Adc_ValueType, AUTOMATIC, ADC_APPL_DATA) DataBufferPtr) {
-    // Step 38: ADC MCAL Driver
-    P2CONST(Adc_GroupConfigType, AUTOMATIC, ADC_CONST) GroupConfig = &Adc_ConfigPtr->AdcGroup[Group];
-    
-    return Adc_Infineon_TC39x_ReadGroup(GroupConfig->AdcGroupId, DataBufferPtr);
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_DoIPCopyTxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                       P2CONST(RetryInfoType, AUTOMATIC, PDUR_APPL_DATA) retry,
+                                                       P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) availableDataPtr) {
+    if (id != PduR_DoIPDcmConnection) {
+        return BUFREQ_E_NOT_OK;
+    }
+    return Dcm_CopyTxData(PduR_DoIPDcmTxPduId, info, retry, availableDataPtr);
 }
 
-/* GPT DRIVER STACK */
-// File: Gpt.c
-FUNC(void, GPT_CODE) Gpt_StartTimer(Gpt_ChannelType Channel, Gpt_ValueType Value) {
-    // Step 39: General Purpose Timer MCAL Driver
-    P2CONST(Gpt_ChannelConfigType, AUTOMATIC, GPT_CONST) ChannelConfig = &Gpt_ConfigPtr->GptChannel[Channel];
-    
-    Gpt_Infineon_TC39x_StartTimer(ChannelConfig->GptChannelId, Value);
+FUNC(void, PDUR_CODE) PduR_DoIPTxConfirmation(PduIdType id, Std_ReturnType result) {
+    if (id == PduR_DoIPDcmConnection) {
+        Dcm_TpTxConfirmation(PduR_DoIPDcmTxPduId, result);
+    }
 }
 
-/* SPI DRIVER STACK */
-// File: Spi.c
-FUNC(Std_ReturnType, SPI_CODE) Spi_WriteIB(Spi_ChannelType Channel, P2CONST(Spi_DataBufferType, AUTOMATIC, SPI_APPL_CONST) DataBufferPtr) {
-    // Step 40: SPI MCAL Driver
-    P2CONST(Spi_ChannelConfigType, AUTOMATIC, SPI_CONST) ChannelConfig = &Spi_ConfigPtr->SpiChannel[Channel];
-    
-    return Spi_Infineon_TC39x_WriteChannel(ChannelConfig->SpiChannelId, DataBufferPtr);
+FUNC(Std_ReturnType, PDUR_CODE) PduR_DcmTransmit(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info) {
+    // DoIP rejects the response if the bound tester has closed its connection meanwhile
+    if ((id != PduR_DoIPDcmTxPduId) || (PduR_DoIPDcmConnection == PDUR_NO_CONNECTION)) {
+        return E_NOT_OK;
+    }
+    return DoIP_TpTransmit(PduR_DoIPDcmConnection, info);
 }
 
-/* ICU DRIVER STACK */
-// File: Icu.c
-FUNC(void, ICU_CODE) Icu_EnableNotification(Icu_ChannelType Channel) {
-    // Step 41: Input Capture Unit MCAL Driver
-    P2CONST(Icu_ChannelConfigType, AUTOMATIC, ICU_CONST) ChannelConfig = &Icu_ConfigPtr->IcuChannel[Channel];
-    
-    Icu_Infineon_TC39x_EnableNotification(ChannelConfig->IcuChannelId);
+/* COMMUNICATION STACK - CANTP */
+// File: CanTp.c
+/* ISO 15765-2 transport on CAN and CAN-FD. Each channel is one half-duplex
+ * connection with its own Tx N-PDU (SF, FF, CF, and FC for received
+ * messages) and Rx N-PDU; the generator numbers N-SDUs and N-PDUs by channel,
+ * so CanTp_Transmit, CanTp_RxIndication and CanTp_TxConfirmation take the
+ * channel index. Frames are up to TX_DL (CanTpTxDl: 8, 12, ..., 64) bytes,
+ * SF and FF use the escape formats for SF_DL > 7 and FF_DL > 4095, and
+ * frames above 8 bytes are padded to the next CAN-FD length.
+ * Frames are sent from the events that allow them: the next CF from the
+ * TxConfirmation of the previous one when STmin is 0, the first CF of a
+ * block from the FC. Each channel has a single timer (N_As, N_Bs, N_Ar,
+ * N_Cr, the STmin gap, the wait for Rx buffer) on a timing wheel of
+ * CANTP_WHEEL_SLOTS main-function ticks, so CanTp_MainFunction only visits
+ * the channels whose timer is due, however many connections are active.
+ * Times are rounded up to whole periods plus one, so no timeout or STmin
+ * ever ends early. As with the SIL Can backends (polling mode), the CanIf
+ * callbacks and CanTp_MainFunction run in one task; only CanTp_Transmit
+ * may come from another and claims its idle channel under the exclusive
+ * area that also guards the wheel. */
+#define CANTP_STATE_IDLE            0u
+#define CANTP_STATE_TX_WAIT_CONF    1u      // SF, FF or CF in CanIf (N_As)
+#define CANTP_STATE_TX_WAIT_FC      2u      // N_Bs
+#define CANTP_STATE_TX_WAIT_CF      3u      // STmin gap, or data not ready yet
+#define CANTP_STATE_RX_WAIT_FC_CONF 4u      // FC in CanIf (N_Ar)
+#define CANTP_STATE_RX_WAIT_CF      5u      // N_Cr
+#define CANTP_STATE_RX_WAIT_BUFFER  6u      // FC.WAIT sent, retry per N_Br
+
+#define CANTP_PCI_SF                0x00u
+#define CANTP_PCI_FF                0x10u
+#define CANTP_PCI_CF                0x20u
+#define CANTP_PCI_FC                0x30u
+#define CANTP_FS_CTS                0u
+#define CANTP_FS_WAIT               1u
+#define CANTP_FS_OVFLW              2u
+
+#define CANTP_CAN_DL                8u      // Classic CAN frame, smallest TX_DL and RX_DL
+#define CANTP_MAX_DL                64u
+#define CANTP_FF_DL_12BIT_MAX       4095u
+
+#ifndef CANTP_MAIN_FUNCTION_PERIOD_US
+#define CANTP_MAIN_FUNCTION_PERIOD_US   1000u
+#endif
+#define CANTP_WHEEL_SLOTS           64u     // Power of two
+#define CANTP_WHEEL_NIL             0xFFFFu
+
+typedef struct {
+    uint8 State;
+    uint8 Dl;                   // Tx: TX_DL; Rx: RX_DL, the CAN_DL of the FF
+    uint8 SeqNum;
+    uint8 BlockSize;            // BS of the current block (0: no further FC)
+    uint8 BlockRemaining;       // CFs left in the current block
+    uint8 WaitCount;            // FC.WAIT sent in a row
+    uint8 FlowStatus;           // Rx: FS of the FC in CanIf
+    boolean FcExpected;         // Tx: the frame in CanIf ends a block
+    uint16 StMinTicks;          // Tx: gap between CFs from the last FC
+    PduLengthType Total;
+    PduLengthType Remaining;    // Bytes not yet sent or received
+    PduLengthType RxBufferSize; // Rx: upper-layer buffer left after the last copy
+} CanTp_ChannelType;
+
+static VAR(CanTp_ChannelType, CANTP_VAR_NOINIT) CanTp_Channel[CANTP_NUM_OF_CHANNELS];
+
+// Timer of each channel, an intrusive doubly linked list per wheel slot
+static VAR(uint16, CANTP_VAR_NOINIT) CanTp_TimerHead[CANTP_WHEEL_SLOTS];
+static VAR(uint16, CANTP_VAR_NOINIT) CanTp_TimerNext[CANTP_NUM_OF_CHANNELS];
+static VAR(uint16, CANTP_VAR_NOINIT) CanTp_TimerPrev[CANTP_NUM_OF_CHANNELS];
+static VAR(uint16, CANTP_VAR_NOINIT) CanTp_TimerRounds[CANTP_NUM_OF_CHANNELS];
+static VAR(uint8, CANTP_VAR_NOINIT) CanTp_TimerSlot[CANTP_NUM_OF_CHANNELS];    // CANTP_WHEEL_SLOTS: not armed
+static VAR(uint32, CANTP_VAR_NOINIT) CanTp_TimerTick;
+
+static CONST(uint8, CANTP_CONST) CanTp_FdLength[CANTP_MAX_DL + 1u] = {
+    // Smallest CAN-FD data length holding n bytes (n > 8)
+    0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 12u, 12u, 12u, 12u, 16u, 16u, 16u, 16u,
+    20u, 20u, 20u, 20u, 24u, 24u, 24u, 24u, 32u, 32u, 32u, 32u, 32u, 32u, 32u, 32u,
+    48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u, 48u,
+    64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u, 64u,
+};
+
+FUNC(void, CANTP_CODE) CanTp_Init(void) {
+    uint16 Channel;
+    uint8 Slot;
+
+    CanTp_TimerTick = 0u;
+    for (Slot = 0u; Slot < CANTP_WHEEL_SLOTS; Slot++) {
+        CanTp_TimerHead[Slot] = CANTP_WHEEL_NIL;
+    }
+    for (Channel = 0u; Channel < CANTP_NUM_OF_CHANNELS; Channel++) {
+        CanTp_Channel[Channel].State = CANTP_STATE_IDLE;
+        CanTp_TimerSlot[Channel] = CANTP_WHEEL_SLOTS;
+    }
 }
 
-/* FLASH DRIVER STACK */
-// File: Fls.c
-FUNC(Std_ReturnType, FLS_CODE) Fls_Write(Fls_AddressType TargetAddress, P2CONST(uint8, AUTOMATIC, FLS_APPL_CONST) SourceAddressPtr, Fls_LengthType Length) {
-    // Step 42: Flash MCAL Driver
-    return Fls_Infineon_TC39x_Write(TargetAddress, SourceAddressPtr, Length);
+static FUNC(uint16, CANTP_CODE) CanTp_UsToTicks(uint32 Us) {
+    // 0 stays 0 (no wait); otherwise ceil plus one for the period already begun, saturated
+    uint32 Ticks;
+
+    if (Us == 0u) {
+        return 0u;
+    }
+    Ticks = ((Us + CANTP_MAIN_FUNCTION_PERIOD_US - 1u) / CANTP_MAIN_FUNCTION_PERIOD_US) + 1u;
+    return (Ticks > 0xFFFFu) ? 0xFFFFu : (uint16)Ticks;
 }
 
-/* MCU DRIVER STACK */
-// File: Mcu.c
-FUNC(Std_ReturnType, MCU_CODE) Mcu_InitClock(Mcu_ClockType ClockSetting) {
-    // Step 43: Microcontroller Unit MCAL Driver
-    P2CONST(Mcu_ClockConfigType, AUTOMATIC, MCU_CONST) ClockConfig = &Mcu_ConfigPtr->McuClockConfig[ClockSetting];
-    
-    return Mcu_Infineon_TC39x_InitClock(ClockConfig);
+static FUNC(uint16, CANTP_CODE) CanTp_StMinToTicks(uint8 StMin) {
+    // 0x00-0x7F: ms; 0xF1-0xF9: 100-900 us; reserved values count as 127 ms
+    if (StMin <= 0x7Fu) {
+        return CanTp_UsToTicks((uint32)StMin * 1000u);
+    }
+    if ((StMin >= 0xF1u) && (StMin <= 0xF9u)) {
+        return CanTp_UsToTicks((uint32)(StMin - 0xF0u) * 100u);
+    }
+    return CanTp_UsToTicks(127000u);
 }
 
-/* PORT DRIVER STACK */
-// File: Port.c
-FUNC(void, PORT_CODE) Port_SetPinDirection(Port_PinType Pin, Port_PinDirectionType Direction) {
-    // Step 44: Port MCAL Driver
-    P2CONST(Port_PinConfigType, AUTOMATIC, PORT_CONST) PinConfig = &Port_ConfigPtr->PortPin[Pin];
-    
-    Port_Infineon_TC39x_SetPinDirection(PinConfig->PortNumber, PinConfig->PinNumber, Direction);
+static FUNC(void, CANTP_CODE) CanTp_TimerStop(uint16 Channel) {
+    uint8 Slot;
+
+    SchM_Enter_CanTp_CANTP_EXCLUSIVE_AREA_0();
+    Slot = CanTp_TimerSlot[Channel];
+    if (Slot != CANTP_WHEEL_SLOTS) {
+        uint16 Prev = CanTp_TimerPrev[Channel];
+        uint16 Next = CanTp_TimerNext[Channel];
+
+        if (Prev == CANTP_WHEEL_NIL) {
+            CanTp_TimerHead[Slot] = Next;
+        } else {
+            CanTp_TimerNext[Prev] = Next;
+        }
+        if (Next != CANTP_WHEEL_NIL) {
+            CanTp_TimerPrev[Next] = Prev;
+        }
+        CanTp_TimerSlot[Channel] = CANTP_WHEEL_SLOTS;
+    }
+    SchM_Exit_CanTp_CANTP_EXCLUSIVE_AREA_0();
 }
 
-/* WATCHDOG DRIVER STACK */
-// File: Wdg.c
-FUNC(Std_ReturnType, WDG_CODE) Wdg_SetTriggerCondition(uint16 timeout) {
-    // Step 45: Watchdog MCAL Driver
-    return Wdg_Infineon_TC39x_SetTriggerCondition(timeout);
+static FUNC(void, CANTP_CODE) CanTp_TimerStart(uint16 Channel, uint16 Ticks) {
+    // (Re)arm the channel's only timer; a timeout configured as 0 expires on the next tick
+    uint8 Slot;
+
+    if (Ticks == 0u) {
+        Ticks = 1u;
+    }
+    CanTp_TimerStop(Channel);
+    SchM_Enter_CanTp_CANTP_EXCLUSIVE_AREA_0();
+    Slot = (uint8)((CanTp_TimerTick + Ticks) & (CANTP_WHEEL_SLOTS - 1u));
+    CanTp_TimerRounds[Channel] = (uint16)((Ticks - 1u) / CANTP_WHEEL_SLOTS);
+    CanTp_TimerPrev[Channel] = CANTP_WHEEL_NIL;
+    CanTp_TimerNext[Channel] = CanTp_TimerHead[Slot];
+    if (CanTp_TimerHead[Slot] != CANTP_WHEEL_NIL) {
+        CanTp_TimerPrev[CanTp_TimerHead[Slot]] = Channel;
+    }
+    CanTp_TimerHead[Slot] = Channel;
+    CanTp_TimerSlot[Channel] = Slot;
+    SchM_Exit_CanTp_CANTP_EXCLUSIVE_AREA_0();
+}
+
+static FUNC(Std_ReturnType, CANTP_CODE) CanTp_SendFrame(uint16 Channel, P2VAR(uint8, AUTOMATIC, AUTOMATIC) Frame,
+                                                       uint8 Length, uint16 TimeoutTicks) {
+    // Pad (to 8 bytes if configured, above 8 always to a CAN-FD length) and hand to CanIf (which copies)
+    PduInfoType PduInfo;
+    uint8 FrameLength = Length;
+
+    if (Length > CANTP_CAN_DL) {
+        FrameLength = CanTp_FdLength[Length];
+    } else if (CanTp_ChannelConfig[Channel].PaddingActivation == TRUE) {
+        FrameLength = CANTP_CAN_DL;
+    }
+    if (FrameLength > Length) {
+        (void)memset(&Frame[Length], (int)CanTp_ChannelConfig[Channel].PaddingByte, (size_t)FrameLength - Length);
+    }
+    PduInfo.SduDataPtr = Frame;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = FrameLength;
+
+    // Timer first: CanIf may confirm before it returns
+    CanTp_TimerStart(Channel, TimeoutTicks);
+    if (CanIf_Transmit(CanTp_ChannelConfig[Channel].TxNPduRef, &PduInfo) != E_OK) {
+        CanTp_TimerStop(Channel);
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+static FUNC(void, CANTP_CODE) CanTp_TxEnd(uint16 Channel, Std_ReturnType Result) {
+    CanTp_TimerStop(Channel);
+    CanTp_Channel[Channel].State = CANTP_STATE_IDLE;
+    PduR_CanTpTxConfirmation(CanTp_ChannelConfig[Channel].TxSduRef, Result);
+}
+
+static FUNC(void, CANTP_CODE) CanTp_RxEnd(uint16 Channel, Std_ReturnType Result) {
+    // An FF rejected with FC.OVFLW was never started towards the upper layer
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    boolean Started = ((Ch->State != CANTP_STATE_RX_WAIT_FC_CONF) || (Ch->FlowStatus != CANTP_FS_OVFLW)) ? TRUE : FALSE;
+
+    CanTp_TimerStop(Channel);
+    Ch->State = CANTP_STATE_IDLE;
+    if (Started == TRUE) {
+        PduR_CanTpRxIndication(CanTp_ChannelConfig[Channel].RxSduRef, Result);
+    }
+}
+
+static FUNC(void, CANTP_CODE) CanTp_TxNextFrame(uint16 Channel) {
+    // Build the SF, FF or next CF from the upper layer's data and send it
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    uint8 Frame[CANTP_MAX_DL];
+    boolean First = (Ch->Remaining == Ch->Total) ? TRUE : FALSE;
+    uint8 Pci;
+    PduLengthType Payload;
+    PduLengthType Available;
+    PduInfoType PduInfo;
+    BufReq_ReturnType BufResult;
+
+    if (First == FALSE) {
+        Frame[0] = (uint8)(CANTP_PCI_CF | Ch->SeqNum);
+        Pci = 1u;
+        Payload = (PduLengthType)(Ch->Dl - 1u);
+    } else if (Ch->Total <= 7u) {
+        Frame[0] = (uint8)(CANTP_PCI_SF | Ch->Total);
+        Pci = 1u;
+        Payload = Ch->Total;
+    } else if ((Ch->Dl > CANTP_CAN_DL) && (Ch->Total <= (PduLengthType)(Ch->Dl - 2u))) {
+        Frame[0] = CANTP_PCI_SF;
+        Frame[1] = (uint8)Ch->Total;
+        Pci = 2u;
+        Payload = Ch->Total;
+    } else if (Ch->Total <= CANTP_FF_DL_12BIT_MAX) {
+        Frame[0] = (uint8)(CANTP_PCI_FF | (Ch->Total >> 8));
+        Frame[1] = (uint8)Ch->Total;
+        Pci = 2u;
+        Payload = (PduLengthType)(Ch->Dl - 2u);
+    } else {
+        Frame[0] = CANTP_PCI_FF;
+        Frame[1] = 0u;
+        Frame[2] = (uint8)((uint32)Ch->Total >> 24);
+        Frame[3] = (uint8)((uint32)Ch->Total >> 16);
+        Frame[4] = (uint8)((uint32)Ch->Total >> 8);
+        Frame[5] = (uint8)Ch->Total;
+        Pci = 6u;
+        Payload = (PduLengthType)(Ch->Dl - 6u);
+    }
+    if (Payload > Ch->Remaining) {
+        Payload = Ch->Remaining;
+    }
+
+    PduInfo.SduDataPtr = &Frame[Pci];
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = Payload;
+    BufResult = PduR_CanTpCopyTxData(CanTp_ChannelConfig[Channel].TxSduRef, &PduInfo, NULL_PTR, &Available);
+    if (BufResult == BUFREQ_E_BUSY) {
+        Ch->State = CANTP_STATE_TX_WAIT_CF;     // Retry from the next main function
+        CanTp_TimerStart(Channel, 1u);
+        return;
+    }
+    if (BufResult != BUFREQ_OK) {
+        CanTp_TxEnd(Channel, E_NOT_OK);
+        return;
+    }
+
+    if (First == TRUE) {
+        Ch->SeqNum = 1u;
+        Ch->FcExpected = TRUE;      // After an FF; a SF has no data left
+    } else {
+        Ch->SeqNum = (uint8)((Ch->SeqNum + 1u) & 0x0Fu);
+        Ch->FcExpected = FALSE;
+        if (Ch->BlockSize != 0u) {
+            Ch->BlockRemaining--;
+            Ch->FcExpected = (Ch->BlockRemaining == 0u) ? TRUE : FALSE;
+        }
+    }
+    Ch->Remaining -= Payload;
+    Ch->State = CANTP_STATE_TX_WAIT_CONF;
+    if (CanTp_SendFrame(Channel, Frame, (uint8)(Pci + Payload), CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NAsMs * 1000u)) != E_OK) {
+        CanTp_TxEnd(Channel, E_NOT_OK);
+    }
+}
+
+FUNC(Std_ReturnType, CANTP_CODE) CanTp_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, CANTP_APPL_CONST) PduInfoPtr) {
+    // Only the length is given; the data is pulled frame by frame through PduR_CanTpCopyTxData
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch;
+    boolean Claimed = FALSE;
+
+    if ((TxPduId >= CANTP_NUM_OF_CHANNELS) || (PduInfoPtr == NULL_PTR) || (PduInfoPtr->SduLength == 0u)) {
+        return E_NOT_OK;
+    }
+    Ch = &CanTp_Channel[TxPduId];
+    SchM_Enter_CanTp_CANTP_EXCLUSIVE_AREA_0();
+    if (Ch->State == CANTP_STATE_IDLE) {
+        Ch->State = CANTP_STATE_TX_WAIT_CONF;
+        Claimed = TRUE;
+    }
+    SchM_Exit_CanTp_CANTP_EXCLUSIVE_AREA_0();
+    if (Claimed == FALSE) {
+        return E_NOT_OK;    // Half duplex: the channel is sending or receiving
+    }
+
+    Ch->Dl = CanTp_ChannelConfig[TxPduId].TxDl;
+    Ch->Total = PduInfoPtr->SduLength;
+    Ch->Remaining = PduInfoPtr->SduLength;
+    Ch->BlockSize = 0u;
+    Ch->StMinTicks = 0u;
+    CanTp_TxNextFrame((uint16)TxPduId);
+    return E_OK;
+}
+
+static FUNC(void, CANTP_CODE) CanTp_SendFlowControl(uint16 Channel, uint8 FlowStatus, uint8 BlockSize) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    uint8 Frame[CANTP_CAN_DL];
+
+    Frame[0] = (uint8)(CANTP_PCI_FC | FlowStatus);
+    Frame[1] = BlockSize;
+    Frame[2] = CanTp_ChannelConfig[Channel].STmin;
+    Ch->FlowStatus = FlowStatus;
+    Ch->State = CANTP_STATE_RX_WAIT_FC_CONF;
+    if (CanTp_SendFrame(Channel, Frame, 3u, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NArMs * 1000u)) != E_OK) {
+        CanTp_RxEnd(Channel, E_NOT_OK);
+    }
+}
+
+static FUNC(void, CANTP_CODE) CanTp_RxNextBlock(uint16 Channel) {
+    // CTS with a BS the upper-layer buffer can take, FC.WAIT while it takes no CF at all
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    PduLengthType CfPayload = (PduLengthType)(Ch->Dl - 1u);
+    PduLengthType Fit;
+    uint8 BlockSize = CanTp_ChannelConfig[Channel].Bs;
+
+    if (Ch->RxBufferSize < Ch->Remaining) {
+        Fit = Ch->RxBufferSize / CfPayload;
+        if (Fit == 0u) {
+            if (Ch->WaitCount >= CanTp_ChannelConfig[Channel].WftMax) {
+                CanTp_RxEnd(Channel, E_NOT_OK);
+                return;
+            }
+            Ch->WaitCount++;
+            CanTp_SendFlowControl(Channel, CANTP_FS_WAIT, 0u);
+            return;
+        }
+        if ((BlockSize == 0u) || (Fit < BlockSize)) {
+            BlockSize = (Fit > 0xFFu) ? 0xFFu : (uint8)Fit;
+        }
+    }
+    Ch->BlockSize = BlockSize;
+    Ch->BlockRemaining = BlockSize;
+    Ch->WaitCount = 0u;
+    CanTp_SendFlowControl(Channel, CANTP_FS_CTS, BlockSize);
+}
+
+static FUNC(BufReq_ReturnType, CANTP_CODE) CanTp_RxCopy(uint16 Channel, P2CONST(uint8, AUTOMATIC, CANTP_APPL_DATA) Data, PduLengthType Length) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    PduInfoType PduInfo;
+    BufReq_ReturnType Result;
+
+    PduInfo.SduDataPtr = (uint8*)Data;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = Length;
+    Result = PduR_CanTpCopyRxData(CanTp_ChannelConfig[Channel].RxSduRef, &PduInfo, &Ch->RxBufferSize);
+    if (Result == BUFREQ_OK) {
+        Ch->Remaining -= Length;
+    }
+    return Result;
+}
+
+static FUNC(void, CANTP_CODE) CanTp_RxFirstFrame(uint16 Channel, P2CONST(PduInfoType, AUTOMATIC, CANTP_APPL_DATA) PduInfoPtr) {
+    // SF or FF: a new message, which replaces one still being received
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    P2CONST(uint8, AUTOMATIC, CANTP_APPL_DATA) Frame = PduInfoPtr->SduDataPtr;
+    PduLengthType Length = PduInfoPtr->SduLength;
+    PduLengthType MessageLength;
+    PduLengthType Data;
+    uint8 Pci;
+    PduInfoType FirstData;
+    BufReq_ReturnType Result;
+
+    if ((Frame[0] & 0xF0u) == CANTP_PCI_SF) {
+        if (((Frame[0] & 0x0Fu) != 0u) && (Length <= CANTP_CAN_DL)) {
+            MessageLength = (PduLengthType)(Frame[0] & 0x0Fu);
+            Pci = 1u;
+        } else if (((Frame[0] & 0x0Fu) == 0u) && (Length > CANTP_CAN_DL) && (Frame[1] > 7u)) {
+            MessageLength = Frame[1];
+            Pci = 2u;
+        } else {
+            return;
+        }
+        if (MessageLength > (PduLengthType)(Length - Pci)) {
+            return;
+        }
+        Data = MessageLength;
+    } else {
+        if (Length < CANTP_CAN_DL) {
+            return;
+        }
+        MessageLength = (PduLengthType)((((PduLengthType)Frame[0] & 0x0Fu) << 8) | Frame[1]);
+        Pci = 2u;
+        if (MessageLength == 0u) {
+            MessageLength = (PduLengthType)(((uint32)Frame[2] << 24) | ((uint32)Frame[3] << 16) | ((uint32)Frame[4] << 8) | Frame[5]);
+            Pci = 6u;
+            if (MessageLength <= CANTP_FF_DL_12BIT_MAX) {
+                return;
+            }
+        }
+        Data = (PduLengthType)(Length - Pci);
+        if (MessageLength <= Data) {
+            return;     // Would have fitted a SF
+        }
+    }
+
+    if (Ch->State != CANTP_STATE_IDLE) {
+        if (Ch->State < CANTP_STATE_RX_WAIT_FC_CONF) {
+            return;     // Half duplex: sending
+        }
+        CanTp_RxEnd(Channel, E_NOT_OK);
+    }
+
+    FirstData.SduDataPtr = (uint8*)&Frame[Pci];
+    FirstData.MetaDataPtr = NULL_PTR;
+    FirstData.SduLength = Data;
+    Result = PduR_CanTpStartOfReception(CanTp_ChannelConfig[Channel].RxSduRef, &FirstData, MessageLength, &Ch->RxBufferSize);
+    if (Result != BUFREQ_OK) {
+        if ((Result == BUFREQ_E_OVFL) && ((Frame[0] & 0xF0u) == CANTP_PCI_FF)) {
+            // Rejected FF: tell the sender, then forget the message
+            uint8 Fc[CANTP_CAN_DL];
+            Fc[0] = (uint8)(CANTP_PCI_FC | CANTP_FS_OVFLW);
+            Fc[1] = 0u;
+            Fc[2] = 0u;
+            Ch->FlowStatus = CANTP_FS_OVFLW;
+            Ch->State = CANTP_STATE_RX_WAIT_FC_CONF;
+            if (CanTp_SendFrame(Channel, Fc, 3u, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NArMs * 1000u)) != E_OK) {
+                Ch->State = CANTP_STATE_IDLE;
+            }
+        }
+        return;
+    }
+
+    Ch->State = CANTP_STATE_RX_WAIT_CF;
+    Ch->Dl = (uint8)Length;
+    Ch->Total = MessageLength;
+    Ch->Remaining = MessageLength;
+    Ch->SeqNum = 1u;
+    Ch->WaitCount = 0u;
+    if ((Ch->RxBufferSize < Data) || (CanTp_RxCopy(Channel, &Frame[Pci], Data) != BUFREQ_OK)) {
+        CanTp_RxEnd(Channel, E_NOT_OK);
+    } else if (Ch->Remaining == 0u) {
+        CanTp_RxEnd(Channel, E_OK);
+    } else {
+        CanTp_RxNextBlock(Channel);
+    }
+}
+
+static FUNC(void, CANTP_CODE) CanTp_RxConsecutiveFrame(uint16 Channel, P2CONST(PduInfoType, AUTOMATIC, CANTP_APPL_DATA) PduInfoPtr) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    PduLengthType Data = Ch->Remaining;
+
+    if (Ch->State != CANTP_STATE_RX_WAIT_CF) {
+        return;
+    }
+    if (Data > (PduLengthType)(Ch->Dl - 1u)) {
+        Data = (PduLengthType)(Ch->Dl - 1u);
+    }
+    if (((PduInfoPtr->SduDataPtr[0] & 0x0Fu) != Ch->SeqNum) || ((PduLengthType)(PduInfoPtr->SduLength - 1u) < Data) ||
+        (Ch->RxBufferSize < Data) || (CanTp_RxCopy(Channel, &PduInfoPtr->SduDataPtr[1], Data) != BUFREQ_OK)) {
+        CanTp_RxEnd(Channel, E_NOT_OK);    // Wrong SN, short CF or upper layer failed
+        return;
+    }
+    Ch->SeqNum = (uint8)((Ch->SeqNum + 1u) & 0x0Fu);
+
+    if (Ch->Remaining == 0u) {
+        CanTp_RxEnd(Channel, E_OK);
+    } else if ((Ch->BlockSize != 0u) && (--Ch->BlockRemaining == 0u)) {
+        CanTp_TimerStop(Channel);
+        CanTp_RxNextBlock(Channel);
+    } else {
+        CanTp_TimerStart(Channel, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NCrMs * 1000u));
+    }
+}
+
+static FUNC(void, CANTP_CODE) CanTp_RxFlowControl(uint16 Channel, P2CONST(PduInfoType, AUTOMATIC, CANTP_APPL_DATA) PduInfoPtr) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+    P2CONST(uint8, AUTOMATIC, CANTP_APPL_DATA) Frame = PduInfoPtr->SduDataPtr;
+
+    if ((Ch->State != CANTP_STATE_TX_WAIT_FC) || (PduInfoPtr->SduLength < 3u)) {
+        return;
+    }
+    switch (Frame[0] & 0x0Fu) {
+        case CANTP_FS_CTS:
+            Ch->BlockSize = Frame[1];
+            Ch->BlockRemaining = Frame[1];
+            Ch->StMinTicks = CanTp_StMinToTicks(Frame[2]);
+            CanTp_TimerStop(Channel);
+            CanTp_TxNextFrame(Channel);
+            break;
+        case CANTP_FS_WAIT:
+            CanTp_TimerStart(Channel, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NBsMs * 1000u));
+            break;
+        default:
+            CanTp_TxEnd(Channel, E_NOT_OK);     // Overflow or invalid FS
+            break;
+    }
+}
+
+FUNC(void, CANTP_CODE) CanTp_RxIndication(PduIdType RxPduId, P2CONST(PduInfoType, AUTOMATIC, CANTP_APPL_DATA) PduInfoPtr) {
+    if ((RxPduId >= CANTP_NUM_OF_CHANNELS) || (PduInfoPtr == NULL_PTR) || (PduInfoPtr->SduLength == 0u)) {
+        return;
+    }
+    switch (PduInfoPtr->SduDataPtr[0] & 0xF0u) {
+        case CANTP_PCI_SF:
+        case CANTP_PCI_FF:
+            if (PduInfoPtr->SduLength >= 2u) {
+                CanTp_RxFirstFrame((uint16)RxPduId, PduInfoPtr);
+            }
+            break;
+        case CANTP_PCI_CF:
+            CanTp_RxConsecutiveFrame((uint16)RxPduId, PduInfoPtr);
+            break;
+        case CANTP_PCI_FC:
+            CanTp_RxFlowControl((uint16)RxPduId, PduInfoPtr);
+            break;
+        default:
+            break;      // Unknown N_PCI type: ignored
+    }
+}
+
+FUNC(void, CANTP_CODE) CanTp_TxConfirmation(PduIdType TxPduId, Std_ReturnType result) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch;
+    uint16 Channel = (uint16)TxPduId;
+
+    if (TxPduId >= CANTP_NUM_OF_CHANNELS) {
+        return;
+    }
+    Ch = &CanTp_Channel[Channel];
+    if (Ch->State == CANTP_STATE_TX_WAIT_CONF) {
+        if (result != E_OK) {
+            CanTp_TxEnd(Channel, E_NOT_OK);
+        } else if (Ch->Remaining == 0u) {
+            CanTp_TxEnd(Channel, E_OK);
+        } else if (Ch->FcExpected == TRUE) {
+            Ch->State = CANTP_STATE_TX_WAIT_FC;
+            CanTp_TimerStart(Channel, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NBsMs * 1000u));
+        } else if (Ch->StMinTicks == 0u) {
+            CanTp_TimerStop(Channel);
+            CanTp_TxNextFrame(Channel);
+        } else {
+            Ch->State = CANTP_STATE_TX_WAIT_CF;
+            CanTp_TimerStart(Channel, Ch->StMinTicks);
+        }
+    } else if (Ch->State == CANTP_STATE_RX_WAIT_FC_CONF) {
+        if ((result != E_OK) || (Ch->FlowStatus == CANTP_FS_OVFLW)) {
+            CanTp_RxEnd(Channel, E_NOT_OK);
+        } else if (Ch->FlowStatus == CANTP_FS_WAIT) {
+            Ch->State = CANTP_STATE_RX_WAIT_BUFFER;
+            CanTp_TimerStart(Channel, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NBrMs * 1000u));
+        } else {
+            Ch->State = CANTP_STATE_RX_WAIT_CF;
+            CanTp_TimerStart(Channel, CanTp_UsToTicks(CanTp_ChannelConfig[Channel].NCrMs * 1000u));
+        }
+    } else {
+        // Late confirmation of an aborted message
+    }
+}
+
+static FUNC(void, CANTP_CODE) CanTp_TimerExpired(uint16 Channel) {
+    P2VAR(CanTp_ChannelType, AUTOMATIC, CANTP_VAR_NOINIT) Ch = &CanTp_Channel[Channel];
+
+    switch (Ch->State) {
+        case CANTP_STATE_TX_WAIT_CF:
+            CanTp_TxNextFrame(Channel);
+            break;
+        case CANTP_STATE_RX_WAIT_BUFFER:
+            // Ask the upper layer again how much it can take now
+            if (CanTp_RxCopy(Channel, NULL_PTR, 0u) != BUFREQ_OK) {
+                CanTp_RxEnd(Channel, E_NOT_OK);
+            } else {
+                CanTp_RxNextBlock(Channel);
+            }
+            break;
+        case CANTP_STATE_TX_WAIT_CONF:
+        case CANTP_STATE_TX_WAIT_FC:
+            CanTp_TxEnd(Channel, E_NOT_OK);     // N_As, N_Bs
+            break;
+        case CANTP_STATE_RX_WAIT_FC_CONF:
+        case CANTP_STATE_RX_WAIT_CF:
+            CanTp_RxEnd(Channel, E_NOT_OK);     // N_Ar, N_Cr
+            break;
+        default:
+            break;
+    }
+}
+
+FUNC(void, CANTP_CODE) CanTp_MainFunction(void) {
+    // Unlink the due timers of this tick, then run them: a handler may re-arm
+    // its channel into any slot, including this one
+    uint16 Due = CANTP_WHEEL_NIL;
+    uint16 Node;
+    uint8 Slot;
+
+    SchM_Enter_CanTp_CANTP_EXCLUSIVE_AREA_0();
+    CanTp_TimerTick++;
+    Slot = (uint8)(CanTp_TimerTick & (CANTP_WHEEL_SLOTS - 1u));
+    Node = CanTp_TimerHead[Slot];
+    while (Node != CANTP_WHEEL_NIL) {
+        uint16 Next = CanTp_TimerNext[Node];
+
+        if (CanTp_TimerRounds[Node] > 0u) {
+            CanTp_TimerRounds[Node]--;
+        } else {
+            uint16 Prev = CanTp_TimerPrev[Node];
+
+            if (Prev == CANTP_WHEEL_NIL) {
+                CanTp_TimerHead[Slot] = Next;
+            } else {
+                CanTp_TimerNext[Prev] = Next;
+            }
+            if (Next != CANTP_WHEEL_NIL) {
+                CanTp_TimerPrev[Next] = Prev;
+            }
+            CanTp_TimerSlot[Node] = CANTP_WHEEL_SLOTS;
+            CanTp_TimerNext[Node] = Due;
+            Due = Node;
+        }
+        Node = Next;
+    }
+    SchM_Exit_CanTp_CANTP_EXCLUSIVE_AREA_0();
+
+    while (Due != CANTP_WHEEL_NIL) {
+        Node = Due;
+        Due = CanTp_TimerNext[Node];
+        CanTp_TimerExpired(Node);
+    }
+}
+
+/* COMMUNICATION STACK - DOIP */
+// File: DoIP.c
+/* ISO 13400-2 DoIP entity for SIL hosts. It owns its sockets, as the vcan
+ * backend owns its SocketCAN sockets, instead of sitting on SoAd.
+ * - UDP 13400: DOIP_ANNOUNCE_NUM vehicle announcements after DoIP_Init,
+ *   then answers to vehicle identification requests (plain, by EID, by VIN).
+ * - TCP 13400: one epoll set holds the listening socket, the UDP socket
+ *   and every tester connection. DoIP_MainFunction serves whichever are
+ *   ready, so its cost grows with traffic rather than with connections.
+ *   Tester connections occupy DOIP_MAX_TESTER_CONNECTIONS slots. Each slot
+ *   has an Rx buffer for one whole request and a Tx buffer that DCM
+ *   responses are streamed into.
+ * - Routing activation registers one tester address per connection.
+ *   Diagnostic messages from a registered tester go to DCM through PduR
+ *   (PduR_DoIPStartOfReception, PduR_DoIPCopyRxData, PduR_DoIPRxIndication);
+ *   the response comes back through DoIP_TpTransmit and
+ *   PduR_DoIPCopyTxData, pulled only while the Tx buffer has room.
+ * DoIP's PduR N-SDUs are numbered by connection slot; PduR routes them to
+ * DCM's DoIP protocol PDUs. DCM serves one request at a time. While it is
+ * busy (BUFREQ_E_BUSY), a tester's request stays in the tester's Rx buffer
+ * and its socket stops being read. Such testers are retried in arrival
+ * order from DoIP_MainFunction. Any other refusal is answered with a
+ * diagnostic NACK (target unreachable). */
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define DOIP_PORT                           13400u
+#define DOIP_PROTOCOL_VERSION               0x02u       // ISO 13400-2:2012
+#define DOIP_PROTOCOL_VERSION_2019          0x03u       // Accepted from testers, answered with 0x02
+#define DOIP_PROTOCOL_VERSION_DEFAULT       0xFFu       // Vehicle identification requests only
+#define DOIP_HEADER_LENGTH                  8u
+
+#define DOIP_PT_GENERIC_NACK                0x0000u
+#define DOIP_PT_VEHICLE_ID_REQUEST          0x0001u
+#define DOIP_PT_VEHICLE_ID_REQUEST_EID      0x0002u
+#define DOIP_PT_VEHICLE_ID_REQUEST_VIN      0x0003u
+#define DOIP_PT_VEHICLE_ANNOUNCEMENT        0x0004u     // Also the identification response
+#define DOIP_PT_ROUTING_ACTIVATION_REQUEST  0x0005u
+#define DOIP_PT_ROUTING_ACTIVATION_RESPONSE 0x0006u
+#define DOIP_PT_ALIVE_CHECK_RESPONSE        0x0008u
+#define DOIP_PT_ENTITY_STATUS_RESPONSE      0x4002u
+#define DOIP_PT_POWER_MODE_RESPONSE         0x4004u
+#define DOIP_PT_DIAG_MESSAGE                0x8001u
+#define DOIP_PT_DIAG_ACK                    0x8002u
+#define DOIP_PT_DIAG_NACK                   0x8003u
+
+#define DOIP_HDR_NACK_INCORRECT_PATTERN     0x00u
+#define DOIP_HDR_NACK_UNKNOWN_PAYLOAD_TYPE  0x01u
+#define DOIP_HDR_NACK_MESSAGE_TOO_LARGE     0x02u
+#define DOIP_HDR_NACK_INVALID_LENGTH        0x04u
+
+#define DOIP_RA_UNKNOWN_SOURCE_ADDRESS      0x00u
+#define DOIP_RA_SOURCE_ADDRESS_MISMATCH     0x02u
+#define DOIP_RA_SOURCE_ADDRESS_REGISTERED   0x03u
+#define DOIP_RA_UNSUPPORTED_TYPE            0x06u
+#define DOIP_RA_SUCCESS                     0x10u
+
+#define DOIP_DIAG_ACK                       0x00u
+#define DOIP_DIAG_NACK_INVALID_SA           0x02u
+#define DOIP_DIAG_NACK_UNKNOWN_TA           0x03u
+#define DOIP_DIAG_NACK_MESSAGE_TOO_LARGE    0x04u
+#define DOIP_DIAG_NACK_OUT_OF_MEMORY        0x05u
+#define DOIP_DIAG_NACK_TARGET_UNREACHABLE   0x06u
+
+#define DOIP_TESTER_ADDRESS_MIN             0x0E00u     // External test equipment
+#define DOIP_TESTER_ADDRESS_MAX             0x0FFFu
+#define DOIP_FUNCTIONAL_ADDRESS             0xE400u
+
+#ifndef DOIP_MAX_TESTER_CONNECTIONS
+#define DOIP_MAX_TESTER_CONNECTIONS         256u
+#endif
+#ifndef DOIP_MAX_REQUEST_LENGTH
+#define DOIP_MAX_REQUEST_LENGTH             4095u       // DCM_RX_BUFFER_SIZE
+#endif
+#ifndef DOIP_TX_BUFFER_SIZE
+#define DOIP_TX_BUFFER_SIZE                 4096u
+#endif
+#ifndef DOIP_EPOLL_TIMEOUT_MS
+#define DOIP_EPOLL_TIMEOUT_MS               0           // SIL hosts with a DoIP thread: the main-function period
+#endif
+#define DOIP_MAX_PAYLOAD_LENGTH             (4u + DOIP_MAX_REQUEST_LENGTH)
+#define DOIP_RX_BUFFER_SIZE                 (DOIP_HEADER_LENGTH + DOIP_MAX_PAYLOAD_LENGTH)
+#define DOIP_UDP_BUFFER_SIZE                64u
+#define DOIP_EPOLL_BATCH                    64u
+#define DOIP_ANNOUNCE_NUM                   3u
+#define DOIP_ANNOUNCE_INTERVAL_MS           500u
+#define DOIP_INITIAL_INACTIVITY_MS          2000u       // T_TCP_Initial_Inactivity
+#define DOIP_GENERAL_INACTIVITY_MS          300000u     // T_TCP_General_Inactivity
+#define DOIP_INACTIVITY_SWEEP_MS            1000u
+#define DOIP_HELD_POLL_LIMIT                8u          // Failed retries before held testers wait in epoll_wait too
+
+#define DOIP_EPOLL_LISTEN                   0xFFFFFFFFu // epoll_data.u64 of the two server sockets
+#define DOIP_EPOLL_UDP                      0xFFFFFFFEu // (connections: generation << 32 | slot)
+#define DOIP_NO_CONNECTION                  0xFFFFu
+
+#define DOIP_CONN_FREE                      0u
+#define DOIP_CONN_OPEN                      1u          // Socket accepted, no routing activation yet
+#define DOIP_CONN_ROUTED                    2u
+
+#define DOIP_RX_DONE                        0u
+#define DOIP_RX_HELD                        1u          // DCM busy: message kept at the buffer front
+#define DOIP_RX_CLOSED                      2u
+
+typedef struct {
+    sint32 Socket;
+    uint8 State;
+    boolean Held;               // Waiting for DCM, socket not read meanwhile
+    boolean InHeldQueue;
+    boolean DiagPending;        // A request was handed to DCM, its response is owed to this tester
+    uint16 TesterAddress;
+    uint32 EventMask;           // Registered with epoll
+    uint32 Generation;          // Per accept: events of a previous socket in the slot are ignored
+    uint32 LastActivityMs;
+    uint32 RxLength;
+    uint32 RxDiscard;           // Payload bytes of a rejected (too large) message still to skip
+    uint32 TxStart;
+    uint32 TxEnd;
+    PduLengthType TxRemaining;  // Response bytes DCM has not handed over yet
+    uint8 RxBuffer[DOIP_RX_BUFFER_SIZE];
+    uint8 TxBuffer[DOIP_TX_BUFFER_SIZE];
+} DoIP_ConnectionType;
+
+static VAR(DoIP_ConnectionType, DOIP_VAR_NOINIT) DoIP_Connection[DOIP_MAX_TESTER_CONNECTIONS];
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_FreeStack[DOIP_MAX_TESTER_CONNECTIONS];
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_FreeCount;
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_TesterConnection[DOIP_TESTER_ADDRESS_MAX - DOIP_TESTER_ADDRESS_MIN + 1u];
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_HeldQueue[DOIP_MAX_TESTER_CONNECTIONS];
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_HeldHead;
+static VAR(uint16, DOIP_VAR_NOINIT) DoIP_HeldCount;
+static VAR(uint8, DOIP_VAR_NOINIT) DoIP_HeldPolls;
+
+static VAR(sint32, DOIP_VAR_NOINIT) DoIP_EpollFd = -1;
+static VAR(sint32, DOIP_VAR_NOINIT) DoIP_ListenSocket = -1;
+static VAR(sint32, DOIP_VAR_NOINIT) DoIP_UdpSocket = -1;
+static VAR(uint8, DOIP_VAR_NOINIT) DoIP_AnnounceCount;
+static VAR(uint32, DOIP_VAR_NOINIT) DoIP_NextAnnounceMs;
+static VAR(uint32, DOIP_VAR_NOINIT) DoIP_NextSweepMs;
+
+static FUNC(uint32, DOIP_CODE) DoIP_NowMs(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32)(((uint64)ts.tv_sec * 1000u) + ((uint64)ts.tv_nsec / 1000000u));
+}
+
+FUNC(void, DOIP_CODE) DoIP_WriteHeader(P2VAR(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Buffer, uint16 PayloadType, uint32 PayloadLength) {
+    Buffer[0] = DOIP_PROTOCOL_VERSION;
+    Buffer[1] = (uint8)~DOIP_PROTOCOL_VERSION;
+    Buffer[2] = (uint8)(PayloadType >> 8);
+    Buffer[3] = (uint8)PayloadType;
+    Buffer[4] = (uint8)(PayloadLength >> 24);
+    Buffer[5] = (uint8)(PayloadLength >> 16);
+    Buffer[6] = (uint8)(PayloadLength >> 8);
+    Buffer[7] = (uint8)PayloadLength;
+}
+
+FUNC(boolean, DOIP_CODE) DoIP_ReadHeader(P2CONST(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Buffer,
+                                               P2VAR(uint16, AUTOMATIC, AUTOMATIC) PayloadType, P2VAR(uint32, AUTOMATIC, AUTOMATIC) PayloadLength) {
+    // Versions 0x02 and 0x03 with their inverse byte; the default version 0xFF only on identification requests
+    if (((uint8)(Buffer[0] ^ Buffer[1]) != 0xFFu) ||
+        ((Buffer[0] != DOIP_PROTOCOL_VERSION) && (Buffer[0] != DOIP_PROTOCOL_VERSION_2019) && (Buffer[0] != DOIP_PROTOCOL_VERSION_DEFAULT))) {
+        return FALSE;
+    }
+    *PayloadType = (uint16)(((uint16)Buffer[2] << 8) | Buffer[3]);
+    *PayloadLength = ((uint32)Buffer[4] << 24) | ((uint32)Buffer[5] << 16) | ((uint32)Buffer[6] << 8) | Buffer[7];
+    if ((Buffer[0] == DOIP_PROTOCOL_VERSION_DEFAULT) &&
+        ((*PayloadType < DOIP_PT_VEHICLE_ID_REQUEST) || (*PayloadType > DOIP_PT_VEHICLE_ID_REQUEST_VIN))) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* DoIP - UDP: announcement and vehicle identification */
+static FUNC(void, DOIP_CODE) DoIP_UdpSend(P2CONST(struct sockaddr_in, AUTOMATIC, AUTOMATIC) Dest, uint16 PayloadType,
+                                         P2CONST(uint8, AUTOMATIC, DOIP_APPL_DATA) Payload, uint32 PayloadLength) {
+    uint8 Message[DOIP_UDP_BUFFER_SIZE];
+
+    DoIP_WriteHeader(Message, PayloadType, PayloadLength);
+    (void)memcpy(&Message[DOIP_HEADER_LENGTH], Payload, PayloadLength);
+    (void)sendto(DoIP_UdpSocket, Message, DOIP_HEADER_LENGTH + PayloadLength, 0, (const struct sockaddr*)Dest, sizeof(*Dest));
+}
+
+static FUNC(void, DOIP_CODE) DoIP_UdpSendIdentification(P2CONST(struct sockaddr_in, AUTOMATIC, AUTOMATIC) Dest) {
+    // VIN, logical address, EID, GID, further action (none), VIN/GID sync status (synchronized)
+    uint8 Payload[33];
+
+    (void)memcpy(&Payload[0], DoIP_EntityConfig.Vin, 17u);
+    Payload[17] = (uint8)(DoIP_EntityConfig.LogicalAddress >> 8);
+    Payload[18] = (uint8)DoIP_EntityConfig.LogicalAddress;
+    (void)memcpy(&Payload[19], DoIP_EntityConfig.Eid, 6u);
+    (void)memcpy(&Payload[25], DoIP_EntityConfig.Gid, 6u);
+    Payload[31] = 0x00u;
+    Payload[32] = 0x00u;
+    DoIP_UdpSend(Dest, DOIP_PT_VEHICLE_ANNOUNCEMENT, Payload, sizeof(Payload));
+}
+
+static FUNC(void, DOIP_CODE) DoIP_UdpReceive(void) {
+    uint8 Message[DOIP_UDP_BUFFER_SIZE];
+    struct sockaddr_in From;
+    socklen_t FromLength;
+    ssize_t Received;
+    uint16 PayloadType;
+    uint32 PayloadLength;
+    uint8 Nack;
+
+    for (;;) {
+        FromLength = sizeof(From);
+        Received = recvfrom(DoIP_UdpSocket, Message, sizeof(Message), 0, (struct sockaddr*)&From, &FromLength);
+        if (Received < 0) {
+            return;     // EAGAIN: drained
+        }
+        if ((Received < (ssize_t)DOIP_HEADER_LENGTH) || (DoIP_ReadHeader(Message, &PayloadType, &PayloadLength) == FALSE)) {
+            Nack = DOIP_HDR_NACK_INCORRECT_PATTERN;
+            DoIP_UdpSend(&From, DOIP_PT_GENERIC_NACK, &Nack, 1u);
+            continue;
+        }
+        if (PayloadLength != (uint32)(Received - (ssize_t)DOIP_HEADER_LENGTH)) {
+            Nack = DOIP_HDR_NACK_INVALID_LENGTH;
+            DoIP_UdpSend(&From, DOIP_PT_GENERIC_NACK, &Nack, 1u);
+            continue;
+        }
+        switch (PayloadType) {
+            case DOIP_PT_VEHICLE_ID_REQUEST:
+                if (PayloadLength == 0u) {
+                    DoIP_UdpSendIdentification(&From);
+                }
+                break;
+            case DOIP_PT_VEHICLE_ID_REQUEST_EID:
+                if ((PayloadLength == 6u) && (memcmp(&Message[DOIP_HEADER_LENGTH], DoIP_EntityConfig.Eid, 6u) == 0)) {
+                    DoIP_UdpSendIdentification(&From);
+                }
+                break;
+            case DOIP_PT_VEHICLE_ID_REQUEST_VIN:
+                if ((PayloadLength == 17u) && (memcmp(&Message[DOIP_HEADER_LENGTH], DoIP_EntityConfig.Vin, 17u) == 0)) {
+                    DoIP_UdpSendIdentification(&From);
+                }
+                break;
+            case DOIP_PT_GENERIC_NACK:
+            case DOIP_PT_VEHICLE_ANNOUNCEMENT:
+            case DOIP_PT_ENTITY_STATUS_RESPONSE:
+            case DOIP_PT_POWER_MODE_RESPONSE:
+                break;  // Our own broadcast echoed back, or another entity's answers: never NACKed
+            default:
+                Nack = DOIP_HDR_NACK_UNKNOWN_PAYLOAD_TYPE;
+                DoIP_UdpSend(&From, DOIP_PT_GENERIC_NACK, &Nack, 1u);
+                break;
+        }
+    }
+}
+
+/* DoIP - TCP: tester connections */
+static FUNC(void, DOIP_CODE) DoIP_TcpUpdateEvents(uint16 ConnIdx) {
+    // Read unless held, wait for writability while the Tx buffer is not empty
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    struct epoll_event Event;
+
+    Event.events = ((Conn->Held == FALSE) ? (uint32)EPOLLIN : 0u) | ((Conn->TxEnd != Conn->TxStart) ? (uint32)EPOLLOUT : 0u);
+    if (Event.events != Conn->EventMask) {
+        Event.data.u64 = ((uint64)Conn->Generation << 32) | ConnIdx;
+        (void)epoll_ctl(DoIP_EpollFd, EPOLL_CTL_MOD, Conn->Socket, &Event);
+        Conn->EventMask = Event.events;
+    }
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpClose(uint16 ConnIdx) {
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+
+    (void)close(Conn->Socket);     // Also leaves the epoll set
+    if (Conn->State == DOIP_CONN_ROUTED) {
+        DoIP_TesterConnection[Conn->TesterAddress - DOIP_TESTER_ADDRESS_MIN] = DOIP_NO_CONNECTION;
+    }
+    if (Conn->TxRemaining > 0u) {
+        Conn->TxRemaining = 0u;
+        PduR_DoIPTxConfirmation(ConnIdx, E_NOT_OK);
+    }
+    // A stale entry in the held queue is dropped when it reaches the head
+    Conn->State = DOIP_CONN_FREE;
+    Conn->Held = FALSE;
+    Conn->DiagPending = FALSE;
+    DoIP_FreeStack[DoIP_FreeCount] = ConnIdx;
+    DoIP_FreeCount++;
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpFlush(uint16 ConnIdx) {
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+
+    while (Conn->TxStart < Conn->TxEnd) {
+        ssize_t Sent = send(Conn->Socket, &Conn->TxBuffer[Conn->TxStart], Conn->TxEnd - Conn->TxStart, MSG_NOSIGNAL);
+        if (Sent <= 0) {
+            break;      // EAGAIN: resumed on EPOLLOUT; errors show up as EPOLLERR/EPOLLHUP
+        }
+        Conn->TxStart += (uint32)Sent;
+    }
+    if (Conn->TxStart == Conn->TxEnd) {
+        Conn->TxStart = 0u;
+        Conn->TxEnd = 0u;
+    }
+}
+
+static FUNC_P2VAR(uint8, DOIP_VAR_NOINIT, DOIP_CODE) DoIP_TcpReserve(uint16 ConnIdx, uint32 Length) {
+    // Length contiguous bytes at the end of the Tx buffer; NULL_PTR if the tester has stopped reading
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    P2VAR(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Space;
+
+    if ((DOIP_TX_BUFFER_SIZE - (Conn->TxEnd - Conn->TxStart)) < Length) {
+        return NULL_PTR;
+    }
+    if ((DOIP_TX_BUFFER_SIZE - Conn->TxEnd) < Length) {
+        (void)memmove(Conn->TxBuffer, &Conn->TxBuffer[Conn->TxStart], Conn->TxEnd - Conn->TxStart);
+        Conn->TxEnd -= Conn->TxStart;
+        Conn->TxStart = 0u;
+    }
+    Space = &Conn->TxBuffer[Conn->TxEnd];
+    Conn->TxEnd += Length;
+    return Space;
+}
+
+static FUNC(Std_ReturnType, DOIP_CODE) DoIP_TcpQueue(uint16 ConnIdx, uint16 PayloadType,
+                                                    P2CONST(uint8, AUTOMATIC, DOIP_APPL_DATA) Payload, uint32 PayloadLength) {
+    P2VAR(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Message = DoIP_TcpReserve(ConnIdx, DOIP_HEADER_LENGTH + PayloadLength);
+
+    if (Message == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    DoIP_WriteHeader(Message, PayloadType, PayloadLength);
+    (void)memcpy(&Message[DOIP_HEADER_LENGTH], Payload, PayloadLength);
+    return E_OK;
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpPullResponse(uint16 ConnIdx) {
+    // Move as much of the DCM response as fits and send it, until the socket blocks or the response is complete
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    PduInfoType PduInfo;
+    PduLengthType Available;
+
+    do {
+        if ((Conn->TxRemaining > 0u) && (Conn->TxStart > 0u)) {
+            (void)memmove(Conn->TxBuffer, &Conn->TxBuffer[Conn->TxStart], Conn->TxEnd - Conn->TxStart);
+            Conn->TxEnd -= Conn->TxStart;
+            Conn->TxStart = 0u;
+        }
+        if ((Conn->TxRemaining > 0u) && (Conn->TxEnd < DOIP_TX_BUFFER_SIZE)) {
+            PduInfo.SduDataPtr = &Conn->TxBuffer[Conn->TxEnd];
+            PduInfo.MetaDataPtr = NULL_PTR;
+            PduInfo.SduLength = (PduLengthType)(DOIP_TX_BUFFER_SIZE - Conn->TxEnd);
+            if (PduInfo.SduLength > Conn->TxRemaining) {
+                PduInfo.SduLength = Conn->TxRemaining;
+            }
+            if (PduR_DoIPCopyTxData(ConnIdx, &PduInfo, NULL_PTR, &Available) != BUFREQ_OK) {
+                DoIP_TcpClose(ConnIdx);     // The message is cut short, the stream cannot continue
+                return;
+            }
+            Conn->TxEnd += PduInfo.SduLength;
+            Conn->TxRemaining -= PduInfo.SduLength;
+            if (Conn->TxRemaining == 0u) {
+                Conn->DiagPending = FALSE;
+                PduR_DoIPTxConfirmation(ConnIdx, E_OK);
+            }
+        }
+        DoIP_TcpFlush(ConnIdx);
+    } while ((Conn->TxRemaining > 0u) && (Conn->TxEnd == 0u));   // Drained completely: EPOLLOUT would not fire
+    DoIP_TcpUpdateEvents(ConnIdx);
+}
+
+FUNC(Std_ReturnType, DOIP_CODE) DoIP_TpTransmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, DOIP_APPL_CONST) PduInfoPtr) {
+    // DCM response: only the length is given, the data is pulled as the socket drains
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn;
+    P2VAR(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Header;
+
+    if ((TxPduId >= DOIP_MAX_TESTER_CONNECTIONS) || (PduInfoPtr == NULL_PTR)) {
+        return E_NOT_OK;
+    }
+    Conn = &DoIP_Connection[TxPduId];
+    if ((Conn->State != DOIP_CONN_ROUTED) || (Conn->DiagPending == FALSE) || (Conn->TxRemaining > 0u)) {
+        return E_NOT_OK;    // Tester gone (slot possibly reused) or response already running
+    }
+    Header = DoIP_TcpReserve((uint16)TxPduId, DOIP_HEADER_LENGTH + 4u);
+    if (Header == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    DoIP_WriteHeader(Header, DOIP_PT_DIAG_MESSAGE, 4u + PduInfoPtr->SduLength);
+    Header[8] = (uint8)(DoIP_EntityConfig.LogicalAddress >> 8);
+    Header[9] = (uint8)DoIP_EntityConfig.LogicalAddress;
+    Header[10] = (uint8)(Conn->TesterAddress >> 8);
+    Header[11] = (uint8)Conn->TesterAddress;
+    Conn->TxRemaining = PduInfoPtr->SduLength;
+    if (Conn->TxRemaining == 0u) {
+        Conn->DiagPending = FALSE;
+        PduR_DoIPTxConfirmation(TxPduId, E_OK);
+    }
+    DoIP_TcpPullResponse(TxPduId);
+    return E_OK;
+}
+
+static FUNC(uint8, DOIP_CODE) DoIP_TcpGenericNack(uint16 ConnIdx, uint8 Code, boolean Close) {
+    (void)DoIP_TcpQueue(ConnIdx, DOIP_PT_GENERIC_NACK, &Code, 1u);
+    DoIP_TcpFlush(ConnIdx);
+    if (Close == TRUE) {
+        DoIP_TcpClose(ConnIdx);
+        return DOIP_RX_CLOSED;
+    }
+    return DOIP_RX_DONE;
+}
+
+static FUNC(uint8, DOIP_CODE) DoIP_TcpDiagAck(uint16 ConnIdx, uint16 PayloadType, uint8 Code, boolean Close) {
+    // Diagnostic message ACK or NACK: entity as source, tester as target
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    uint8 Payload[5];
+
+    Payload[0] = (uint8)(DoIP_EntityConfig.LogicalAddress >> 8);
+    Payload[1] = (uint8)DoIP_EntityConfig.LogicalAddress;
+    Payload[2] = (uint8)(Conn->TesterAddress >> 8);
+    Payload[3] = (uint8)Conn->TesterAddress;
+    Payload[4] = Code;
+    if (DoIP_TcpQueue(ConnIdx, PayloadType, Payload, sizeof(Payload)) != E_OK) {
+        Close = TRUE;
+    }
+    DoIP_TcpFlush(ConnIdx);
+    if (Close == TRUE) {
+        DoIP_TcpClose(ConnIdx);
+        return DOIP_RX_CLOSED;
+    }
+    return DOIP_RX_DONE;
+}
+
+static FUNC(uint8, DOIP_CODE) DoIP_TcpRoutingActivation(uint16 ConnIdx, P2CONST(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Payload, uint32 PayloadLength) {
+    // Only default (0x00) and WWH-OBD (0x01) activation; one tester address per connection
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    uint16 TesterAddress;
+    uint8 Code;
+    uint8 Response[9];
+
+    if ((PayloadLength != 7u) && (PayloadLength != 11u)) {
+        return DoIP_TcpGenericNack(ConnIdx, DOIP_HDR_NACK_INVALID_LENGTH, TRUE);
+    }
+    TesterAddress = (uint16)(((uint16)Payload[0] << 8) | Payload[1]);
+    if (Payload[2] > 0x01u) {
+        Code = DOIP_RA_UNSUPPORTED_TYPE;
+    } else if ((TesterAddress < DOIP_TESTER_ADDRESS_MIN) || (TesterAddress > DOIP_TESTER_ADDRESS_MAX)) {
+        Code = DOIP_RA_UNKNOWN_SOURCE_ADDRESS;
+    } else if ((Conn->State == DOIP_CONN_ROUTED) && (Conn->TesterAddress != TesterAddress)) {
+        Code = DOIP_RA_SOURCE_ADDRESS_MISMATCH;
+    } else if ((DoIP_TesterConnection[TesterAddress - DOIP_TESTER_ADDRESS_MIN] != DOIP_NO_CONNECTION) &&
+               (DoIP_TesterConnection[TesterAddress - DOIP_TESTER_ADDRESS_MIN] != ConnIdx)) {
+        Code = DOIP_RA_SOURCE_ADDRESS_REGISTERED;
+    } else {
+        Code = DOIP_RA_SUCCESS;
+        Conn->State = DOIP_CONN_ROUTED;
+        Conn->TesterAddress = TesterAddress;
+        DoIP_TesterConnection[TesterAddress - DOIP_TESTER_ADDRESS_MIN] = ConnIdx;
+    }
+
+    Response[0] = Payload[0];
+    Response[1] = Payload[1];
+    Response[2] = (uint8)(DoIP_EntityConfig.LogicalAddress >> 8);
+    Response[3] = (uint8)DoIP_EntityConfig.LogicalAddress;
+    Response[4] = Code;
+    (void)memset(&Response[5], 0, 4u);
+    (void)DoIP_TcpQueue(ConnIdx, DOIP_PT_ROUTING_ACTIVATION_RESPONSE, Response, sizeof(Response));
+    DoIP_TcpFlush(ConnIdx);
+    if (Code != DOIP_RA_SUCCESS) {
+        DoIP_TcpClose(ConnIdx);
+        return DOIP_RX_CLOSED;
+    }
+    return DOIP_RX_DONE;
+}
+
+static FUNC(uint8, DOIP_CODE) DoIP_TcpDiagMessage(uint16 ConnIdx, P2CONST(uint8, AUTOMATIC, DOIP_VAR_NOINIT) Payload, uint32 PayloadLength) {
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    uint16 SourceAddress;
+    uint16 TargetAddress;
+    PduInfoType PduInfo;
+    PduLengthType BufferSize;
+    BufReq_ReturnType Result;
+
+    if (PayloadLength < 5u) {
+        return DoIP_TcpGenericNack(ConnIdx, DOIP_HDR_NACK_INVALID_LENGTH, TRUE);
+    }
+    SourceAddress = (uint16)(((uint16)Payload[0] << 8) | Payload[1]);
+    TargetAddress = (uint16)(((uint16)Payload[2] << 8) | Payload[3]);
+    if ((Conn->State != DOIP_CONN_ROUTED) || (SourceAddress != Conn->TesterAddress)) {
+        return DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_NACK, DOIP_DIAG_NACK_INVALID_SA, TRUE);
+    }
+    if ((TargetAddress != DoIP_EntityConfig.LogicalAddress) && (TargetAddress != DOIP_FUNCTIONAL_ADDRESS)) {
+        return DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_NACK, DOIP_DIAG_NACK_UNKNOWN_TA, FALSE);
+    }
+
+    PduInfo.SduDataPtr = (uint8*)&Payload[4];
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = (PduLengthType)(PayloadLength - 4u);
+    Result = PduR_DoIPStartOfReception(ConnIdx, &PduInfo, PduInfo.SduLength, &BufferSize);
+    if (Result == BUFREQ_E_BUSY) {
+        return DOIP_RX_HELD;     // DCM serves another request
+    }
+    if (Result == BUFREQ_E_OVFL) {
+        return DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_NACK, DOIP_DIAG_NACK_MESSAGE_TOO_LARGE, FALSE);
+    }
+    if (Result != BUFREQ_OK) {
+        return DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_NACK, DOIP_DIAG_NACK_TARGET_UNREACHABLE, FALSE);
+    }
+    if ((BufferSize < PduInfo.SduLength) || (PduR_DoIPCopyRxData(ConnIdx, &PduInfo, &BufferSize) != BUFREQ_OK)) {
+        PduR_DoIPRxIndication(ConnIdx, E_NOT_OK);
+        return DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_NACK, DOIP_DIAG_NACK_OUT_OF_MEMORY, FALSE);
+    }
+    // ACK before the indication: DCM may answer synchronously
+    Conn->DiagPending = TRUE;
+    if (DoIP_TcpDiagAck(ConnIdx, DOIP_PT_DIAG_ACK, DOIP_DIAG_ACK, FALSE) == DOIP_RX_CLOSED) {
+        PduR_DoIPRxIndication(ConnIdx, E_NOT_OK);
+        return DOIP_RX_CLOSED;
+    }
+    PduR_DoIPRxIndication(ConnIdx, E_OK);
+    return DOIP_RX_DONE;
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpProcess(uint16 ConnIdx) {
+    // Handle every complete message in the Rx buffer, in order, until one is held
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    uint32 Pos = 0u;
+    uint16 PayloadType;
+    uint32 PayloadLength;
+    uint8 Result = DOIP_RX_DONE;
+
+    while (Result == DOIP_RX_DONE) {
+        if (Conn->RxDiscard > 0u) {
+            uint32 Skip = ((Conn->RxLength - Pos) < Conn->RxDiscard) ? (Conn->RxLength - Pos) : Conn->RxDiscard;
+            Pos += Skip;
+            Conn->RxDiscard -= Skip;
+            if (Conn->RxDiscard > 0u) {
+                break;
+            }
+        }
+        if ((Conn->RxLength - Pos) < DOIP_HEADER_LENGTH) {
+            break;
+        }
+        if (DoIP_ReadHeader(&Conn->RxBuffer[Pos], &PayloadType, &PayloadLength) == FALSE) {
+            (void)DoIP_TcpGenericNack(ConnIdx, DOIP_HDR_NACK_INCORRECT_PATTERN, TRUE);
+            return;
+        }
+        if (PayloadLength > DOIP_MAX_PAYLOAD_LENGTH) {
+            // Rejected, the tester may go on after it
+            Result = DoIP_TcpGenericNack(ConnIdx, DOIP_HDR_NACK_MESSAGE_TOO_LARGE, FALSE);
+            Pos += DOIP_HEADER_LENGTH;
+            Conn->RxDiscard = PayloadLength;
+            continue;
+        }
+        if ((Conn->RxLength - Pos) < (DOIP_HEADER_LENGTH + PayloadLength)) {
+            break;
+        }
+
+        switch (PayloadType) {
+            case DOIP_PT_ROUTING_ACTIVATION_REQUEST:
+                Result = DoIP_TcpRoutingActivation(ConnIdx, &Conn->RxBuffer[Pos + DOIP_HEADER_LENGTH], PayloadLength);
+                break;
+            case DOIP_PT_DIAG_MESSAGE:
+                Result = DoIP_TcpDiagMessage(ConnIdx, &Conn->RxBuffer[Pos + DOIP_HEADER_LENGTH], PayloadLength);
+                break;
+            case DOIP_PT_ALIVE_CHECK_RESPONSE:
+                break;
+            default:
+                Result = DoIP_TcpGenericNack(ConnIdx, DOIP_HDR_NACK_UNKNOWN_PAYLOAD_TYPE, FALSE);
+                break;
+        }
+        if (Result == DOIP_RX_DONE) {
+            Pos += DOIP_HEADER_LENGTH + PayloadLength;
+        }
+    }
+    if (Result == DOIP_RX_CLOSED) {
+        return;
+    }
+
+    if (Pos > 0u) {
+        (void)memmove(Conn->RxBuffer, &Conn->RxBuffer[Pos], Conn->RxLength - Pos);
+        Conn->RxLength -= Pos;
+    }
+    Conn->Held = (Result == DOIP_RX_HELD) ? TRUE : FALSE;
+    if ((Conn->Held == TRUE) && (Conn->InHeldQueue == FALSE)) {
+        DoIP_HeldQueue[(DoIP_HeldHead + DoIP_HeldCount) % DOIP_MAX_TESTER_CONNECTIONS] = ConnIdx;
+        DoIP_HeldCount++;
+        Conn->InHeldQueue = TRUE;
+    }
+    DoIP_TcpUpdateEvents(ConnIdx);
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpReceive(uint16 ConnIdx) {
+    // One recv per readiness event keeps the connections fair to each other
+    P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+    ssize_t Received = recv(Conn->Socket, &Conn->RxBuffer[Conn->RxLength], DOIP_RX_BUFFER_SIZE - Conn->RxLength, 0);
+
+    if ((Received == 0) || ((Received < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) {
+        DoIP_TcpClose(ConnIdx);
+        return;
+    }
+    if (Received > 0) {
+        Conn->RxLength += (uint32)Received;
+        Conn->LastActivityMs = DoIP_NowMs();
+        DoIP_TcpProcess(ConnIdx);
+    }
+}
+
+static FUNC(void, DOIP_CODE) DoIP_TcpAccept(void) {
+    struct epoll_event Event;
+    sint32 Socket;
+    sint32 One = 1;
+
+    for (;;) {
+        Socket = accept4(DoIP_ListenSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (Socket < 0) {
+            return;
+        }
+        if (DoIP_FreeCount == 0u) {
+            (void)close(Socket);    // All tester slots in use
+            continue;
+        }
+        DoIP_FreeCount--;
+        {
+            uint16 ConnIdx = DoIP_FreeStack[DoIP_FreeCount];
+            P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+
+            (void)setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &One, sizeof(One));
+            Conn->Socket = Socket;
+            Conn->State = DOIP_CONN_OPEN;
+            Conn->Held = FALSE;
+            Conn->DiagPending = FALSE;
+            Conn->LastActivityMs = DoIP_NowMs();
+            Conn->RxLength = 0u;
+            Conn->RxDiscard = 0u;
+            Conn->TxStart = 0u;
+            Conn->TxEnd = 0u;
+            Conn->TxRemaining = 0u;
+            Conn->Generation++;
+            Conn->EventMask = EPOLLIN;
+            Event.events = EPOLLIN;
+            Event.data.u64 = ((uint64)Conn->Generation << 32) | ConnIdx;
+            (void)epoll_ctl(DoIP_EpollFd, EPOLL_CTL_ADD, Socket, &Event);
+        }
+    }
+}
+
+static FUNC(void, DOIP_CODE) DoIP_RetryHeld(void) {
+    // Oldest held request first; stop as soon as DCM is still busy, as it is for every other held tester
+    while (DoIP_HeldCount > 0u) {
+        uint16 ConnIdx = DoIP_HeldQueue[DoIP_HeldHead];
+        P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+
+        if (Conn->Held == TRUE) {
+            DoIP_TcpProcess(ConnIdx);
+            if (Conn->Held == TRUE) {
+                if (DoIP_HeldPolls < DOIP_HELD_POLL_LIMIT) {
+                    DoIP_HeldPolls++;
+                }
+                return;
+            }
+            DoIP_HeldPolls = 0u;
+        }
+        Conn->InHeldQueue = FALSE;
+        DoIP_HeldHead = (uint16)((DoIP_HeldHead + 1u) % DOIP_MAX_TESTER_CONNECTIONS);
+        DoIP_HeldCount--;
+    }
+    DoIP_HeldPolls = 0u;
+}
+
+static FUNC(void, DOIP_CODE) DoIP_SweepInactive(uint32 NowMs) {
+    uint16 ConnIdx;
+
+    for (ConnIdx = 0u; ConnIdx < DOIP_MAX_TESTER_CONNECTIONS; ConnIdx++) {
+        P2VAR(DoIP_ConnectionType, AUTOMATIC, DOIP_VAR_NOINIT) Conn = &DoIP_Connection[ConnIdx];
+        uint32 Idle = NowMs - Conn->LastActivityMs;
+
+        if (((Conn->State == DOIP_CONN_OPEN) && (Idle > DOIP_INITIAL_INACTIVITY_MS)) ||
+            ((Conn->State == DOIP_CONN_ROUTED) && (Idle > DOIP_GENERAL_INACTIVITY_MS) && (Conn->DiagPending == FALSE))) {
+            DoIP_TcpClose(ConnIdx);
+        }
+    }
+}
+
+static FUNC(void, DOIP_CODE) DoIP_CloseSockets(void) {
+    if (DoIP_UdpSocket >= 0) {
+        (void)close(DoIP_UdpSocket);
+        DoIP_UdpSocket = -1;
+    }
+    if (DoIP_ListenSocket >= 0) {
+        (void)close(DoIP_ListenSocket);
+        DoIP_ListenSocket = -1;
+    }
+    if (DoIP_EpollFd >= 0) {
+        (void)close(DoIP_EpollFd);
+        DoIP_EpollFd = -1;
+    }
+}
+
+FUNC(Std_ReturnType, DOIP_CODE) DoIP_Init(void) {
+    struct sockaddr_in Addr;
+    struct epoll_event Event;
+    sint32 One = 1;
+    uint16 i;
+
+    for (i = 0u; i < DOIP_MAX_TESTER_CONNECTIONS; i++) {
+        DoIP_Connection[i].State = DOIP_CONN_FREE;
+        DoIP_Connection[i].InHeldQueue = FALSE;
+        DoIP_Connection[i].Generation = 0u;
+        DoIP_FreeStack[i] = (uint16)(DOIP_MAX_TESTER_CONNECTIONS - 1u - i);
+    }
+    DoIP_FreeCount = DOIP_MAX_TESTER_CONNECTIONS;
+    for (i = 0u; i <= (DOIP_TESTER_ADDRESS_MAX - DOIP_TESTER_ADDRESS_MIN); i++) {
+        DoIP_TesterConnection[i] = DOIP_NO_CONNECTION;
+    }
+    DoIP_HeldHead = 0u;
+    DoIP_HeldCount = 0u;
+    DoIP_HeldPolls = 0u;
+
+    (void)memset(&Addr, 0, sizeof(Addr));
+    Addr.sin_family = AF_INET;
+    Addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    Addr.sin_port = htons(DOIP_PORT);
+
+    DoIP_EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    DoIP_ListenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    DoIP_UdpSocket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if ((DoIP_EpollFd < 0) || (DoIP_ListenSocket < 0) || (DoIP_UdpSocket < 0)) {
+        DoIP_CloseSockets();
+        return E_NOT_OK;
+    }
+    (void)setsockopt(DoIP_ListenSocket, SOL_SOCKET, SO_REUSEADDR, &One, sizeof(One));
+    (void)setsockopt(DoIP_UdpSocket, SOL_SOCKET, SO_REUSEADDR, &One, sizeof(One));
+    (void)setsockopt(DoIP_UdpSocket, SOL_SOCKET, SO_BROADCAST, &One, sizeof(One));
+    if ((bind(DoIP_ListenSocket, (const struct sockaddr*)&Addr, sizeof(Addr)) != 0) ||
+        (listen(DoIP_ListenSocket, SOMAXCONN) != 0) ||
+        (bind(DoIP_UdpSocket, (const struct sockaddr*)&Addr, sizeof(Addr)) != 0)) {
+        DoIP_CloseSockets();    // Port 13400 taken, typically by another entity on this host
+        return E_NOT_OK;
+    }
+
+    Event.events = EPOLLIN;
+    Event.data.u64 = DOIP_EPOLL_LISTEN;
+    if (epoll_ctl(DoIP_EpollFd, EPOLL_CTL_ADD, DoIP_ListenSocket, &Event) != 0) {
+        DoIP_CloseSockets();
+        return E_NOT_OK;
+    }
+    Event.data.u64 = DOIP_EPOLL_UDP;
+    if (epoll_ctl(DoIP_EpollFd, EPOLL_CTL_ADD, DoIP_UdpSocket, &Event) != 0) {
+        DoIP_CloseSockets();
+        return E_NOT_OK;
+    }
+
+    // First announcement right away, the others from DoIP_MainFunction
+    DoIP_AnnounceCount = 0u;
+    DoIP_NextAnnounceMs = DoIP_NowMs();
+    DoIP_NextSweepMs = DoIP_NextAnnounceMs + DOIP_INACTIVITY_SWEEP_MS;
+    return E_OK;
+}
+
+FUNC(void, DOIP_CODE) DoIP_MainFunction(void) {
+    struct epoll_event Events[DOIP_EPOLL_BATCH];
+    uint32 NowMs = DoIP_NowMs();
+    sint32 Count;
+    sint32 i;
+
+    if ((DoIP_AnnounceCount < DOIP_ANNOUNCE_NUM) && ((sint32)(NowMs - DoIP_NextAnnounceMs) >= 0)) {
+        struct sockaddr_in Broadcast;
+
+        (void)memset(&Broadcast, 0, sizeof(Broadcast));
+        Broadcast.sin_family = AF_INET;
+        Broadcast.sin_addr.s_addr = htonl(INADDR_BROADCAST);
+        Broadcast.sin_port = htons(DOIP_PORT);
+        DoIP_UdpSendIdentification(&Broadcast);
+        DoIP_AnnounceCount++;
+        DoIP_NextAnnounceMs = NowMs + DOIP_ANNOUNCE_INTERVAL_MS;
+    }
+    if ((sint32)(NowMs - DoIP_NextSweepMs) >= 0) {
+        DoIP_SweepInactive(NowMs);
+        DoIP_NextSweepMs = NowMs + DOIP_INACTIVITY_SWEEP_MS;
+    }
+
+    // DCM usually finishes within its next main function, so held testers are polled without waiting
+    // for a few calls; a DCM that stays busy (a response stalled on its socket, a request over another
+    // transport) is then only retried once per wait, which EPOLLOUT of that socket also ends
+    DoIP_RetryHeld();
+    Count = epoll_wait(DoIP_EpollFd, Events, DOIP_EPOLL_BATCH,
+                       ((DoIP_HeldCount > 0u) && (DoIP_HeldPolls < DOIP_HELD_POLL_LIMIT)) ? 0 : DOIP_EPOLL_TIMEOUT_MS);
+    for (i = 0; i < Count; i++) {
+        uint32 Source = (uint32)Events[i].data.u64;
+
+        if (Source == DOIP_EPOLL_LISTEN) {
+            DoIP_TcpAccept();
+        } else if (Source == DOIP_EPOLL_UDP) {
+            DoIP_UdpReceive();
+        } else if ((DoIP_Connection[Source].State != DOIP_CONN_FREE) &&
+                   (DoIP_Connection[Source].Generation == (uint32)(Events[i].data.u64 >> 32))) {
+            // Skipped if an earlier event of this batch closed the slot (and an accept reused it)
+            if ((Events[i].events & (EPOLLERR | EPOLLHUP)) != 0u) {
+                DoIP_TcpClose((uint16)Source);
+                continue;
+            }
+            if ((Events[i].events & EPOLLOUT) != 0u) {
+                DoIP_TcpPullResponse((uint16)Source);
+            }
+            if (((Events[i].events & EPOLLIN) != 0u) && (DoIP_Connection[Source].State != DOIP_CONN_FREE)) {
+                DoIP_TcpReceive((uint16)Source);
+            }
+        }
+    }
+}
+
+/* COMMUNICATION STACK - SHARED PDU BUFFER POOL */
+// File: PduBuf.c
+/* Fixed-size, reference-counted payload buffers shared by Com, PduR, CanIf
+ * and Can. A layer that must keep a payload alive past its call takes a
+ * reference instead of a copy; the last release returns it to its pool.
+ * Pointers that do not belong to a pool (e.g. stack buffers) are ignored. */
+#include <stdatomic.h>
+
+typedef struct {
+    P2VAR(uint8, AUTOMATIC, PDUBUF_VAR_NOINIT) Storage;        // NumBuffers * BufferSize bytes
+    P2VAR(atomic_uint_least8_t, AUTOMATIC, PDUBUF_VAR_NOINIT) RefCount;
+    P2VAR(uint16, AUTOMATIC, PDUBUF_VAR_NOINIT) FreeStack;
+    uint16 FreeCount;
+    uint16 NumBuffers;
+    uint16 BufferSize;
+} PduBuf_PoolType;
+
+// Size classes: classic CAN, CAN-FD, Ethernet
+static VAR(uint8, PDUBUF_VAR_NOINIT) PduBuf_Storage8[PDUBUF_NUM_OF_8_BYTE_BUFFERS * 8u];
+static VAR(uint8, PDUBUF_VAR_NOINIT) PduBuf_Storage64[PDUBUF_NUM_OF_64_BYTE_BUFFERS * 64u];
+static VAR(uint8, PDUBUF_VAR_NOINIT) PduBuf_Storage1536[PDUBUF_NUM_OF_1536_BYTE_BUFFERS * 1536u];
+static VAR(atomic_uint_least8_t, PDUBUF_VAR_NOINIT) PduBuf_RefCount8[PDUBUF_NUM_OF_8_BYTE_BUFFERS];
+static VAR(atomic_uint_least8_t, PDUBUF_VAR_NOINIT) PduBuf_RefCount64[PDUBUF_NUM_OF_64_BYTE_BUFFERS];
+static VAR(atomic_uint_least8_t, PDUBUF_VAR_NOINIT) PduBuf_RefCount1536[PDUBUF_NUM_OF_1536_BYTE_BUFFERS];
+static VAR(uint16, PDUBUF_VAR_NOINIT) PduBuf_FreeStack8[PDUBUF_NUM_OF_8_BYTE_BUFFERS];
+static VAR(uint16, PDUBUF_VAR_NOINIT) PduBuf_FreeStack64[PDUBUF_NUM_OF_64_BYTE_BUFFERS];
+static VAR(uint16, PDUBUF_VAR_NOINIT) PduBuf_FreeStack1536[PDUBUF_NUM_OF_1536_BYTE_BUFFERS];
+
+static VAR(PduBuf_PoolType, PDUBUF_VAR) PduBuf_Pool[PDUBUF_NUM_OF_POOLS] = {
+    { PduBuf_Storage8,    PduBuf_RefCount8,    PduBuf_FreeStack8,    0u, PDUBUF_NUM_OF_8_BYTE_BUFFERS,    8u },
+    { PduBuf_Storage64,   PduBuf_RefCount64,   PduBuf_FreeStack64,   0u, PDUBUF_NUM_OF_64_BYTE_BUFFERS,   64u },
+    { PduBuf_Storage1536, PduBuf_RefCount1536, PduBuf_FreeStack1536, 0u, PDUBUF_NUM_OF_1536_BYTE_BUFFERS, 1536u },
+};
+
+FUNC(void, PDUBUF_CODE) PduBuf_Init(void) {
+    uint8 p;
+    uint16 i;
+
+    for (p = 0u; p < PDUBUF_NUM_OF_POOLS; p++) {
+        P2VAR(PduBuf_PoolType, AUTOMATIC, PDUBUF_VAR) Pool = &PduBuf_Pool[p];
+        for (i = 0u; i < Pool->NumBuffers; i++) {
+            atomic_init(&Pool->RefCount[i], 0u);
+            Pool->FreeStack[i] = i;
+        }
+        Pool->FreeCount = Pool->NumBuffers;
+    }
+}
+
+static FUNC(boolean, PDUBUF_CODE) PduBuf_Locate(P2CONST(uint8, AUTOMATIC, PDUBUF_APPL_DATA) SduDataPtr,
+                                              P2VAR(PduBuf_PoolType*, AUTOMATIC, AUTOMATIC) PoolPtr,
+                                              P2VAR(uint16, AUTOMATIC, AUTOMATIC) IndexPtr) {
+    // Map a payload pointer back to its pool slot by address range
+    uint8 p;
+
+    for (p = 0u; p < PDUBUF_NUM_OF_POOLS; p++) {
+        P2VAR(PduBuf_PoolType, AUTOMATIC, PDUBUF_VAR) Pool = &PduBuf_Pool[p];
+        uint32 PoolBytes = (uint32)Pool->NumBuffers * Pool->BufferSize;
+
+        if ((SduDataPtr >= Pool->Storage) && (SduDataPtr < &Pool->Storage[PoolBytes])) {
+            *PoolPtr = Pool;
+            *IndexPtr = (uint16)((uint32)(SduDataPtr - Pool->Storage) / Pool->BufferSize);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+FUNC_P2VAR(uint8, PDUBUF_VAR_NOINIT, PDUBUF_CODE) PduBuf_Alloc(PduLengthType Length) {
+    // Smallest size class with a free buffer; the caller owns the first reference
+    uint8 p;
+
+    for (p = 0u; p < PDUBUF_NUM_OF_POOLS; p++) {
+        P2VAR(PduBuf_PoolType, AUTOMATIC, PDUBUF_VAR) Pool = &PduBuf_Pool[p];
+        uint16 Index = 0xFFFFu;
+
+        if (Length > Pool->BufferSize) {
+            continue;
+        }
+
+        SchM_Enter_PduBuf_PDUBUF_EXCLUSIVE_AREA_0();
+        if (Pool->FreeCount > 0u) {
+            Pool->FreeCount--;
+            Index = Pool->FreeStack[Pool->FreeCount];
+        }
+        SchM_Exit_PduBuf_PDUBUF_EXCLUSIVE_AREA_0();
+
+        if (Index != 0xFFFFu) {
+            atomic_store_explicit(&Pool->RefCount[Index], 1u, memory_order_relaxed);
+            return &Pool->Storage[(uint32)Index * Pool->BufferSize];
+        }
+    }
+    return NULL_PTR;
+}
+
+FUNC(boolean, PDUBUF_CODE) PduBuf_Retain(P2CONST(uint8, AUTOMATIC, PDUBUF_APPL_DATA) SduDataPtr) {
+    // Returns FALSE for non-pooled payloads, which the caller must copy if it keeps them
+    PduBuf_PoolType* Pool;
+    uint16 Index;
+
+    if (PduBuf_Locate(SduDataPtr, &Pool, &Index) == TRUE) {
+        (void)atomic_fetch_add_explicit(&Pool->RefCount[Index], 1u, memory_order_relaxed);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+FUNC(void, PDUBUF_CODE) PduBuf_Release(P2CONST(uint8, AUTOMATIC, PDUBUF_APPL_DATA) SduDataPtr) {
+    PduBuf_PoolType* Pool;
+    uint16 Index;
+
+    if (PduBuf_Locate(SduDataPtr, &Pool, &Index) == TRUE) {
+        // Last reference returns the buffer to its pool
+        if (atomic_fetch_sub_explicit(&Pool->RefCount[Index], 1u, memory_order_acq_rel) == 1u) {
+            SchM_Enter_PduBuf_PDUBUF_EXCLUSIVE_AREA_0();
+            Pool->FreeStack[Pool->FreeCount] = Index;
+            Pool->FreeCount++;
+            SchM_Exit_PduBuf_PDUBUF_EXCLUSIVE_AREA_0();
+        }
+    }
+}
+
+FUNC(boolean, PDUBUF_CODE) PduBuf_IsShared(P2CONST(uint8, AUTOMATIC, PDUBUF_APPL_DATA) SduDataPtr) {
+    // TRUE while a lower layer still holds the payload (e.g. frame pending in a mailbox)
+    PduBuf_PoolType* Pool;
+    uint16 Index;
+
+    if (PduBuf_Locate(SduDataPtr, &Pool, &Index) == TRUE) {
+        return (atomic_load_explicit(&Pool->RefCount[Index], memory_order_acquire) > 1u) ? TRUE : FALSE;
+    }
+    return FALSE;
+}
+
+/* DIAGNOSTIC STACK - DEM */
+// File: Dem.c
+/* Event memory as structure-of-arrays: the UDS status byte, debounce counter
+ * and occurrence counter of each event live in separate dense arrays, so a
+ * status query touches one byte and 5000 events fit their status in 5 KB.
+ * Bulk operations (count/list by status mask, clear, operation-cycle
+ * restart) process eight status bytes per 64-bit word (SWAR); the status
+ * array is padded to whole words and the padding bytes stay 0. */
+#define DEM_UDS_STATUS_TF           0x01u   // testFailed
+#define DEM_UDS_STATUS_TFTOC        0x02u   // testFailedThisOperationCycle
+#define DEM_UDS_STATUS_PDTC         0x04u   // pendingDTC
+#define DEM_UDS_STATUS_CDTC         0x08u   // confirmedDTC
+#define DEM_UDS_STATUS_TNCSLC       0x10u   // testNotCompletedSinceLastClear
+#define DEM_UDS_STATUS_TFSLC        0x20u   // testFailedSinceLastClear
+#define DEM_UDS_STATUS_TNCTOC       0x40u   // testNotCompletedThisOperationCycle
+#define DEM_UDS_STATUS_WIR          0x80u   // warningIndicatorRequested
+
+#define DEM_UDS_STATUS_INITIAL      (DEM_UDS_STATUS_TNCSLC | DEM_UDS_STATUS_TNCTOC)
+
+#define DEM_STATUS_WORDS            ((DEM_NUM_OF_EVENTS + 7u) / 8u)
+#define DEM_STATUS_FULL_WORDS       (DEM_NUM_OF_EVENTS / 8u)
+#define DEM_SWAR_ONES               0x0101010101010101ull
+#define DEM_SWAR_LOW7               0x7F7F7F7F7F7F7F7Full
+#define DEM_SWAR_HIGH               0x8080808080808080ull
+
+typedef union {
+    uint64 Word[DEM_STATUS_WORDS];
+    uint8 Byte[DEM_STATUS_WORDS * 8u];
+} Dem_StatusArrayType;
+
+static VAR(Dem_StatusArrayType, DEM_VAR_NOINIT) Dem_EventStatus;
+static VAR(sint16, DEM_VAR_NOINIT) Dem_DebounceCounter[DEM_NUM_OF_EVENTS];     // Counter value; time based: direction +1 failing, -1 passing
+static VAR(uint8, DEM_VAR_NOINIT) Dem_OccurrenceCounter[DEM_NUM_OF_EVENTS];
+
+/* Debouncing is done by the DEM, per event with the class
+ * Dem_DebounceClassConfig[Dem_EventConfig[EventId].DebounceClassRef]:
+ * - counter based: PREFAILED first lifts a counter below JumpUpValue to it
+ *   (if JumpUp) and then adds IncrementStepSize, PREPASSED mirrors this with
+ *   JumpDown/DecrementStepSize; reaching FailedThreshold (up to 127) or
+ *   PassedThreshold (down to -128) qualifies the event FAILED or PASSED
+ * - time based: PREFAILED/PREPASSED start a FailedTimeMs/PassedTimeMs timer
+ *   (0..65535 ms) unless one already runs in that direction; it qualifies
+ *   the event when it expires
+ * - monitor internal: the monitor debounces itself, only FAILED/PASSED
+ * A report only stores the latest result of its event and marks the event
+ * in a pending bitset; Dem_MainFunction (every DEM_TASK_TIME ms) debounces
+ * the pending events and ticks the running timers 32 events at a time, and
+ * is the only writer of the debounce state. Several reports of one event
+ * within one main function period count once (the latest), so counter
+ * thresholds are in main function periods for monitors faster than that.
+ * FAILED/PASSED are qualified by the report itself, so the status byte is
+ * current at once; the main function then moves the debounce state to the
+ * matching end and re-applies the result, which keeps the status of the
+ * latest report if it raced with a debounce qualification. */
+#include <stdatomic.h>
+
+#if defined(__TASKING__)
+#define DEM_CLZ32(x)                    ((uint8)__clz(x))
+#else
+#define DEM_CLZ32(x)                    ((uint8)__builtin_clz(x))
+#endif
+
+#define DEM_DEBOUNCE_COUNTER_BASED      0u
+#define DEM_DEBOUNCE_TIME_BASED         1u
+#define DEM_DEBOUNCE_MONITOR_INTERNAL   2u
+
+#define DEM_DEBOUNCE_WORDS              ((DEM_NUM_OF_EVENTS + 31u) / 32u)
+#define DEM_DEBOUNCE_NO_REPORT          0xFFu
+
+typedef struct {
+    Dem_EventIdType EventId;
+    Dem_EventStatusType EventStatus;
+} Dem_EventStatusReportType;
+
+static VAR(atomic_uint_least8_t, DEM_VAR_NOINIT) Dem_DebounceReport[DEM_NUM_OF_EVENTS];
+static VAR(atomic_uint_least32_t, DEM_VAR_NOINIT) Dem_DebouncePending[DEM_DEBOUNCE_WORDS];
+static VAR(atomic_bool, DEM_VAR_NOINIT) Dem_DebounceResetRequest;
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DebounceTimerRunning[DEM_DEBOUNCE_WORDS];
+static VAR(uint16, DEM_VAR_NOINIT) Dem_DebounceTimer[DEM_NUM_OF_EVENTS];   // Remaining ms
+
+/* DTC status change log: every change of an event status byte is appended
+ * to a ring (EventId, old and new status packed into one 32-bit word) that
+ * the DCM and FiM drain from their own main functions through
+ * Dem_GetDTCStatusChanges, each with its own read position.
+ * Appending is lock-free and never waits for a reader: a slot is claimed
+ * with an atomic increment and published with a seqlock-style stamp
+ * (2 * Seq + 1 while written, 2 * Seq + 2 when valid). A reader that was
+ * lapped, and every Dem_ClearAllEvents/Dem_RestartOperationCycle (logged
+ * as one DEM_EVENT_ID_ALL_EVENTS entry), makes that reader resynchronize:
+ * it gets a DEM_EVENT_ID_ALL_EVENTS marker followed by snapshot entries
+ * (OldStatus == NewStatus) of the events matching its snapshot mask. The
+ * changes skipped by a lap are lost, but the state they led to is not: a
+ * consumer that rebuilds its snapshot-mask view from the resync ends up
+ * with the current status, and a change may be seen twice around it. */
+#ifndef DEM_DTCLOG_SIZE
+#define DEM_DTCLOG_SIZE                 1024u   // Entries, power of two
+#endif
+#define DEM_EVENT_ID_ALL_EVENTS         0xFFFFu
+
+#define DEM_DTCLOG_CONSUMER_DCM         0u
+#define DEM_DTCLOG_CONSUMER_FIM         1u
+#define DEM_DTCLOG_NUM_CONSUMERS        2u
+
+#define DEM_DTCLOG_NO_RESYNC            0xFFFFFFFFu
+#define DEM_DTCLOG_RESYNC_MARKER        0xFFFFFFFEu
+
+typedef struct {
+    Dem_EventIdType EventId;
+    uint8 OldStatus;
+    uint8 NewStatus;
+} Dem_DTCStatusChangeType;
+
+typedef struct {
+    atomic_uint_least32_t Stamp;
+    atomic_uint_least32_t Data;
+} Dem_DtcLogSlotType;
+
+typedef struct {
+    boolean ReportToDcmOnly;    // Only events with Dem_EventConfig[].ReportToDcm
+    uint8 SnapshotMask;         // Resync snapshots events with any of these status bits
+} Dem_DtcLogConsumerType;
+
+static CONST(Dem_DtcLogConsumerType, DEM_CONST) Dem_DtcLogConsumer[DEM_DTCLOG_NUM_CONSUMERS] = {
+    { TRUE,  DEM_UDS_STATUS_TF },   // DCM: mirror of failed DTCs
+    { FALSE, DEM_UDS_STATUS_TF }    // FiM: failed events of all inhibit conditions
+};
+
+static VAR(Dem_DtcLogSlotType, DEM_VAR_NOINIT) Dem_DtcLog[DEM_DTCLOG_SIZE];
+static VAR(atomic_uint_least32_t, DEM_VAR_NOINIT) Dem_DtcLogHead;
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DtcLogReadSeq[DEM_DTCLOG_NUM_CONSUMERS];        // Owned by the consumer's main function
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DtcLogResyncEvent[DEM_DTCLOG_NUM_CONSUMERS];    // Next snapshot EventId, or DEM_DTCLOG_NO_RESYNC/_RESYNC_MARKER
+
+static FUNC(void, DEM_CODE) Dem_DtcLogAppend(Dem_EventIdType EventId, uint8 OldStatus, uint8 NewStatus) {
+    uint32 Seq = atomic_fetch_add_explicit(&Dem_DtcLogHead, 1u, memory_order_relaxed);
+    P2VAR(Dem_DtcLogSlotType, AUTOMATIC, DEM_VAR_NOINIT) Slot = &Dem_DtcLog[Seq % DEM_DTCLOG_SIZE];
+
+    atomic_store_explicit(&Slot->Stamp, (2u * Seq) + 1u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&Slot->Data, ((uint32)EventId << 16) | ((uint32)OldStatus << 8) | NewStatus, memory_order_relaxed);
+    atomic_store_explicit(&Slot->Stamp, (2u * Seq) + 2u, memory_order_release);
+}
+
+/* DTC index for ReadDTCInformation: the events that carry a DTC
+ * (Dem_EventConfig[].Dtc != DEM_NO_DTC, one event per DTC) get a position
+ * in ascending DTC order at Dem_Init. Per status bit, a bitset over the
+ * positions with a one-bit-per-word summary above it is kept in step with
+ * the status bytes, together with the number of DTCs per status byte value.
+ * Counting DTCs by status mask is then a sum over 256 values, and listing
+ * them visits only the summary words and the bitset words that have
+ * matches, i.e. time proportional to the matches rather than to the DTCs. */
+#define DEM_NO_DTC                      0x000000u
+#define DEM_DTC_NO_POSITION             0xFFFFu
+#define DEM_DTC_WORDS                   ((DEM_NUM_OF_EVENTS + 31u) / 32u)
+#define DEM_DTC_SUMMARY_WORDS           ((DEM_DTC_WORDS + 31u) / 32u)
+#ifndef DEM_DTC_STATUS_AVAILABILITY_MASK
+#define DEM_DTC_STATUS_AVAILABILITY_MASK 0xFFu
+#endif
+#define DEM_CTZ32(x)                    ((uint8)(31u - DEM_CLZ32((x) & (0u - (x)))))
+
+typedef struct {
+    uint32 Dtc;
+    uint8 Status;
+} Dem_DTCRecordType;
+
+static VAR(uint16, DEM_VAR_NOINIT) Dem_DtcCount;
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DtcSortedDtc[DEM_NUM_OF_EVENTS];        // By position
+static VAR(Dem_EventIdType, DEM_VAR_NOINIT) Dem_DtcSortedEvent[DEM_NUM_OF_EVENTS];
+static VAR(uint16, DEM_VAR_NOINIT) Dem_DtcPosition[DEM_NUM_OF_EVENTS];         // By EventId
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DtcStatusBits[8][DEM_DTC_WORDS];
+static VAR(uint32, DEM_VAR_NOINIT) Dem_DtcStatusSummary[8][DEM_DTC_SUMMARY_WORDS];
+static VAR(uint16, DEM_VAR_NOINIT) Dem_DtcStatusCount[256];
+
+static FUNC(void, DEM_CODE) Dem_DtcIndexSetBit(uint8 Bit, uint16 Position, boolean Set) {
+    uint16 Word = (uint16)(Position / 32u);
+
+    if (Set == TRUE) {
+        Dem_DtcStatusBits[Bit][Word] |= (uint32)1u << (Position % 32u);
+        Dem_DtcStatusSummary[Bit][Word / 32u] |= (uint32)1u << (Word % 32u);
+    } else {
+        Dem_DtcStatusBits[Bit][Word] &= ~((uint32)1u << (Position % 32u));
+        if (Dem_DtcStatusBits[Bit][Word] == 0u) {
+            Dem_DtcStatusSummary[Bit][Word / 32u] &= ~((uint32)1u << (Word % 32u));
+        }
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DtcIndexUpdate(Dem_EventIdType EventId, uint8 OldStatus, uint8 NewStatus) {
+    // Caller holds DEM_EXCLUSIVE_AREA_0
+    uint16 Position = Dem_DtcPosition[EventId];
+    uint8 Changed = (uint8)(OldStatus ^ NewStatus);
+    uint8 Bit;
+
+    if (Position == DEM_DTC_NO_POSITION) {
+        return;
+    }
+    Dem_DtcStatusCount[OldStatus]--;
+    Dem_DtcStatusCount[NewStatus]++;
+    for (Bit = 0u; Bit < 8u; Bit++) {
+        if ((Changed & (1u << Bit)) != 0u) {
+            Dem_DtcIndexSetBit(Bit, Position, ((NewStatus & (1u << Bit)) != 0u) ? TRUE : FALSE);
+        }
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DtcIndexRebuild(void) {
+    // After the bulk status operations; caller holds DEM_EXCLUSIVE_AREA_0 (or is Dem_Init)
+    uint16 Position;
+    uint8 Bit;
+
+    (void)memset(Dem_DtcStatusBits, 0, sizeof(Dem_DtcStatusBits));
+    (void)memset(Dem_DtcStatusSummary, 0, sizeof(Dem_DtcStatusSummary));
+    (void)memset(Dem_DtcStatusCount, 0, sizeof(Dem_DtcStatusCount));
+    for (Position = 0u; Position < Dem_DtcCount; Position++) {
+        uint8 Status = Dem_EventStatus.Byte[Dem_DtcSortedEvent[Position]];
+
+        Dem_DtcStatusCount[Status]++;
+        for (Bit = 0u; Bit < 8u; Bit++) {
+            if ((Status & (1u << Bit)) != 0u) {
+                Dem_DtcIndexSetBit(Bit, Position, TRUE);
+            }
+        }
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DtcIndexSiftDown(uint16 Root, uint16 Count) {
+    // Heap sort step on (Dem_DtcSortedDtc, Dem_DtcSortedEvent) by DTC
+    while (((2u * Root) + 1u) < Count) {
+        uint16 Child = (uint16)((2u * Root) + 1u);
+        uint32 Dtc;
+        Dem_EventIdType EventId;
+
+        if (((Child + 1u) < Count) && (Dem_DtcSortedDtc[Child + 1u] > Dem_DtcSortedDtc[Child])) {
+            Child++;
+        }
+        if (Dem_DtcSortedDtc[Root] >= Dem_DtcSortedDtc[Child]) {
+            return;
+        }
+        Dtc = Dem_DtcSortedDtc[Root];
+        EventId = Dem_DtcSortedEvent[Root];
+        Dem_DtcSortedDtc[Root] = Dem_DtcSortedDtc[Child];
+        Dem_DtcSortedEvent[Root] = Dem_DtcSortedEvent[Child];
+        Dem_DtcSortedDtc[Child] = Dtc;
+        Dem_DtcSortedEvent[Child] = EventId;
+        Root = Child;
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DtcIndexBuild(void) {
+    // Positions in ascending DTC order, then the status bitsets
+    uint16 EventId;
+    uint16 End;
+
+    Dem_DtcCount = 0u;
+    for (EventId = 0u; EventId < DEM_NUM_OF_EVENTS; EventId++) {
+        Dem_DtcPosition[EventId] = DEM_DTC_NO_POSITION;
+        if (Dem_EventConfig[EventId].Dtc != DEM_NO_DTC) {
+            Dem_DtcSortedDtc[Dem_DtcCount] = Dem_EventConfig[EventId].Dtc;
+            Dem_DtcSortedEvent[Dem_DtcCount] = EventId;
+            Dem_DtcCount++;
+        }
+    }
+    for (End = (uint16)(Dem_DtcCount / 2u); End > 0u; End--) {
+        Dem_DtcIndexSiftDown((uint16)(End - 1u), Dem_DtcCount);
+    }
+    for (End = Dem_DtcCount; End > 1u; End--) {
+        uint32 Dtc = Dem_DtcSortedDtc[0];
+        Dem_EventIdType Event = Dem_DtcSortedEvent[0];
+
+        Dem_DtcSortedDtc[0] = Dem_DtcSortedDtc[End - 1u];
+        Dem_DtcSortedEvent[0] = Dem_DtcSortedEvent[End - 1u];
+        Dem_DtcSortedDtc[End - 1u] = Dtc;
+        Dem_DtcSortedEvent[End - 1u] = Event;
+        Dem_DtcIndexSiftDown(0u, (uint16)(End - 1u));
+    }
+    for (End = 0u; End < Dem_DtcCount; End++) {
+        Dem_DtcPosition[Dem_DtcSortedEvent[End]] = End;
+    }
+    Dem_DtcIndexRebuild();
+}
+
+static inline FUNC(uint64, DEM_CODE) Dem_SwarMatch(uint64 Word, uint8 StatusMask) {
+    // High bit of each byte lane set where (lane & StatusMask) != 0
+    uint64 Masked = Word & (DEM_SWAR_ONES * StatusMask);
+
+    return (((Masked & DEM_SWAR_LOW7) + DEM_SWAR_LOW7) | Masked) & DEM_SWAR_HIGH;
+}
+
+static inline FUNC(uint8, DEM_CODE) Dem_SwarCount(uint64 HighBits) {
+    // Number of lanes flagged by Dem_SwarMatch (byte sum via multiply)
+    return (uint8)(((HighBits >> 7) * DEM_SWAR_ONES) >> 56);
+}
+
+FUNC(void, DEM_CODE) Dem_Init(void) {
+    uint16 EventId;
+    uint16 w;
+
+    (void)memset(&Dem_EventStatus, 0, sizeof(Dem_EventStatus));
+    for (EventId = 0u; EventId < DEM_NUM_OF_EVENTS; EventId++) {
+        Dem_EventStatus.Byte[EventId] = DEM_UDS_STATUS_INITIAL;
+        atomic_init(&Dem_DebounceReport[EventId], DEM_DEBOUNCE_NO_REPORT);
+    }
+    for (w = 0u; w < DEM_DEBOUNCE_WORDS; w++) {
+        atomic_init(&Dem_DebouncePending[w], 0u);
+    }
+    atomic_init(&Dem_DebounceResetRequest, FALSE);
+    for (w = 0u; w < DEM_DTCLOG_SIZE; w++) {
+        atomic_init(&Dem_DtcLog[w].Stamp, 0u);
+        atomic_init(&Dem_DtcLog[w].Data, 0u);
+    }
+    atomic_init(&Dem_DtcLogHead, 0u);
+    for (w = 0u; w < DEM_DTCLOG_NUM_CONSUMERS; w++) {
+        Dem_DtcLogReadSeq[w] = 0u;
+        Dem_DtcLogResyncEvent[w] = DEM_DTCLOG_NO_RESYNC;
+    }
+    (void)memset(Dem_DebounceCounter, 0, sizeof(Dem_DebounceCounter));
+    (void)memset(Dem_DebounceTimerRunning, 0, sizeof(Dem_DebounceTimerRunning));
+    (void)memset(Dem_DebounceTimer, 0, sizeof(Dem_DebounceTimer));
+    (void)memset(Dem_OccurrenceCounter, 0, sizeof(Dem_OccurrenceCounter));
+    Dem_DtcIndexBuild();
+}
+
+static FUNC(uint8, DEM_CODE) Dem_SetQualifiedStatus(Dem_EventIdType EventId, boolean Failed) {
+    // ISO 14229 status-byte transition for a qualified test result; returns
+    // the old byte. Caller holds DEM_EXCLUSIVE_AREA_0.
+    uint8 OldStatus = Dem_EventStatus.Byte[EventId];
+    uint8 NewStatus;
+
+
+    NewStatus = (uint8)(OldStatus & (uint8)~(DEM_UDS_STATUS_TNCSLC | DEM_UDS_STATUS_TNCTOC));
+    if (Failed == TRUE) {
+        NewStatus |= (uint8)(DEM_UDS_STATUS_TF | DEM_UDS_STATUS_TFTOC | DEM_UDS_STATUS_PDTC | DEM_UDS_STATUS_CDTC | DEM_UDS_STATUS_TFSLC);
+        if (((OldStatus & DEM_UDS_STATUS_TF) == 0u) && (Dem_OccurrenceCounter[EventId] < 0xFFu)) {
+            Dem_OccurrenceCounter[EventId]++;
+        }
+    } else {
+        NewStatus &= (uint8)~DEM_UDS_STATUS_TF;
+    }
+    Dem_EventStatus.Byte[EventId] = NewStatus;
+    if (NewStatus != OldStatus) {
+        Dem_DtcIndexUpdate(EventId, OldStatus, NewStatus);
+        Dem_DtcLogAppend(EventId, OldStatus, NewStatus);
+    }
+    return OldStatus;
+}
+
+static FUNC(uint8, DEM_CODE) Dem_ApplyQualifiedStatus(Dem_EventIdType EventId, boolean Failed) {
+    uint8 OldStatus;
+
+    SchM_Enter_Dem_DEM_EXCLUSIVE_AREA_0();
+    OldStatus = Dem_SetQualifiedStatus(EventId, Failed);
+    SchM_Exit_Dem_DEM_EXCLUSIVE_AREA_0();
+    return OldStatus;
+}
+
+static FUNC(boolean, DEM_CODE) Dem_CheckReport(Dem_EventIdType EventId, Dem_EventStatusType EventStatus, P2VAR(uint8, AUTOMATIC, AUTOMATIC) Algorithm) {
+    // Valid event, and PREFAILED/PREPASSED only for events the DEM debounces
+    if (EventId >= DEM_NUM_OF_EVENTS) {
+        return FALSE;
+    }
+    *Algorithm = Dem_DebounceClassConfig[Dem_EventConfig[EventId].DebounceClassRef].Algorithm;
+    if ((EventStatus == DEM_EVENT_STATUS_FAILED) || (EventStatus == DEM_EVENT_STATUS_PASSED)) {
+        return TRUE;
+    }
+    return (((EventStatus == DEM_EVENT_STATUS_PREFAILED) || (EventStatus == DEM_EVENT_STATUS_PREPASSED)) &&
+            (*Algorithm != DEM_DEBOUNCE_MONITOR_INTERNAL)) ? TRUE : FALSE;
+}
+
+static FUNC(Std_ReturnType, DEM_CODE) Dem_ReportEventStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
+    // Common part of Dem_ReportErrorStatus/Dem_SetEventStatus
+    boolean Qualified = ((EventStatus == DEM_EVENT_STATUS_FAILED) || (EventStatus == DEM_EVENT_STATUS_PASSED)) ? TRUE : FALSE;
+    uint8 Algorithm;
+
+    if (Dem_CheckReport(EventId, EventStatus, &Algorithm) == FALSE) {
+        return E_NOT_OK;
+    }
+    if (Qualified == TRUE) {
+        (void)Dem_ApplyQualifiedStatus(EventId, (EventStatus == DEM_EVENT_STATUS_FAILED) ? TRUE : FALSE);
+    }
+    if (Algorithm != DEM_DEBOUNCE_MONITOR_INTERNAL) {
+        atomic_store_explicit(&Dem_DebounceReport[EventId], (uint8)EventStatus, memory_order_relaxed);
+        (void)atomic_fetch_or_explicit(&Dem_DebouncePending[EventId / 32u], (uint32)1u << (EventId % 32u), memory_order_release);
+    }
+    return E_OK;
+}
+
+FUNC(void, DEM_CODE) Dem_ReportErrorStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
+    // Step 18: Diagnostic Event Manager - Error monitoring (BSW monitors)
+    (void)Dem_ReportEventStatus(EventId, EventStatus);
+}
+
+FUNC(Std_ReturnType, DEM_CODE) Dem_SetEventStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
+    // SWC monitors, through the RTE DiagnosticMonitor port
+    return Dem_ReportEventStatus(EventId, EventStatus);
+}
+
+FUNC(Std_ReturnType, DEM_CODE) Dem_SetEventStatusBatch(P2CONST(Dem_EventStatusReportType, AUTOMATIC, DEM_APPL_DATA) Reports, uint16 NumReports) {
+    // Same result as Dem_SetEventStatus for each report in order, for
+    // monitor tasks reporting hundreds of results per cycle. Consecutive
+    // reports of one 32-event word form a run that takes the exclusive area
+    // once and publishes its pending bits with one atomic OR, so monitor
+    // tables ordered by EventId get one run per word. Invalid reports are
+    // skipped and make the result E_NOT_OK.
+    Std_ReturnType Result = E_OK;
+    uint16 Start = 0u;
+
+    if (Reports == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    while (Start < NumReports) {
+        uint16 Word = (uint16)(Reports[Start].EventId / 32u);
+        uint16 End = (uint16)(Start + 1u);
+        uint32 Pending = 0u;
+        uint16 i;
+
+        while ((End < NumReports) && ((Reports[End].EventId / 32u) == Word)) {
+            End++;
+        }
+        SchM_Enter_Dem_DEM_EXCLUSIVE_AREA_0();
+        for (i = Start; i < End; i++) {
+            Dem_EventIdType EventId = Reports[i].EventId;
+            Dem_EventStatusType EventStatus = Reports[i].EventStatus;
+            uint32 BitMask = (uint32)1u << (EventId % 32u);
+            uint8 Algorithm;
+
+            if (Dem_CheckReport(EventId, EventStatus, &Algorithm) == FALSE) {
+                Result = E_NOT_OK;
+                continue;
+            }
+            if ((EventStatus == DEM_EVENT_STATUS_FAILED) || (EventStatus == DEM_EVENT_STATUS_PASSED)) {
+                (void)Dem_SetQualifiedStatus(EventId, (EventStatus == DEM_EVENT_STATUS_FAILED) ? TRUE : FALSE);
+            }
+            if (Algorithm != DEM_DEBOUNCE_MONITOR_INTERNAL) {
+                atomic_store_explicit(&Dem_DebounceReport[EventId], (uint8)EventStatus, memory_order_relaxed);
+                Pending |= BitMask;
+            }
+        }
+        SchM_Exit_Dem_DEM_EXCLUSIVE_AREA_0();
+
+        if (Pending != 0u) {
+            (void)atomic_fetch_or_explicit(&Dem_DebouncePending[Word], Pending, memory_order_release);
+        }
+        Start = End;
+    }
+    return Result;
+}
+
+static FUNC(void, DEM_CODE) Dem_DebounceTimerTick(Dem_EventIdType EventId) {
+    if (Dem_DebounceTimer[EventId] > DEM_TASK_TIME) {
+        Dem_DebounceTimer[EventId] -= DEM_TASK_TIME;
+    } else {
+        Dem_DebounceTimerRunning[EventId / 32u] &= ~((uint32)1u << (EventId % 32u));
+        (void)Dem_ApplyQualifiedStatus(EventId, (Dem_DebounceCounter[EventId] > 0) ? TRUE : FALSE);
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DebounceTimeBased(Dem_EventIdType EventId, P2CONST(Dem_DebounceClassConfigType, AUTOMATIC, DEM_CONST) Class, uint8 Report) {
+    sint16 Direction = (sint16)(((Report == DEM_EVENT_STATUS_PREFAILED) || (Report == DEM_EVENT_STATUS_FAILED)) ? 1 : -1);
+    uint32 BitMask = (uint32)1u << (EventId % 32u);
+
+    if ((Report == DEM_EVENT_STATUS_FAILED) || (Report == DEM_EVENT_STATUS_PASSED)) {
+        // Already qualified by the report: stop any timer, re-apply the latest result
+        Dem_DebounceTimerRunning[EventId / 32u] &= ~BitMask;
+        Dem_DebounceCounter[EventId] = Direction;
+        (void)Dem_ApplyQualifiedStatus(EventId, (Direction > 0) ? TRUE : FALSE);
+    } else if (Dem_DebounceCounter[EventId] == Direction) {
+        // Same direction: a running timer goes on (its tick of this period
+        // was skipped for the report), an expired one stays qualified
+        if ((Dem_DebounceTimerRunning[EventId / 32u] & BitMask) != 0u) {
+            Dem_DebounceTimerTick(EventId);
+        }
+    } else {
+        uint16 TimeMs = (Direction > 0) ? Class->FailedTimeMs : Class->PassedTimeMs;
+
+        Dem_DebounceCounter[EventId] = Direction;
+        if (TimeMs == 0u) {
+            Dem_DebounceTimerRunning[EventId / 32u] &= ~BitMask;
+            (void)Dem_ApplyQualifiedStatus(EventId, (Direction > 0) ? TRUE : FALSE);
+        } else {
+            Dem_DebounceTimer[EventId] = TimeMs;
+            Dem_DebounceTimerRunning[EventId / 32u] |= BitMask;
+        }
+    }
+}
+
+static FUNC(void, DEM_CODE) Dem_DebounceCounterBased(Dem_EventIdType EventId, P2CONST(Dem_DebounceClassConfigType, AUTOMATIC, DEM_CONST) Class, uint8 Report) {
+    sint32 Counter = Dem_DebounceCounter[EventId];
+
+    if (Report == DEM_EVENT_STATUS_PREFAILED) {
+        if ((Class->JumpUp == TRUE) && (Counter < Class->JumpUpValue)) {
+            Counter = Class->JumpUpValue;
+        }
+        Counter += Class->IncrementStepSize;
+    } else if (Report == DEM_EVENT_STATUS_PREPASSED) {
+        if ((Class->JumpDown == TRUE) && (Counter > Class->JumpDownValue)) {
+            Counter = Class->JumpDownValue;
+        }
+        Counter -= Class->DecrementStepSize;
+    } else {
+        Counter = (Report == DEM_EVENT_STATUS_FAILED) ? Class->FailedThreshold : Class->PassedThreshold;
+    }
+
+    if (Counter >= Class->FailedThreshold) {
+        Dem_DebounceCounter[EventId] = Class->FailedThreshold;
+        (void)Dem_ApplyQualifiedStatus(EventId, TRUE);
+    } else if (Counter <= Class->PassedThreshold) {
+        Dem_DebounceCounter[EventId] = Class->PassedThreshold;
+        (void)Dem_ApplyQualifiedStatus(EventId, FALSE);
+    } else {
+        Dem_DebounceCounter[EventId] = (sint16)Counter;
+    }
+}
+
+FUNC(void, DEM_CODE) Dem_MainFunction(void) {
+    // Cyclic, every DEM_TASK_TIME ms: debounce the events reported since the
+    // last call and tick the debounce timers, one 32-event word at a time
+    uint16 w;
+
+    if (atomic_exchange_explicit(&Dem_DebounceResetRequest, FALSE, memory_order_relaxed) == TRUE) {
+        (void)memset(Dem_DebounceCounter, 0, sizeof(Dem_DebounceCounter));
+        (void)memset(Dem_DebounceTimerRunning, 0, sizeof(Dem_DebounceTimerRunning));
+    }
+    for (w = 0u; w < DEM_DEBOUNCE_WORDS; w++) {
+        uint32 Pending = 0u;
+        uint32 Ticking;
+
+        if (atomic_load_explicit(&Dem_DebouncePending[w], memory_order_relaxed) != 0u) {
+            Pending = atomic_exchange_explicit(&Dem_DebouncePending[w], 0u, memory_order_acquire);
+        }
+        // Timers of reported events are handled together with their report
+        Ticking = Dem_DebounceTimerRunning[w] & ~Pending;
+        while (Ticking != 0u) {
+            uint8 Bit = (uint8)(31u - DEM_CLZ32(Ticking));
+
+            Ticking &= ~((uint32)1u << Bit);
+            Dem_DebounceTimerTick((Dem_EventIdType)((w * 32u) + Bit));
+        }
+        while (Pending != 0u) {
+            uint8 Bit = (uint8)(31u - DEM_CLZ32(Pending));
+            Dem_EventIdType EventId = (Dem_EventIdType)((w * 32u) + Bit);
+            // A report stored after its bit was taken by the previous call is already consumed
+            uint8 Report = (uint8)atomic_exchange_explicit(&Dem_DebounceReport[EventId], DEM_DEBOUNCE_NO_REPORT, memory_order_relaxed);
+
+            Pending &= ~((uint32)1u << Bit);
+            if (Report != DEM_DEBOUNCE_NO_REPORT) {
+                P2CONST(Dem_DebounceClassConfigType, AUTOMATIC, DEM_CONST) Class = &Dem_DebounceClassConfig[Dem_EventConfig[EventId].DebounceClassRef];
+
+                if (Class->Algorithm == DEM_DEBOUNCE_TIME_BASED) {
+                    Dem_DebounceTimeBased(EventId, Class, Report);
+                } else {
+                    Dem_DebounceCounterBased(EventId, Class, Report);
+                }
+            }
+        }
+    }
+}
+
+FUNC(Std_ReturnType, DEM_CODE) Dem_GetEventStatus(Dem_EventIdType EventId, P2VAR(Dem_EventStatusExtendedType, AUTOMATIC, DEM_APPL_DATA) EventStatusExtended) {
+    if ((EventId >= DEM_NUM_OF_EVENTS) || (EventStatusExtended == NULL_PTR)) {
+        return E_NOT_OK;
+    }
+    *EventStatusExtended = Dem_EventStatus.Byte[EventId];
+    return E_OK;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetNumberOfEventsByStatusMask(uint8 StatusMask) {
+    // Events with any StatusMask bit set
+    uint16 Count = 0u;
+    uint16 w;
+
+    for (w = 0u; w < DEM_STATUS_WORDS; w++) {
+        Count += Dem_SwarCount(Dem_SwarMatch(Dem_EventStatus.Word[w], StatusMask));
+    }
+    return Count;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetEventsByStatusMask(uint8 StatusMask, P2VAR(Dem_EventIdType, AUTOMATIC, DEM_APPL_DATA) EventIds, uint16 MaxCount) {
+    // Ascending EventIds with any StatusMask bit set; words without a match are skipped whole
+    uint16 Count = 0u;
+    uint16 w;
+
+    for (w = 0u; (w < DEM_STATUS_WORDS) && (Count < MaxCount); w++) {
+        if (Dem_SwarMatch(Dem_EventStatus.Word[w], StatusMask) != 0u) {
+            uint16 EventId;
+
+            for (EventId = (uint16)(w * 8u); (EventId < ((w * 8u) + 8u)) && (Count < MaxCount); EventId++) {
+                if ((Dem_EventStatus.Byte[EventId] & StatusMask) != 0u) {
+                    EventIds[Count] = EventId;
+                    Count++;
+                }
+            }
+        }
+    }
+    return Count;
+}
+
+FUNC(void, DEM_CODE) Dem_ClearAllEvents(void) {
+    uint16 w;
+    uint16 EventId;
+
+    SchM_Enter_Dem_DEM_EXCLUSIVE_AREA_0();
+    for (w = 0u; w < DEM_STATUS_FULL_WORDS; w++) {
+        Dem_EventStatus.Word[w] = DEM_SWAR_ONES * DEM_UDS_STATUS_INITIAL;
+    }
+    for (EventId = (uint16)(DEM_STATUS_FULL_WORDS * 8u); EventId < DEM_NUM_OF_EVENTS; EventId++) {
+        Dem_EventStatus.Byte[EventId] = DEM_UDS_STATUS_INITIAL;
+    }
+    (void)memset(Dem_OccurrenceCounter, 0, sizeof(Dem_OccurrenceCounter));
+    Dem_DtcIndexRebuild();
+    Dem_DtcLogAppend(DEM_EVENT_ID_ALL_EVENTS, 0u, 0u);
+    SchM_Exit_Dem_DEM_EXCLUSIVE_AREA_0();
+    // Debounce counters and timers restart at the next Dem_MainFunction
+    atomic_store_explicit(&Dem_DebounceResetRequest, TRUE, memory_order_relaxed);
+}
+
+FUNC(void, DEM_CODE) Dem_RestartOperationCycle(uint8 OperationCycleId) {
+    // End of the (single, power) operation cycle and start of the next one:
+    // pendingDTC ends for events tested and not failed this cycle, then
+    // TFTOC is cleared and TNCTOC set for every event
+    uint16 w;
+    uint16 EventId;
+
+    (void)OperationCycleId;
+    SchM_Enter_Dem_DEM_EXCLUSIVE_AREA_0();
+    for (w = 0u; w < DEM_STATUS_FULL_WORDS; w++) {
+        uint64 Word = Dem_EventStatus.Word[w];
+        uint64 Quiet = ~Dem_SwarMatch(Word, DEM_UDS_STATUS_TFTOC | DEM_UDS_STATUS_TNCTOC) & DEM_SWAR_HIGH;
+
+        Word &= ~((Quiet >> 7) * DEM_UDS_STATUS_PDTC);
+        Word &= ~(DEM_SWAR_ONES * DEM_UDS_STATUS_TFTOC);
+        Dem_EventStatus.Word[w] = Word | (DEM_SWAR_ONES * DEM_UDS_STATUS_TNCTOC);
+    }
+    for (EventId = (uint16)(DEM_STATUS_FULL_WORDS * 8u); EventId < DEM_NUM_OF_EVENTS; EventId++) {
+        uint8 Status = Dem_EventStatus.Byte[EventId];
+
+        if ((Status & (DEM_UDS_STATUS_TFTOC | DEM_UDS_STATUS_TNCTOC)) == 0u) {
+            Status &= (uint8)~DEM_UDS_STATUS_PDTC;
+        }
+        Dem_EventStatus.Byte[EventId] = (uint8)((Status & (uint8)~DEM_UDS_STATUS_TFTOC) | DEM_UDS_STATUS_TNCTOC);
+    }
+    Dem_DtcIndexRebuild();
+    Dem_DtcLogAppend(DEM_EVENT_ID_ALL_EVENTS, 0u, 0u);
+    SchM_Exit_Dem_DEM_EXCLUSIVE_AREA_0();
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetDTCStatusChanges(uint8 ConsumerId, P2VAR(Dem_DTCStatusChangeType, AUTOMATIC, DEM_APPL_DATA) Changes, uint16 MaxChanges) {
+    // Up to MaxChanges log entries for one consumer, oldest first; called
+    // only from that consumer's main function
+    P2CONST(Dem_DtcLogConsumerType, AUTOMATIC, DEM_CONST) Consumer;
+    uint16 Count = 0u;
+
+    if ((ConsumerId >= DEM_DTCLOG_NUM_CONSUMERS) || (Changes == NULL_PTR)) {
+        return 0u;
+    }
+    Consumer = &Dem_DtcLogConsumer[ConsumerId];
+    while (Count < MaxChanges) {
+        uint32 Resync = Dem_DtcLogResyncEvent[ConsumerId];
+
+        if (Resync == DEM_DTCLOG_RESYNC_MARKER) {
+            Changes[Count].EventId = DEM_EVENT_ID_ALL_EVENTS;
+            Changes[Count].OldStatus = 0u;
+            Changes[Count].NewStatus = 0u;
+            Count++;
+            Dem_DtcLogResyncEvent[ConsumerId] = 0u;
+        } else if (Resync != DEM_DTCLOG_NO_RESYNC) {
+            // Snapshot of the current status, continued on the next call when Changes is full
+            uint32 EventId;
+
+            for (EventId = Resync; (EventId < DEM_NUM_OF_EVENTS) && (Count < MaxChanges); EventId++) {
+                uint8 Status = Dem_EventStatus.Byte[EventId];
+
+                if (((Status & Consumer->SnapshotMask) != 0u) &&
+                    ((Consumer->ReportToDcmOnly == FALSE) || (Dem_EventConfig[EventId].ReportToDcm == TRUE))) {
+                    Changes[Count].EventId = (Dem_EventIdType)EventId;
+                    Changes[Count].OldStatus = Status;
+                    Changes[Count].NewStatus = Status;
+                    Count++;
+                }
+            }
+            Dem_DtcLogResyncEvent[ConsumerId] = (EventId < DEM_NUM_OF_EVENTS) ? EventId : DEM_DTCLOG_NO_RESYNC;
+        } else {
+            uint32 Seq = Dem_DtcLogReadSeq[ConsumerId];
+            P2VAR(Dem_DtcLogSlotType, AUTOMATIC, DEM_VAR_NOINIT) Slot = &Dem_DtcLog[Seq % DEM_DTCLOG_SIZE];
+            uint32 Stamp = atomic_load_explicit(&Slot->Stamp, memory_order_acquire);
+            uint32 Data;
+
+            if (Stamp != ((2u * Seq) + 2u)) {
+                if ((sint32)(Stamp - ((2u * Seq) + 2u)) < 0) {
+                    break;      // Not published yet
+                }
+                // Lapped by the writers: skip to the newest entries and resync
+                Dem_DtcLogReadSeq[ConsumerId] = atomic_load_explicit(&Dem_DtcLogHead, memory_order_relaxed);
+                Dem_DtcLogResyncEvent[ConsumerId] = DEM_DTCLOG_RESYNC_MARKER;
+                continue;
+            }
+            Data = atomic_load_explicit(&Slot->Data, memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&Slot->Stamp, memory_order_relaxed) != Stamp) {
+                continue;       // Overwritten while read: lapped, handled above
+            }
+            Dem_DtcLogReadSeq[ConsumerId] = Seq + 1u;
+            if ((Data >> 16) == DEM_EVENT_ID_ALL_EVENTS) {
+                Dem_DtcLogResyncEvent[ConsumerId] = DEM_DTCLOG_RESYNC_MARKER;
+            } else if ((Consumer->ReportToDcmOnly == FALSE) || (Dem_EventConfig[Data >> 16].ReportToDcm == TRUE)) {
+                Changes[Count].EventId = (Dem_EventIdType)(Data >> 16);
+                Changes[Count].OldStatus = (uint8)(Data >> 8);
+                Changes[Count].NewStatus = (uint8)Data;
+                Count++;
+            }
+        }
+    }
+    return Count;
+}
+
+FUNC(Std_ReturnType, DEM_CODE) Dem_GetEventIdOfDTC(uint32 Dtc, P2VAR(Dem_EventIdType, AUTOMATIC, DEM_APPL_DATA) EventId) {
+    // Binary search of the DTC-sorted positions
+    uint16 Low = 0u;
+    uint16 High = Dem_DtcCount;
+
+    if (EventId == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    while (Low < High) {
+        uint16 Mid = (uint16)((Low + High) / 2u);
+
+        if (Dem_DtcSortedDtc[Mid] < Dtc) {
+            Low = (uint16)(Mid + 1u);
+        } else {
+            High = Mid;
+        }
+    }
+    if ((Low >= Dem_DtcCount) || (Dem_DtcSortedDtc[Low] != Dtc)) {
+        return E_NOT_OK;
+    }
+    *EventId = Dem_DtcSortedEvent[Low];
+    return E_OK;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetNumberOfDTCByStatusMask(uint8 StatusMask) {
+    // DTCs with any (available) StatusMask bit set, from the per-value counts
+    uint16 Count = 0u;
+    uint16 Status;
+
+    StatusMask &= DEM_DTC_STATUS_AVAILABILITY_MASK;
+    for (Status = 1u; Status < 256u; Status++) {
+        if ((Status & StatusMask) != 0u) {
+            Count += Dem_DtcStatusCount[Status];
+        }
+    }
+    return Count;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetDTCByStatusMask(uint8 StatusMask, P2VAR(uint16, AUTOMATIC, DEM_APPL_DATA) NextPosition,
+                                              P2VAR(Dem_DTCRecordType, AUTOMATIC, DEM_APPL_DATA) Records, uint16 MaxRecords) {
+    // Up to MaxRecords DTCs with any (available) StatusMask bit set, in
+    // ascending DTC order from *NextPosition (0 to start), which is advanced
+    // so the listing can be continued; fewer than MaxRecords means the end
+    uint16 Count = 0u;
+    uint16 Position;
+
+    if ((NextPosition == NULL_PTR) || (Records == NULL_PTR)) {
+        return 0u;
+    }
+    StatusMask &= DEM_DTC_STATUS_AVAILABILITY_MASK;
+    Position = *NextPosition;
+    while ((Count < MaxRecords) && (Position < Dem_DtcCount) && (StatusMask != 0u)) {
+        uint16 Word = (uint16)(Position / 32u);
+        uint32 Summary = 0u;
+        uint32 Bits = 0u;
+        uint8 Bit;
+
+        for (Bit = 0u; Bit < 8u; Bit++) {
+            if ((StatusMask & (1u << Bit)) != 0u) {
+                Summary |= Dem_DtcStatusSummary[Bit][Word / 32u];
+            }
+        }
+        Summary &= ~(((uint32)1u << (Word % 32u)) - 1u);
+        if (Summary == 0u) {
+            Position = (uint16)(((Word / 32u) + 1u) * 1024u);
+            continue;
+        }
+        if (((Word / 32u) * 32u) + DEM_CTZ32(Summary) != Word) {
+            Position = (uint16)((((Word / 32u) * 32u) + DEM_CTZ32(Summary)) * 32u);
+            continue;
+        }
+        for (Bit = 0u; Bit < 8u; Bit++) {
+            if ((StatusMask & (1u << Bit)) != 0u) {
+                Bits |= Dem_DtcStatusBits[Bit][Word];
+            }
+        }
+        Bits &= ~(((uint32)1u << (Position % 32u)) - 1u);
+        while ((Bits != 0u) && (Count < MaxRecords)) {
+            uint16 Match = (uint16)((Word * 32u) + DEM_CTZ32(Bits));
+
+            Bits &= Bits - 1u;
+            Records[Count].Dtc = Dem_DtcSortedDtc[Match];
+            Records[Count].Status = (uint8)(Dem_EventStatus.Byte[Dem_DtcSortedEvent[Match]] & DEM_DTC_STATUS_AVAILABILITY_MASK);
+            Count++;
+            Position = (uint16)(Match + 1u);
+        }
+        if (Bits == 0u) {
+            Position = (uint16)((Word + 1u) * 32u);
+        }
+    }
+    *NextPosition = (Position < Dem_DtcCount) ? Position : Dem_DtcCount;
+    return Count;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetNumberOfSupportedDTC(void) {
+    return Dem_DtcCount;
+}
+
+FUNC(uint16, DEM_CODE) Dem_GetSupportedDTC(P2VAR(uint16, AUTOMATIC, DEM_APPL_DATA) NextPosition,
+                                           P2VAR(Dem_DTCRecordType, AUTOMATIC, DEM_APPL_DATA) Records, uint16 MaxRecords) {
+    // As Dem_GetDTCByStatusMask, for all DTCs regardless of status
+    uint16 Count = 0u;
+    uint16 Position;
+
+    if ((NextPosition == NULL_PTR) || (Records == NULL_PTR)) {
+        return 0u;
+    }
+    for (Position = *NextPosition; (Count < MaxRecords) && (Position < Dem_DtcCount); Position++) {
+        Records[Count].Dtc = Dem_DtcSortedDtc[Position];
+        Records[Count].Status = (uint8)(Dem_EventStatus.Byte[Dem_DtcSortedEvent[Position]] & DEM_DTC_STATUS_AVAILABILITY_MASK);
+        Count++;
+    }
+    *NextPosition = Position;
+    return Count;
+}
+
+/* DIAGNOSTIC STACK - DCM */
+// File: Dcm.c
+FUNC(void, DCM_CODE) Dcm_DemTriggerOnDTCStatus(Dem_EventIdType EventId, uint8 DTCStatus) {
+    // Step 19: Diagnostic Communication Manager
+    // Handle diagnostic trouble codes for door system (mirror is dense, by EventId)
+    Dcm_DTCStatusType* DTCEntry = &Dcm_DTCStatus[EventId];
+    DTCEntry->Status |= DTCStatus;
+    DTCEntry->Timestamp = Dcm_GetCurrentTimestamp();
+}
+
+/* Diagnostic requests over the transport protocol, one at a time: PduR
+ * delivers the request into Dcm_RxBuffer (Dcm_StartOfReception,
+ * Dcm_CopyRxData, Dcm_TpRxIndication), Dcm_MainFunction processes it and
+ * starts the response with only its total length (PduR_DcmTransmit), and
+ * the transport layer then pulls the response with Dcm_CopyTxData as it
+ * fills each frame. The response is produced on demand in units (header,
+ * up to DCM_STREAM_DTC_RECORDS DTC records, one DID with its data) into a
+ * small staging buffer, so RAM use is bounded by the largest unit rather
+ * than the response, and the first frame leaves before the rest exists.
+ * The length is fixed at the start: DTC lists announce the number of DTCs
+ * matching at that moment and send at most that many (ascending DTC order,
+ * status as of sending). If fewer still match, or a DID cannot be read,
+ * the rest of the announced length is padded with 0x00. A response longer
+ * than DCM_TX_MAX_LENGTH (the largest value of the configured PduLengthType,
+ * 0xFFFF for uint16, 0xFFFFFFFF for uint32) is refused with NRC 0x14,
+ * and a positive 0x19 response is not sent when the request sets the
+ * suppressPosRspMsgIndicationBit. Dcm_Init reports a DID longer than
+ * DCM_DID_MAX_LENGTH to the DET; such a DID is treated as unsupported.
+ * Services: 0x19 ReadDTCInformation 0x01 reportNumberOfDTCByStatusMask,
+ * 0x02 reportDTCByStatusMask, 0x0A reportSupportedDTC (from the DEM DTC
+ * index), and 0x22 ReadDataByIdentifier with one or more DIDs
+ * (Dcm_DidConfig[], sorted by DID). */
+#define DCM_SID_READ_DTC_INFORMATION                    0x19u
+#define DCM_SID_READ_DATA_BY_IDENTIFIER                 0x22u
+#define DCM_SID_NEGATIVE_RESPONSE                       0x7Fu
+#define DCM_POSITIVE_RESPONSE_OFFSET                    0x40u
+#define DCM_E_SERVICENOTSUPPORTED                       0x11u
+#define DCM_E_SUBFUNCTIONNOTSUPPORTED                   0x12u
+#define DCM_E_INCORRECTMESSAGELENGTHORINVALIDFORMAT     0x13u
+#define DCM_E_RESPONSETOOLONG                           0x14u
+#define DCM_E_REQUESTOUTOFRANGE                         0x31u
+#define DCM_DTC_FORMAT_ISO14229_1                       0x01u
+#define DCM_SUPPRESS_POS_RSP_MASK                       0x80u
+
+#define DCM_MODULE_ID                                   53u
+#define DCM_INSTANCE_ID                                 0u
+#define DCM_SID_INIT                                    0x01u
+#define DCM_E_INIT_FAILED                               0x08u
+
+#ifndef DCM_RX_BUFFER_SIZE
+#define DCM_RX_BUFFER_SIZE                              4095u
+#endif
+#ifndef DCM_DID_MAX_LENGTH
+#define DCM_DID_MAX_LENGTH                              64u     // Largest Dcm_DidConfig[].DataLength
+#endif
+#ifndef DCM_TX_MAX_LENGTH
+#define DCM_TX_MAX_LENGTH                               ((uint32)(PduLengthType)~(PduLengthType)0u) // Largest response a PduLengthType can announce
+#endif
+#define DCM_STREAM_DTC_RECORDS                          8u
+#define DCM_STREAM_STAGING_SIZE                         (((2u + DCM_DID_MAX_LENGTH) > (4u * DCM_STREAM_DTC_RECORDS)) ? \
+                                                         (2u + DCM_DID_MAX_LENGTH) : (4u * DCM_STREAM_DTC_RECORDS))
+
+#define DCM_STATE_IDLE                                  0u
+#define DCM_STATE_RECEIVING                             1u
+#define DCM_STATE_PROCESSING                            2u
+#define DCM_STATE_TRANSMITTING                          3u
+
+#define DCM_STREAM_NONE                                 0u      // Staging holds the whole response
+#define DCM_STREAM_DTC_BY_STATUS                        1u
+#define DCM_STREAM_SUPPORTED_DTC                        2u
+#define DCM_STREAM_DIDS                                 3u
+
+typedef struct {
+    uint8 Source;
+    uint8 StatusMask;
+    uint16 NextPosition;        // DTC lists: DEM position to continue from
+    uint16 RemainingRecords;    // DTC lists: announced records not produced yet
+    uint16 NextDid;             // DID list: offset of the next requested DID in Dcm_RxBuffer
+    PduLengthType Total;
+    PduLengthType Sent;
+    uint16 StagingLength;
+    uint16 StagingPos;
+    uint8 Staging[DCM_STREAM_STAGING_SIZE];
+} Dcm_TxStreamType;
+
+static VAR(uint8, DCM_VAR) Dcm_State = DCM_STATE_IDLE;
+static VAR(PduIdType, DCM_VAR) Dcm_RxPduId;
+static VAR(PduLengthType, DCM_VAR) Dcm_RxLength;
+static VAR(PduLengthType, DCM_VAR) Dcm_RxExpected;
+static VAR(uint8, DCM_VAR) Dcm_RxBuffer[DCM_RX_BUFFER_SIZE];
+static VAR(Dcm_TxStreamType, DCM_VAR) Dcm_TxStream;
+
+FUNC(void, DCM_CODE) Dcm_Init(void) {
+    uint16 i;
+
+    Dcm_State = DCM_STATE_IDLE;
+    for (i = 0u; i < DCM_NUM_OF_DIDS; i++) {
+        if (Dcm_DidConfig[i].DataLength > DCM_DID_MAX_LENGTH) {
+            // Would not fit the staging buffer; Dcm_FindDid never returns it
+            (void)Det_ReportError(DCM_MODULE_ID, DCM_INSTANCE_ID, DCM_SID_INIT, DCM_E_INIT_FAILED);
+        }
+    }
+}
+
+FUNC(BufReq_ReturnType, DCM_CODE) Dcm_StartOfReception(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, DCM_APPL_DATA) info,
+                                                       PduLengthType TpSduLength, P2VAR(PduLengthType, AUTOMATIC, DCM_APPL_DATA) bufferSizePtr) {
+    (void)info;
+    if ((id >= DCM_NUM_OF_RX_PDUS) || (bufferSizePtr == NULL_PTR)) {
+        return BUFREQ_E_NOT_OK;
+    }
+    if (Dcm_State != DCM_STATE_IDLE) {
+        return BUFREQ_E_BUSY;     // The request may be offered again once the current one is answered
+    }
+    if ((TpSduLength == 0u) || (TpSduLength > DCM_RX_BUFFER_SIZE)) {
+        return BUFREQ_E_OVFL;
+    }
+    Dcm_State = DCM_STATE_RECEIVING;
+    Dcm_RxPduId = id;
+    Dcm_RxLength = 0u;
+    Dcm_RxExpected = TpSduLength;
+    *bufferSizePtr = DCM_RX_BUFFER_SIZE;
+    return BUFREQ_OK;
+}
+
+FUNC(BufReq_ReturnType, DCM_CODE) Dcm_CopyRxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, DCM_APPL_DATA) info,
+                                                 P2VAR(PduLengthType, AUTOMATIC, DCM_APPL_DATA) bufferSizePtr) {
+    if ((Dcm_State != DCM_STATE_RECEIVING) || (id != Dcm_RxPduId) || (info == NULL_PTR) || (bufferSizePtr == NULL_PTR) ||
+        (info->SduLength > (Dcm_RxExpected - Dcm_RxLength))) {
+        return BUFREQ_E_NOT_OK;
+    }
+    if (info->SduLength > 0u) {
+        (void)memcpy(&Dcm_RxBuffer[Dcm_RxLength], info->SduDataPtr, info->SduLength);
+        Dcm_RxLength += info->SduLength;
+    }
+    *bufferSizePtr = (PduLengthType)(DCM_RX_BUFFER_SIZE - Dcm_RxLength);
+    return BUFREQ_OK;
+}
+
+FUNC(void, DCM_CODE) Dcm_TpRxIndication(PduIdType id, Std_ReturnType result) {
+    if ((Dcm_State == DCM_STATE_RECEIVING) && (id == Dcm_RxPduId)) {
+        // Processed in Dcm_MainFunction
+        Dcm_State = ((result == E_OK) && (Dcm_RxLength == Dcm_RxExpected)) ? DCM_STATE_PROCESSING : DCM_STATE_IDLE;
+    }
+}
+
+static FUNC(void, DCM_CODE) Dcm_StartNegativeResponse(uint8 Sid, uint8 Nrc) {
+    Dcm_TxStream.Source = DCM_STREAM_NONE;
+    Dcm_TxStream.Staging[0] = DCM_SID_NEGATIVE_RESPONSE;
+    Dcm_TxStream.Staging[1] = Sid;
+    Dcm_TxStream.Staging[2] = Nrc;
+    Dcm_TxStream.StagingLength = 3u;
+    Dcm_TxStream.Total = 3u;
+}
+
+static FUNC(void, DCM_CODE) Dcm_StartReadDTCInformation(void) {
+    uint8 SubFunction;
+    uint16 Count;
+
+    if (Dcm_RxLength < 2u) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DTC_INFORMATION, DCM_E_INCORRECTMESSAGELENGTHORINVALIDFORMAT);
+        return;
+    }
+    SubFunction = (uint8)(Dcm_RxBuffer[1] & 0x7Fu);
+    if ((SubFunction != 0x01u) && (SubFunction != 0x02u) && (SubFunction != 0x0Au)) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DTC_INFORMATION, DCM_E_SUBFUNCTIONNOTSUPPORTED);
+        return;
+    }
+    if (Dcm_RxLength != ((SubFunction == 0x0Au) ? 2u : 3u)) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DTC_INFORMATION, DCM_E_INCORRECTMESSAGELENGTHORINVALIDFORMAT);
+        return;
+    }
+    Dcm_TxStream.Staging[0] = DCM_SID_READ_DTC_INFORMATION + DCM_POSITIVE_RESPONSE_OFFSET;
+    Dcm_TxStream.Staging[1] = SubFunction;
+    Dcm_TxStream.Staging[2] = DEM_DTC_STATUS_AVAILABILITY_MASK;
+    Count = (SubFunction == 0x0Au) ? Dem_GetNumberOfSupportedDTC() : Dem_GetNumberOfDTCByStatusMask(Dcm_RxBuffer[2]);
+
+    if ((SubFunction != 0x01u) && ((3u + (4u * (uint32)Count)) > DCM_TX_MAX_LENGTH)) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DTC_INFORMATION, DCM_E_RESPONSETOOLONG);
+    } else if ((Dcm_RxBuffer[1] & DCM_SUPPRESS_POS_RSP_MASK) != 0u) {
+        Dcm_TxStream.Total = 0u;
+    } else if (SubFunction == 0x01u) {
+        Dcm_TxStream.Source = DCM_STREAM_NONE;
+        Dcm_TxStream.Staging[3] = DCM_DTC_FORMAT_ISO14229_1;
+        Dcm_TxStream.Staging[4] = (uint8)(Count >> 8);
+        Dcm_TxStream.Staging[5] = (uint8)Count;
+        Dcm_TxStream.StagingLength = 6u;
+        Dcm_TxStream.Total = 6u;
+    } else {
+        Dcm_TxStream.Source = (SubFunction == 0x02u) ? DCM_STREAM_DTC_BY_STATUS : DCM_STREAM_SUPPORTED_DTC;
+        Dcm_TxStream.StatusMask = (SubFunction == 0x02u) ? Dcm_RxBuffer[2] : 0u;
+        Dcm_TxStream.NextPosition = 0u;
+        Dcm_TxStream.RemainingRecords = Count;
+        Dcm_TxStream.StagingLength = 3u;
+        Dcm_TxStream.Total = (PduLengthType)(3u + (4u * (uint32)Count));
+    }
+}
+
+static FUNC_P2CONST(Dcm_DidConfigType, DCM_CONST, DCM_CODE) Dcm_FindDid(uint16 Did) {
+    // Binary search of Dcm_DidConfig (sorted by DID)
+    uint16 Low = 0u;
+    uint16 High = DCM_NUM_OF_DIDS;
+
+    while (Low < High) {
+        uint16 Mid = (uint16)((Low + High) / 2u);
+
+        if (Dcm_DidConfig[Mid].Did < Did) {
+            Low = (uint16)(Mid + 1u);
+        } else {
+            High = Mid;
+        }
+    }
+    return ((Low < DCM_NUM_OF_DIDS) && (Dcm_DidConfig[Low].Did == Did) && (Dcm_DidConfig[Low].DataLength <= DCM_DID_MAX_LENGTH))
+               ? &Dcm_DidConfig[Low] : NULL_PTR;
+}
+
+static FUNC(void, DCM_CODE) Dcm_StartReadDataByIdentifier(void) {
+    // Unsupported DIDs are left out of the response; NRC only if none is supported
+    uint32 Total = 1u;
+    PduLengthType Offset;
+
+    if ((Dcm_RxLength < 3u) || (((Dcm_RxLength - 1u) % 2u) != 0u)) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DATA_BY_IDENTIFIER, DCM_E_INCORRECTMESSAGELENGTHORINVALIDFORMAT);
+        return;
+    }
+    for (Offset = 1u; Offset < Dcm_RxLength; Offset += 2u) {
+        P2CONST(Dcm_DidConfigType, AUTOMATIC, DCM_CONST) Did = Dcm_FindDid((uint16)(((uint16)Dcm_RxBuffer[Offset] << 8) | Dcm_RxBuffer[Offset + 1u]));
+
+        if (Did != NULL_PTR) {
+            Total += 2u + (uint32)Did->DataLength;
+        }
+    }
+    if (Total == 1u) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DATA_BY_IDENTIFIER, DCM_E_REQUESTOUTOFRANGE);
+        return;
+    }
+    if (Total > DCM_TX_MAX_LENGTH) {
+        Dcm_StartNegativeResponse(DCM_SID_READ_DATA_BY_IDENTIFIER, DCM_E_RESPONSETOOLONG);
+        return;
+    }
+    Dcm_TxStream.Source = DCM_STREAM_DIDS;
+    Dcm_TxStream.NextDid = 1u;
+    Dcm_TxStream.Staging[0] = DCM_SID_READ_DATA_BY_IDENTIFIER + DCM_POSITIVE_RESPONSE_OFFSET;
+    Dcm_TxStream.StagingLength = 1u;
+    Dcm_TxStream.Total = (PduLengthType)Total;
+}
+
+static FUNC(void, DCM_CODE) Dcm_StreamRefill(void) {
+    // Next unit of the response into the staging buffer; none left: StagingLength 0
+    Dcm_TxStream.StagingPos = 0u;
+    Dcm_TxStream.StagingLength = 0u;
+
+    if ((Dcm_TxStream.Source == DCM_STREAM_DTC_BY_STATUS) || (Dcm_TxStream.Source == DCM_STREAM_SUPPORTED_DTC)) {
+        Dem_DTCRecordType Records[DCM_STREAM_DTC_RECORDS];
+        uint16 Wanted = (Dcm_TxStream.RemainingRecords < DCM_STREAM_DTC_RECORDS) ? Dcm_TxStream.RemainingRecords : DCM_STREAM_DTC_RECORDS;
+        uint16 Count = 0u;
+        uint16 i;
+
+        if (Wanted > 0u) {
+            Count = (Dcm_TxStream.Source == DCM_STREAM_DTC_BY_STATUS)
+                        ? Dem_GetDTCByStatusMask(Dcm_TxStream.StatusMask, &Dcm_TxStream.NextPosition, Records, Wanted)
+                        : Dem_GetSupportedDTC(&Dcm_TxStream.NextPosition, Records, Wanted);
+        }
+        for (i = 0u; i < Count; i++) {
+            Dcm_TxStream.Staging[(4u * i)] = (uint8)(Records[i].Dtc >> 16);
+            Dcm_TxStream.Staging[(4u * i) + 1u] = (uint8)(Records[i].Dtc >> 8);
+            Dcm_TxStream.Staging[(4u * i) + 2u] = (uint8)Records[i].Dtc;
+            Dcm_TxStream.Staging[(4u * i) + 3u] = Records[i].Status;
+        }
+        Dcm_TxStream.StagingLength = (uint16)(4u * Count);
+        Dcm_TxStream.RemainingRecords = (Count == Wanted) ? (uint16)(Dcm_TxStream.RemainingRecords - Count) : 0u;
+    } else if (Dcm_TxStream.Source == DCM_STREAM_DIDS) {
+        while ((Dcm_TxStream.NextDid < Dcm_RxLength) && (Dcm_TxStream.StagingLength == 0u)) {
+            uint16 DidValue = (uint16)(((uint16)Dcm_RxBuffer[Dcm_TxStream.NextDid] << 8) | Dcm_RxBuffer[Dcm_TxStream.NextDid + 1u]);
+            P2CONST(Dcm_DidConfigType, AUTOMATIC, DCM_CONST) Did = Dcm_FindDid(DidValue);
+
+            Dcm_TxStream.NextDid += 2u;
+            if (Did != NULL_PTR) {
+                Dcm_TxStream.Staging[0] = (uint8)(DidValue >> 8);
+                Dcm_TxStream.Staging[1] = (uint8)DidValue;
+                if (Did->ReadData(&Dcm_TxStream.Staging[2]) != E_OK) {
+                    (void)memset(&Dcm_TxStream.Staging[2], 0, Did->DataLength);
+                }
+                Dcm_TxStream.StagingLength = (uint16)(2u + Did->DataLength);
+            }
+        }
+    } else {
+        // DCM_STREAM_NONE: everything was staged at the start
+    }
+}
+
+static FUNC(void, DCM_CODE) Dcm_ProcessRequest(void) {
+    PduInfoType PduInfo;
+
+    Dcm_TxStream.Sent = 0u;
+    Dcm_TxStream.StagingPos = 0u;
+    if (Dcm_RxBuffer[0] == DCM_SID_READ_DTC_INFORMATION) {
+        Dcm_StartReadDTCInformation();
+    } else if (Dcm_RxBuffer[0] == DCM_SID_READ_DATA_BY_IDENTIFIER) {
+        Dcm_StartReadDataByIdentifier();
+    } else {
+        Dcm_StartNegativeResponse(Dcm_RxBuffer[0], DCM_E_SERVICENOTSUPPORTED);
+    }
+    if (Dcm_TxStream.Total == 0u) {
+        // Positive response suppressed
+        Dcm_State = DCM_STATE_IDLE;
+        return;
+    }
+
+    // Only the length is given; the data is pulled through Dcm_CopyTxData
+    PduInfo.SduDataPtr = NULL_PTR;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = Dcm_TxStream.Total;
+    Dcm_State = DCM_STATE_TRANSMITTING;
+    if (PduR_DcmTransmit(Dcm_RxPduConfig[Dcm_RxPduId].TxPduRef, &PduInfo) != E_OK) {
+        Dcm_State = DCM_STATE_IDLE;
+    }
+}
+
+FUNC(BufReq_ReturnType, DCM_CODE) Dcm_CopyTxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, DCM_APPL_DATA) info,
+                                                 P2CONST(RetryInfoType, AUTOMATIC, DCM_APPL_DATA) retry,
+                                                 P2VAR(PduLengthType, AUTOMATIC, DCM_APPL_DATA) availableDataPtr) {
+    // Next info->SduLength bytes of the response (0: only report what is left)
+    PduLengthType Offset = 0u;
+
+    if ((Dcm_State != DCM_STATE_TRANSMITTING) || (id != Dcm_RxPduConfig[Dcm_RxPduId].TxPduRef) || (info == NULL_PTR) ||
+        (availableDataPtr == NULL_PTR) || (info->SduLength > (Dcm_TxStream.Total - Dcm_TxStream.Sent))) {
+        return BUFREQ_E_NOT_OK;
+    }
+    if ((retry != NULL_PTR) && (retry->TpDataState == TP_DATARETRY)) {
+        return BUFREQ_E_NOT_OK;     // Streamed data is not kept for a retry
+    }
+    while (Offset < info->SduLength) {
+        uint16 Chunk;
+
+        if (Dcm_TxStream.StagingPos == Dcm_TxStream.StagingLength) {
+            Dcm_StreamRefill();
+            if (Dcm_TxStream.StagingLength == 0u) {
+                // Fewer DTCs than announced, pad to the announced length
+                (void)memset(&info->SduDataPtr[Offset], 0, info->SduLength - Offset);
+                break;
+            }
+        }
+        Chunk = (uint16)(Dcm_TxStream.StagingLength - Dcm_TxStream.StagingPos);
+        if (Chunk > (info->SduLength - Offset)) {
+            Chunk = (uint16)(info->SduLength - Offset);
+        }
+        (void)memcpy(&info->SduDataPtr[Offset], &Dcm_TxStream.Staging[Dcm_TxStream.StagingPos], Chunk);
+        Dcm_TxStream.StagingPos += Chunk;
+        Offset += Chunk;
+    }
+    Dcm_TxStream.Sent += info->SduLength;
+    *availableDataPtr = Dcm_TxStream.Total - Dcm_TxStream.Sent;
+    return BUFREQ_OK;
+}
+
+FUNC(void, DCM_CODE) Dcm_TpTxConfirmation(PduIdType id, Std_ReturnType result) {
+    (void)result;
+    if ((Dcm_State == DCM_STATE_TRANSMITTING) && (id == Dcm_RxPduConfig[Dcm_RxPduId].TxPduRef)) {
+        Dcm_State = DCM_STATE_IDLE;
+    }
+}
+
+#define DCM_DTCLOG_BATCH            32u
+
+FUNC(void, DCM_CODE) Dcm_MainFunction(void) {
+    // A received request is processed (its response started) first.
+    // DTC status changes are drained from the DEM change log here, so the
+    // reporting monitor never runs DCM code: testFailed rising edges (and
+    // failed DTCs of a resync snapshot) update the DTC mirror
+    Dem_DTCStatusChangeType Changes[DCM_DTCLOG_BATCH];
+    uint16 Count;
+    uint16 i;
+
+    if (Dcm_State == DCM_STATE_PROCESSING) {
+        Dcm_ProcessRequest();
+    }
+
+    do {
+        Count = Dem_GetDTCStatusChanges(DEM_DTCLOG_CONSUMER_DCM, Changes, DCM_DTCLOG_BATCH);
+        for (i = 0u; i < Count; i++) {
+            if ((Changes[i].EventId != DEM_EVENT_ID_ALL_EVENTS) && ((Changes[i].NewStatus & DEM_UDS_STATUS_TF) != 0u) &&
+                (((Changes[i].OldStatus & DEM_UDS_STATUS_TF) == 0u) || (Changes[i].OldStatus == Changes[i].NewStatus))) {
+                Dcm_DemTriggerOnDTCStatus(Changes[i].EventId, DEM_DTC_STATUS_MASK_TESTFAILED);
+            }
+        }
+    } while (Count == DCM_DTCLOG_BATCH);
+}
+
+/* DIAGNOSTIC STACK - FIM */
+// File: FiM.c
+/* Function inhibition: FiM_MainFunction follows the DEM change log into a
+ * bitset of failed events; a function (FID) is permitted while none of its
+ * inhibiting events (FiM_FidConfig[FID].FirstEventRef/NumEventRefs into
+ * FiM_InhibitEventRef[]) is failed. A resync snapshot is collected aside
+ * and swapped in once complete, so permissions never flicker during it. */
+#define FIM_EVENT_WORDS             ((DEM_NUM_OF_EVENTS + 31u) / 32u)
+#define FIM_DTCLOG_BATCH            32u
+
+static VAR(uint32, FIM_VAR) FiM_EventFailed[FIM_EVENT_WORDS];
+static VAR(uint32, FIM_VAR) FiM_ResyncFailed[FIM_EVENT_WORDS];
+static VAR(boolean, FIM_VAR) FiM_Resyncing = FALSE;
+
+FUNC(void, FIM_CODE) FiM_MainFunction(void) {
+    Dem_DTCStatusChangeType Changes[FIM_DTCLOG_BATCH];
+    uint16 Count;
+    uint16 i;
+
+    do {
+        Count = Dem_GetDTCStatusChanges(DEM_DTCLOG_CONSUMER_FIM, Changes, FIM_DTCLOG_BATCH);
+        for (i = 0u; i < Count; i++) {
+            Dem_EventIdType EventId = Changes[i].EventId;
+
+            if (EventId == DEM_EVENT_ID_ALL_EVENTS) {
+                (void)memset(FiM_ResyncFailed, 0, sizeof(FiM_ResyncFailed));
+                FiM_Resyncing = TRUE;
+            } else if (Changes[i].OldStatus == Changes[i].NewStatus) {
+                // Snapshot entries are only delivered for failed events
+                FiM_ResyncFailed[EventId / 32u] |= (uint32)1u << (EventId % 32u);
+            } else {
+                if (FiM_Resyncing == TRUE) {
+                    (void)memcpy(FiM_EventFailed, FiM_ResyncFailed, sizeof(FiM_EventFailed));
+                    FiM_Resyncing = FALSE;
+                }
+                if ((Changes[i].NewStatus & DEM_UDS_STATUS_TF) != 0u) {
+                    FiM_EventFailed[EventId / 32u] |= (uint32)1u << (EventId % 32u);
+                } else {
+                    FiM_EventFailed[EventId / 32u] &= ~((uint32)1u << (EventId % 32u));
+                }
+            }
+        }
+    } while (Count == FIM_DTCLOG_BATCH);
+
+    if (FiM_Resyncing == TRUE) {
+        (void)memcpy(FiM_EventFailed, FiM_ResyncFailed, sizeof(FiM_EventFailed));
+        FiM_Resyncing = FALSE;
+    }
+}
+
+FUNC(Std_ReturnType, FIM_CODE) FiM_GetFunctionPermission(FiM_FunctionIdType FID, P2VAR(boolean, AUTOMATIC, FIM_APPL_DATA) Permission) {
+    P2CONST(FiM_FidConfigType, AUTOMATIC, FIM_CONST) Fid;
+    uint16 Ref;
+
+    if ((FID >= FIM_NUM_OF_FIDS) || (Permission == NULL_PTR)) {
+        return E_NOT_OK;
+    }
+    Fid = &FiM_FidConfig[FID];
+    *Permission = TRUE;
+    for (Ref = Fid->FirstEventRef; Ref < (Fid->FirstEventRef + Fid->NumEventRefs); Ref++) {
+        Dem_EventIdType EventId = FiM_InhibitEventRef[Ref];
+
+        if ((FiM_EventFailed[EventId / 32u] & ((uint32)1u << (EventId % 32u))) != 0u) {
+            *Permission = FALSE;
+            break;
+        }
+    }
+    return E_OK;
+}
+
+/* MEMORY STACK - NVM */
+// File: NvM.c
+FUNC(Std_ReturnType, NVM_CODE) NvM_WriteBlock(NvM_BlockIdType BlockId, P2CONST(void, AUTOMATIC, NVM_APPL_DATA) NvM_SrcPtr) {
+    // Step 20: Non-Volatile Memory Manager
+    // Store door configuration parameters
+    P2CONST(NvM_BlockDescriptorType, AUTOMATIC, NVM_CONST) BlockDesc = &NvM_BlockDescriptor[BlockId];
+    
+    return MemIf_Write(BlockDesc->DeviceId, BlockDesc->NvBlockBaseNumber, NvM_SrcPtr);
+}
+
+/* MODE MANAGEMENT - BSWM */
+// File: BswM.c
+FUNC(void, BSWM_CODE) BswM_RequestMode(BswM_UserType requesting_user, BswM_ModeType requested_mode) {
+    // Step 21: Basic Software Mode Manager
+    // Handle mode transitions (e.g., sleep/wake based on door status)
+    BswM_CurrentMode[requesting_user] = requested_mode;
+    
+    if (requested_mode == BSWM_MODE_SLEEP) {
+        ComM_RequestComMode(COMM_USER_DOOR_SYSTEM, COMM_NO_COMMUNICATION);
+    }
+}
+
+/* COMMUNICATION MANAGEMENT - COMM */
+// File: ComM.c
+FUNC(Std_ReturnType, COMM_CODE) ComM_RequestComMode(ComM_UserHandleType User, ComM_ModeType ComMode) {
+    // Step 22: Communication Manager
+    // Manage CAN network state
+    ComM_UserModeType[User] = ComMode;
+    
+    if (ComMode == COMM_FULL_COMMUNICATION) {
+        CanSM_RequestComMode(CANSM_NETWORK_HANDLE_CAN0, COMM_FULL_COMMUNICATION);
+    }
+}
+
+/* ECU STATE MANAGEMENT - ECUM */
+// File: EcuM.c
+FUNC(void, ECUM_CODE) EcuM_SetWakeupEvent(EcuM_WakeupSourceType sources) {
+    // Step 23: ECU State Manager
+    // Handle door-triggered wakeup events
+    EcuM_WakeupSourceType current_sources = EcuM_GetPendingWakeupEvents();
+    EcuM_SetPendingWakeupEvents(current_sources | sources);
+}
+
+/* OPERATING SYSTEM - OS */
+// File: Os.c
+/* Multicore OS: every core runs its own scheduler over the tasks of the
+ * OS-Applications bound to it. Ready queue per core: one FIFO of activation
+ * records per priority (higher value = higher priority) plus a two-level
+ * bitmap of non-empty FIFOs; insert, remove and "highest ready priority" are
+ * constant time via count-leading-zeros.
+ * Cross-core ActivateTask/SetEvent never take a global lock: the activation
+ * count and event mask are updated atomically by the caller, then a message
+ * is posted to the owning core's lock-free inbox and that core is signalled.
+ * The ready queue and record pool are core-local but also written from ISRs
+ * (counter ticks, the inter-core interrupt), so every update runs with OS
+ * interrupts suspended on that core. */
+#include <stdatomic.h>
+
+#if defined(__TASKING__)
+#define OS_CLZ32(x)             ((uint8)__clz(x))
+#else
+#define OS_CLZ32(x)             ((uint8)__builtin_clz(x))
+#endif
+
+#define OS_NUM_OF_PRIORITIES    256u
+#define OS_READY_GROUPS         (OS_NUM_OF_PRIORITIES / 32u)
+#define OS_RECORD_NIL           0xFFFFu
+
+#define OS_XCORE_ACTIVATE       0u
+#define OS_XCORE_EVENT          1u
+
+typedef struct {
+    TaskType Task;
+    uint16 Next;
+} Os_ActivationRecordType;
+
+typedef struct {
+    atomic_uint_least32_t Sequence;
+    uint8 Kind;                 // OS_XCORE_ACTIVATE or OS_XCORE_EVENT
+    TaskType Task;
+} Os_XCoreCellType;
+
+typedef struct {
+    // Ready queue (owned by the core)
+    uint32 ReadyGroupMask;                          // Bit g: ReadyBitmap[g] != 0
+    uint32 ReadyBitmap[OS_READY_GROUPS];            // Bit p: FIFO of priority 32g+p non-empty
+    uint16 ReadyHead[OS_NUM_OF_PRIORITIES];
+    uint16 ReadyTail[OS_NUM_OF_PRIORITIES];
+    Os_ActivationRecordType Record[OS_NUM_OF_ACTIVATION_RECORDS_PER_CORE];
+    uint16 FreeRecord;
+    TaskType CurrentTask;
+    // Inter-core inbox (many producers, consumed by the core). Sized by the
+    // generator to sum(OsTaskActivation) + tasks of the core, so it cannot overflow.
+    Os_XCoreCellType Inbox[OS_XCORE_INBOX_DEPTH];   // Power of two
+    atomic_uint_least32_t InboxEnqueuePos;
+    uint32 InboxDequeuePos;
+} Os_CoreStateType;
+
+static VAR(Os_CoreStateType, OS_VAR_NOINIT) Os_Core[OS_NUM_OF_CORES];
+
+static VAR(atomic_uint_least8_t, OS_VAR_NOINIT) Os_TaskActivationCount[OS_NUM_OF_TASKS];
+static VAR(atomic_uint_least32_t, OS_VAR_NOINIT) Os_TaskEvents[OS_NUM_OF_TASKS];
+static VAR(atomic_uint_least8_t, OS_VAR_NOINIT) Os_TaskEventPosted[OS_NUM_OF_TASKS];   // TRUE: event message in the inbox
+static VAR(EventMaskType, OS_VAR_NOINIT) Os_TaskWaitMask[OS_NUM_OF_TASKS];
+
+#if (OS_SIL_PORT == STD_ON)
+// One pthread per simulated core; the port sets this when the core thread starts
+_Thread_local VAR(CoreIdType, OS_VAR_NOINIT) Os_SilCoreId;
+#define Os_GetCoreIdHw()        (Os_SilCoreId)
+#else
+#define Os_GetCoreIdHw()        ((CoreIdType)(__mfcr(CPU_CORE_ID) & 0x7u))
+#endif
+
+#define Os_GetTaskCore(TaskID)  (Os_AppConfig[Os_TaskConfig[TaskID].AppRef].CoreId)
+
+FUNC(CoreIdType, OS_CODE) GetCoreID(void) {
+    return Os_GetCoreIdHw();
+}
+
+FUNC(void, OS_CODE) Os_InitCore(CoreIdType CoreId) {
+    // Called by each core during StartOS, before its scheduler runs
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[CoreId];
+    uint16 i;
+
+    Core->ReadyGroupMask = 0u;
+    for (i = 0u; i < OS_READY_GROUPS; i++) {
+        Core->ReadyBitmap[i] = 0u;
+    }
+    for (i = 0u; i < OS_NUM_OF_PRIORITIES; i++) {
+        Core->ReadyHead[i] = OS_RECORD_NIL;
+        Core->ReadyTail[i] = OS_RECORD_NIL;
+    }
+    for (i = 0u; i < OS_NUM_OF_ACTIVATION_RECORDS_PER_CORE; i++) {
+        Core->Record[i].Next = (uint16)(i + 1u);
+    }
+    Core->Record[OS_NUM_OF_ACTIVATION_RECORDS_PER_CORE - 1u].Next = OS_RECORD_NIL;
+    Core->FreeRecord = 0u;
+    Core->CurrentTask = INVALID_TASK;
+
+    for (i = 0u; i < OS_XCORE_INBOX_DEPTH; i++) {
+        atomic_init(&Core->Inbox[i].Sequence, i);
+    }
+    atomic_init(&Core->InboxEnqueuePos, 0u);
+    Core->InboxDequeuePos = 0u;
+
+    for (i = 0u; i < OS_NUM_OF_TASKS; i++) {
+        if (Os_GetTaskCore(i) == CoreId) {
+            atomic_init(&Os_TaskActivationCount[i], 0u);
+            atomic_init(&Os_TaskEvents[i], 0u);
+            atomic_init(&Os_TaskEventPosted[i], FALSE);
+            Os_TaskWaitMask[i] = 0u;
+            Os_TaskState[i] = SUSPENDED;
+        }
+    }
+}
+
+static FUNC(void, OS_CODE) Os_MarkPriorityReady(P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core, uint8 Priority) {
+    Core->ReadyBitmap[Priority / 32u] |= (uint32)1u << (Priority % 32u);
+    Core->ReadyGroupMask |= (uint32)1u << (Priority / 32u);
+}
+
+static FUNC(StatusType, OS_CODE) Os_AllocRecord(P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core, TaskType TaskID,
+                                                 P2VAR(uint16, AUTOMATIC, OS_VAR_NOINIT) Record) {
+    // Caller has OS interrupts suspended; an empty pool means the generated size is too small
+    if (Core->FreeRecord == OS_RECORD_NIL) {
+        return E_OS_LIMIT;
+    }
+    *Record = Core->FreeRecord;
+    Core->FreeRecord = Core->Record[*Record].Next;
+    Core->Record[*Record].Task = TaskID;
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) Os_InsertIntoReadyQueue(TaskType TaskID) {
+    // Append one activation at the tail of the task's priority FIFO (owning core only)
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[Os_GetTaskCore(TaskID)];
+    uint8 Priority = Os_TaskConfig[TaskID].Priority;
+    uint16 Record;
+
+    SuspendOSInterrupts();
+    if (Os_AllocRecord(Core, TaskID, &Record) != E_OK) {
+        ResumeOSInterrupts();
+        return E_OS_LIMIT;
+    }
+    Core->Record[Record].Next = OS_RECORD_NIL;
+    if (Core->ReadyTail[Priority] == OS_RECORD_NIL) {
+        Core->ReadyHead[Priority] = Record;
+    } else {
+        Core->Record[Core->ReadyTail[Priority]].Next = Record;
+    }
+    Core->ReadyTail[Priority] = Record;
+    Os_MarkPriorityReady(Core, Priority);
+    ResumeOSInterrupts();
+    return E_OK;
+}
+
+static FUNC(StatusType, OS_CODE) Os_InsertIntoReadyQueueHead(TaskType TaskID) {
+    // A preempted task is the first task of its priority to resume
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[Os_GetTaskCore(TaskID)];
+    uint8 Priority = Os_TaskConfig[TaskID].Priority;
+    uint16 Record;
+
+    SuspendOSInterrupts();
+    if (Os_AllocRecord(Core, TaskID, &Record) != E_OK) {
+        ResumeOSInterrupts();
+        return E_OS_LIMIT;
+    }
+    Core->Record[Record].Next = Core->ReadyHead[Priority];
+    if (Core->ReadyHead[Priority] == OS_RECORD_NIL) {
+        Core->ReadyTail[Priority] = Record;
+    }
+    Core->ReadyHead[Priority] = Record;
+    Os_MarkPriorityReady(Core, Priority);
+    ResumeOSInterrupts();
+    return E_OK;
+}
+
+static FUNC(sint16, OS_CODE) Os_GetHighestReadyPriority(P2CONST(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core) {
+    uint8 Group;
+
+    if (Core->ReadyGroupMask == 0u) {
+        return -1;
+    }
+    Group = (uint8)(31u - OS_CLZ32(Core->ReadyGroupMask));
+    return (sint16)((Group * 32u) + (31u - OS_CLZ32(Core->ReadyBitmap[Group])));
+}
+
+FUNC(TaskType, OS_CODE) Os_PopHighestReadyTask(CoreIdType CoreId) {
+    // Remove the head of the highest non-empty FIFO
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[CoreId];
+    sint16 Priority;
+    uint16 Record;
+    TaskType TaskID;
+
+    SuspendOSInterrupts();
+    Priority = Os_GetHighestReadyPriority(Core);
+    if (Priority < 0) {
+        ResumeOSInterrupts();
+        return INVALID_TASK;
+    }
+    Record = Core->ReadyHead[Priority];
+    TaskID = Core->Record[Record].Task;
+
+    Core->ReadyHead[Priority] = Core->Record[Record].Next;
+    if (Core->ReadyHead[Priority] == OS_RECORD_NIL) {
+        Core->ReadyTail[Priority] = OS_RECORD_NIL;
+        Core->ReadyBitmap[Priority / 32] &= ~((uint32)1u << (Priority % 32));
+        if (Core->ReadyBitmap[Priority / 32] == 0u) {
+            Core->ReadyGroupMask &= ~((uint32)1u << (Priority / 32));
+        }
+    }
+
+    Core->Record[Record].Next = Core->FreeRecord;
+    Core->FreeRecord = Record;
+    ResumeOSInterrupts();
+    return TaskID;
+}
+
+static FUNC(StatusType, OS_CODE) Os_MakeReadyIfWaitSatisfied(TaskType TaskID) {
+    // Local part of SetEvent: release a waiting task whose wait condition is met
+    StatusType Status = E_OK;
+
+    SuspendOSInterrupts();
+    if ((Os_TaskState[TaskID] == WAITING) &&
+        ((atomic_load_explicit(&Os_TaskEvents[TaskID], memory_order_acquire) & Os_TaskWaitMask[TaskID]) != 0u)) {
+        // Without a record the task keeps waiting; its events stay set for the next SetEvent
+        Status = Os_InsertIntoReadyQueue(TaskID);
+        if (Status == E_OK) {
+            Os_TaskState[TaskID] = READY;
+        }
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+static FUNC(void, OS_CODE) Os_PostCrossCore(CoreIdType CoreId, uint8 Kind, TaskType TaskID) {
+    // Multi-producer enqueue into the target core's inbox, then interrupt that core
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[CoreId];
+    P2VAR(Os_XCoreCellType, AUTOMATIC, OS_VAR_NOINIT) Cell;
+    uint32 Pos = atomic_load_explicit(&Core->InboxEnqueuePos, memory_order_relaxed);
+
+    for (;;) {
+        sint32 Diff;
+
+        Cell = &Core->Inbox[Pos & (OS_XCORE_INBOX_DEPTH - 1u)];
+        Diff = (sint32)(atomic_load_explicit(&Cell->Sequence, memory_order_acquire) - Pos);
+        if ((Diff == 0) &&
+            atomic_compare_exchange_weak_explicit(&Core->InboxEnqueuePos, &Pos, Pos + 1u,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+        if (Diff != 0) {
+            Pos = atomic_load_explicit(&Core->InboxEnqueuePos, memory_order_relaxed);
+        }
+    }
+
+    Cell->Kind = Kind;
+    Cell->Task = TaskID;
+    atomic_store_explicit(&Cell->Sequence, Pos + 1u, memory_order_release);
+    Os_Port_SignalCore(CoreId);
+}
+
+FUNC(void, OS_CODE) Os_ProcessCrossCoreRequests(CoreIdType CoreId) {
+    // Drain the inbox on the owning core (scheduling points and the inter-core interrupt)
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[CoreId];
+
+    for (;;) {
+        P2VAR(Os_XCoreCellType, AUTOMATIC, OS_VAR_NOINIT) Cell;
+        uint8 Kind;
+        TaskType TaskID;
+
+        // Task level and the inter-core interrupt both drain: one message per suspended section
+        SuspendOSInterrupts();
+        Cell = &Core->Inbox[Core->InboxDequeuePos & (OS_XCORE_INBOX_DEPTH - 1u)];
+        if ((sint32)(atomic_load_explicit(&Cell->Sequence, memory_order_acquire) - (Core->InboxDequeuePos + 1u)) < 0) {
+            ResumeOSInterrupts();
+            break;
+        }
+        Kind = Cell->Kind;
+        TaskID = Cell->Task;
+        atomic_store_explicit(&Cell->Sequence, Core->InboxDequeuePos + OS_XCORE_INBOX_DEPTH, memory_order_release);
+        Core->InboxDequeuePos++;
+
+        if (Kind == OS_XCORE_ACTIVATE) {
+            if (Os_InsertIntoReadyQueue(TaskID) == E_OK) {
+                if (Os_TaskState[TaskID] == SUSPENDED) {
+                    Os_TaskState[TaskID] = READY;
+                }
+            } else {
+                // Give back the activation the remote caller reserved
+                (void)atomic_fetch_sub_explicit(&Os_TaskActivationCount[TaskID], 1u, memory_order_acq_rel);
+            }
+        } else {
+            /* An RMW, unlike a plain clear, is ordered with the poster's exchange:
+             * either the poster sees FALSE and posts again, or this exchange reads
+             * its TRUE and the event load below sees the bits it set before. */
+            (void)atomic_exchange_explicit(&Os_TaskEventPosted[TaskID], FALSE, memory_order_acq_rel);
+            (void)Os_MakeReadyIfWaitSatisfied(TaskID);
+        }
+        ResumeOSInterrupts();
+    }
+}
+
+FUNC(void, OS_CODE) Os_Dispatch(void) {
+    // Scheduling point: switch if a higher-priority task is ready (or the CPU is free)
+    CoreIdType CoreId = Os_GetCoreIdHw();
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[CoreId];
+    TaskType Previous = Core->CurrentTask;
+    TaskType Next;
+    sint16 Highest;
+
+    Os_ProcessCrossCoreRequests(CoreId);
+    SuspendOSInterrupts();
+    Highest = Os_GetHighestReadyPriority(Core);
+    if (Highest < 0) {
+        ResumeOSInterrupts();
+        return;
+    }
+    if ((Previous != INVALID_TASK) && (Os_TaskState[Previous] == RUNNING) &&
+        (Highest <= (sint16)Os_TaskConfig[Previous].Priority)) {
+        ResumeOSInterrupts();
+        return;
+    }
+
+    // Pop first: the record it frees guarantees room for the preempted task
+    Next = Os_PopHighestReadyTask(CoreId);
+    if ((Previous != INVALID_TASK) && (Os_TaskState[Previous] == RUNNING)) {
+        Os_TaskState[Previous] = READY;
+        (void)Os_InsertIntoReadyQueueHead(Previous);
+    }
+    Os_TaskState[Next] = RUNNING;
+    Core->CurrentTask = Next;
+    ResumeOSInterrupts();
+    Os_SwitchContext(Previous, Next);
+}
+
+static FUNC(StatusType, OS_CODE) Os_ActivateTaskNoDispatch(TaskType TaskID) {
+    // Queued activations up to OsTaskActivation, any core; the caller decides when to dispatch
+    CoreIdType TargetCore = Os_GetTaskCore(TaskID);
+    uint8 Count = atomic_load_explicit(&Os_TaskActivationCount[TaskID], memory_order_relaxed);
+    
+    // Reserve the activation atomically so E_OS_LIMIT is reported synchronously across cores
+    do {
+        if (Count >= Os_TaskConfig[TaskID].MaxActivations) {
+            return E_OS_LIMIT;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&Os_TaskActivationCount[TaskID], &Count, (uint8)(Count + 1u),
+                                                    memory_order_acq_rel, memory_order_relaxed));
+    
+    if (TargetCore != Os_GetCoreIdHw()) {
+        Os_PostCrossCore(TargetCore, OS_XCORE_ACTIVATE, TaskID);
+        return E_OK;
+    }
+    
+    SuspendOSInterrupts();
+    if (Os_InsertIntoReadyQueue(TaskID) != E_OK) {
+        ResumeOSInterrupts();
+        (void)atomic_fetch_sub_explicit(&Os_TaskActivationCount[TaskID], 1u, memory_order_acq_rel);
+        return E_OS_LIMIT;
+    }
+    if (Os_TaskState[TaskID] == SUSPENDED) {
+        Os_TaskState[TaskID] = READY;
+    }
+    ResumeOSInterrupts();
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) ActivateTask(TaskType TaskID) {
+    // Step 24: Operating System
+    // Schedule door control task
+    StatusType Status = Os_ActivateTaskNoDispatch(TaskID);
+    
+    if (Status == E_OK) {
+        Os_Dispatch();
+    }
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) TerminateTask(void) {
+    // Remaining activations are already queued in the task's priority FIFO
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[Os_GetCoreIdHw()];
+    TaskType TaskID = Core->CurrentTask;
+    
+    Os_TaskState[TaskID] = (atomic_fetch_sub_explicit(&Os_TaskActivationCount[TaskID], 1u, memory_order_acq_rel) > 1u) ? READY : SUSPENDED;
+    atomic_store_explicit(&Os_TaskEvents[TaskID], 0u, memory_order_relaxed);
+    Core->CurrentTask = INVALID_TASK;
+    Os_Dispatch();
+    return E_OK;
+}
+
+static FUNC(StatusType, OS_CODE) Os_SetEventNoDispatch(TaskType TaskID, EventMaskType Mask) {
+    // Events are set atomically by the caller; the owning core re-evaluates the wait
+    CoreIdType TargetCore = Os_GetTaskCore(TaskID);
+    
+    if (Os_TaskState[TaskID] == SUSPENDED) {
+        return E_OS_STATE;
+    }
+    (void)atomic_fetch_or_explicit(&Os_TaskEvents[TaskID], Mask, memory_order_acq_rel);
+    
+    if (TargetCore != Os_GetCoreIdHw()) {
+        // At most one message in flight per task: later SetEvents only add bits
+        if (atomic_exchange_explicit(&Os_TaskEventPosted[TaskID], TRUE, memory_order_acq_rel) == FALSE) {
+            Os_PostCrossCore(TargetCore, OS_XCORE_EVENT, TaskID);
+        }
+        return E_OK;
+    }
+    
+    return Os_MakeReadyIfWaitSatisfied(TaskID);
+}
+
+FUNC(StatusType, OS_CODE) SetEvent(TaskType TaskID, EventMaskType Mask) {
+    StatusType Status = Os_SetEventNoDispatch(TaskID, Mask);
+    
+    if (Status == E_OK) {
+        Os_Dispatch();
+    }
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) WaitEvent(EventMaskType Mask) {
+    P2VAR(Os_CoreStateType, AUTOMATIC, OS_VAR_NOINIT) Core = &Os_Core[Os_GetCoreIdHw()];
+    TaskType TaskID = Core->CurrentTask;
+    
+    Os_TaskWaitMask[TaskID] = Mask;
+    if ((atomic_load_explicit(&Os_TaskEvents[TaskID], memory_order_acquire) & Mask) == 0u) {
+        Os_TaskState[TaskID] = WAITING;
+        Core->CurrentTask = INVALID_TASK;
+        Os_Dispatch();
+    }
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) GetEvent(TaskType TaskID, P2VAR(EventMaskType, AUTOMATIC, OS_APPL_DATA) Event) {
+    *Event = atomic_load_explicit(&Os_TaskEvents[TaskID], memory_order_acquire);
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) ClearEvent(EventMaskType Mask) {
+    TaskType TaskID = Os_Core[Os_GetCoreIdHw()].CurrentTask;
+    
+    (void)atomic_fetch_and_explicit(&Os_TaskEvents[TaskID], ~Mask, memory_order_acq_rel);
+    return E_OK;
+}
+
+/* Counters and alarms: every counter keeps its alarms in a hierarchical timing
+ * wheel of OS_ALARM_WHEEL_LEVELS x 64 slots. Level L holds alarms due within
+ * 64^(L+1) ticks, bucketed by bits [6L, 6L+6) of their expiry tick. A tick
+ * expires exactly the alarms of one level-0 slot; every 64^L ticks one level-L
+ * slot is redistributed into the levels below. Each alarm is moved at most
+ * OS_ALARM_WHEEL_LEVELS - 1 times, so expiry is O(1) amortized per alarm and a
+ * tick never scans the alarms that are not due.
+ * A counter and its alarms belong to one core; alarm services run there. */
+#define OS_ALARM_WHEEL_BITS     6u
+#define OS_ALARM_WHEEL_SLOTS    (1u << OS_ALARM_WHEEL_BITS)
+#define OS_ALARM_WHEEL_LEVELS   6u          // 36 bits >= MaxAllowedValue + 1 of a 32-bit TickType
+#define OS_ALARM_NIL            0xFFFFu
+#define OS_ALARM_INACTIVE       0xFFFFu
+
+typedef struct {
+    uint64 Now;                 // Monotonic tick count, never wraps
+    TickType Value;             // Counter value visible to the application, wraps at MaxAllowedValue
+    uint16 Wheel[OS_ALARM_WHEEL_LEVELS][OS_ALARM_WHEEL_SLOTS];
+} Os_CounterStateType;
+
+static VAR(Os_CounterStateType, OS_VAR_NOINIT) Os_Counter[OS_NUM_OF_COUNTERS];
+
+static VAR(uint64, OS_VAR_NOINIT) Os_AlarmExpiry[OS_NUM_OF_ALARMS];     // In Os_Counter[].Now ticks
+static VAR(TickType, OS_VAR_NOINIT) Os_AlarmCycle[OS_NUM_OF_ALARMS];    // 0: single-shot
+static VAR(uint16, OS_VAR_NOINIT) Os_AlarmSlot[OS_NUM_OF_ALARMS];       // Level * 64 + slot, or OS_ALARM_INACTIVE
+static VAR(uint16, OS_VAR_NOINIT) Os_AlarmNext[OS_NUM_OF_ALARMS];
+static VAR(uint16, OS_VAR_NOINIT) Os_AlarmPrev[OS_NUM_OF_ALARMS];
+
+static FUNC(void, OS_CODE) Os_CounterTick(CounterType CounterID);
+static FUNC(void, OS_CODE) Os_ScheduleTableExpire(ScheduleTableType ScheduleTableID);
+static FUNC(void, OS_CODE) Os_InitScheduleTables(CoreIdType CoreId);
+
+FUNC(void, OS_CODE) Os_InitCounters(CoreIdType CoreId) {
+    // Called by each core during StartOS, after Os_InitCore
+    CounterType CounterID;
+    AlarmType AlarmID;
+    uint16 i;
+
+    for (CounterID = 0u; CounterID < OS_NUM_OF_COUNTERS; CounterID++) {
+        if (Os_CounterConfig[CounterID].CoreId == CoreId) {
+            Os_Counter[CounterID].Now = 0u;
+            Os_Counter[CounterID].Value = 0u;
+            for (i = 0u; i < (OS_ALARM_WHEEL_LEVELS * OS_ALARM_WHEEL_SLOTS); i++) {
+                Os_Counter[CounterID].Wheel[i / OS_ALARM_WHEEL_SLOTS][i % OS_ALARM_WHEEL_SLOTS] = OS_ALARM_NIL;
+            }
+        }
+    }
+    for (AlarmID = 0u; AlarmID < OS_NUM_OF_ALARMS; AlarmID++) {
+        if (Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef].CoreId == CoreId) {
+            Os_AlarmSlot[AlarmID] = OS_ALARM_INACTIVE;
+        }
+    }
+    Os_InitScheduleTables(CoreId);
+}
+
+static FUNC(void, OS_CODE) Os_AlarmLink(P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter, AlarmType AlarmID) {
+    // File the alarm under the lowest level whose span covers its remaining delay
+    uint64 Delta = Os_AlarmExpiry[AlarmID] - Counter->Now;     // >= 1
+    uint8 Level = 0u;
+    uint16 Slot;
+    uint16 Head;
+
+    while ((Level < (OS_ALARM_WHEEL_LEVELS - 1u)) &&
+           (Delta >= ((uint64)1u << (OS_ALARM_WHEEL_BITS * (Level + 1u))))) {
+        Level++;
+    }
+    Slot = (uint16)((Os_AlarmExpiry[AlarmID] >> (OS_ALARM_WHEEL_BITS * Level)) & (OS_ALARM_WHEEL_SLOTS - 1u));
+    Head = Counter->Wheel[Level][Slot];
+
+    Os_AlarmPrev[AlarmID] = OS_ALARM_NIL;
+    Os_AlarmNext[AlarmID] = Head;
+    if (Head != OS_ALARM_NIL) {
+        Os_AlarmPrev[Head] = AlarmID;
+    }
+    Counter->Wheel[Level][Slot] = AlarmID;
+    Os_AlarmSlot[AlarmID] = (uint16)((Level * OS_ALARM_WHEEL_SLOTS) + Slot);
+}
+
+static FUNC(void, OS_CODE) Os_AlarmUnlink(P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter, AlarmType AlarmID) {
+    uint16 Slot = Os_AlarmSlot[AlarmID];
+
+    if (Os_AlarmPrev[AlarmID] == OS_ALARM_NIL) {
+        Counter->Wheel[Slot / OS_ALARM_WHEEL_SLOTS][Slot % OS_ALARM_WHEEL_SLOTS] = Os_AlarmNext[AlarmID];
+    } else {
+        Os_AlarmNext[Os_AlarmPrev[AlarmID]] = Os_AlarmNext[AlarmID];
+    }
+    if (Os_AlarmNext[AlarmID] != OS_ALARM_NIL) {
+        Os_AlarmPrev[Os_AlarmNext[AlarmID]] = Os_AlarmPrev[AlarmID];
+    }
+    Os_AlarmSlot[AlarmID] = OS_ALARM_INACTIVE;
+}
+
+static FUNC(void, OS_CODE) Os_AlarmExpire(P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter, AlarmType AlarmID) {
+    // Re-arm before the action so a callback sees the alarm in its final state
+    P2CONST(Os_AlarmConfigType, AUTOMATIC, OS_CONST) Alarm = &Os_AlarmConfig[AlarmID];
+
+    if (Os_AlarmCycle[AlarmID] != 0u) {
+        Os_AlarmExpiry[AlarmID] += Os_AlarmCycle[AlarmID];
+        Os_AlarmLink(Counter, AlarmID);
+    }
+
+    switch (Alarm->Action) {
+    case OS_ALARM_ACTION_ACTIVATETASK:
+        (void)Os_ActivateTaskNoDispatch(Alarm->Task);
+        break;
+    case OS_ALARM_ACTION_SETEVENT:
+        (void)Os_SetEventNoDispatch(Alarm->Task, Alarm->Event);
+        break;
+    case OS_ALARM_ACTION_CALLBACK:
+        Alarm->Callback();
+        break;
+    case OS_ALARM_ACTION_INCREMENTCOUNTER:
+        Os_CounterTick(Alarm->Counter);
+        break;
+    case OS_ALARM_ACTION_SCHEDULETABLE:
+        // Internal alarm that drives a schedule table from one expiry point to the next
+        Os_ScheduleTableExpire(Alarm->ScheduleTable);
+        break;
+    default:
+        break;
+    }
+}
+
+static FUNC(void, OS_CODE) Os_CounterTick(CounterType CounterID) {
+    P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter = &Os_Counter[CounterID];
+    uint16 Slot;
+    uint8 Level;
+
+    Counter->Now++;
+    Counter->Value = (Counter->Value == Os_CounterConfig[CounterID].MaxAllowedValue) ? 0u : (TickType)(Counter->Value + 1u);
+    Slot = (uint16)(Counter->Now & (OS_ALARM_WHEEL_SLOTS - 1u));
+
+    // Level L is redistributed each time the digits of all levels below it roll over
+    for (Level = 1u; (Level < OS_ALARM_WHEEL_LEVELS) &&
+                     (((Counter->Now >> (OS_ALARM_WHEEL_BITS * (Level - 1u))) & (OS_ALARM_WHEEL_SLOTS - 1u)) == 0u); Level++) {
+        uint16 Cascade = (uint16)((Counter->Now >> (OS_ALARM_WHEEL_BITS * Level)) & (OS_ALARM_WHEEL_SLOTS - 1u));
+        uint16 AlarmID = Counter->Wheel[Level][Cascade];
+
+        Counter->Wheel[Level][Cascade] = OS_ALARM_NIL;
+        while (AlarmID != OS_ALARM_NIL) {
+            uint16 Next = Os_AlarmNext[AlarmID];
+
+            Os_AlarmLink(Counter, AlarmID);     // Lands strictly below Level
+            AlarmID = Next;
+        }
+    }
+
+    // Everything in the current level-0 slot is due now; a cyclic re-arm lands in another slot
+    while (Counter->Wheel[0][Slot] != OS_ALARM_NIL) {
+        AlarmType AlarmID = Counter->Wheel[0][Slot];
+
+        Os_AlarmUnlink(Counter, AlarmID);
+        Os_AlarmExpire(Counter, AlarmID);
+    }
+}
+
+FUNC(StatusType, OS_CODE) IncrementCounter(CounterType CounterID) {
+    // Software counters; hardware counters are ticked the same way from their timer ISR
+    if (CounterID >= OS_NUM_OF_COUNTERS) {
+        return E_OS_ID;
+    }
+    SuspendOSInterrupts();
+    Os_CounterTick(CounterID);
+    ResumeOSInterrupts();
+    Os_Dispatch();
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) GetAlarmBase(AlarmType AlarmID, AlarmBaseRefType Info) {
+    P2CONST(Os_CounterConfigType, AUTOMATIC, OS_CONST) CounterConfig;
+
+    if (AlarmID >= OS_NUM_OF_ALARMS) {
+        return E_OS_ID;
+    }
+    CounterConfig = &Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef];
+    Info->maxallowedvalue = CounterConfig->MaxAllowedValue;
+    Info->ticksperbase = CounterConfig->TicksPerBase;
+    Info->mincycle = CounterConfig->MinCycle;
+    return E_OK;
+}
+
+FUNC(StatusType, OS_CODE) GetAlarm(AlarmType AlarmID, TickRefType Tick) {
+    StatusType Status = E_OK;
+
+    if (AlarmID >= OS_NUM_OF_ALARMS) {
+        return E_OS_ID;
+    }
+    SuspendOSInterrupts();
+    if (Os_AlarmSlot[AlarmID] == OS_ALARM_INACTIVE) {
+        Status = E_OS_NOFUNC;
+    } else {
+        *Tick = (TickType)(Os_AlarmExpiry[AlarmID] - Os_Counter[Os_AlarmConfig[AlarmID].CounterRef].Now);
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+static FUNC(StatusType, OS_CODE) Os_ArmAlarm(AlarmType AlarmID, uint64 Delta, TickType Cycle) {
+    // Common part of SetRelAlarm/SetAbsAlarm; Delta is already range checked
+    P2CONST(Os_CounterConfigType, AUTOMATIC, OS_CONST) CounterConfig = &Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef];
+    P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter = &Os_Counter[Os_AlarmConfig[AlarmID].CounterRef];
+    StatusType Status = E_OK;
+
+    if ((Cycle != 0u) && ((Cycle < CounterConfig->MinCycle) || (Cycle > CounterConfig->MaxAllowedValue))) {
+        return E_OS_VALUE;
+    }
+    SuspendOSInterrupts();
+    if (Os_AlarmSlot[AlarmID] != OS_ALARM_INACTIVE) {
+        Status = E_OS_STATE;
+    } else {
+        Os_AlarmExpiry[AlarmID] = Counter->Now + Delta;
+        Os_AlarmCycle[AlarmID] = Cycle;
+        Os_AlarmLink(Counter, AlarmID);
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) SetRelAlarm(AlarmType AlarmID, TickType increment, TickType cycle) {
+    if (AlarmID >= OS_NUM_OF_ALARMS) {
+        return E_OS_ID;
+    }
+    if ((increment == 0u) || (increment > Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef].MaxAllowedValue)) {
+        return E_OS_VALUE;
+    }
+    return Os_ArmAlarm(AlarmID, increment, cycle);
+}
+
+FUNC(StatusType, OS_CODE) SetAbsAlarm(AlarmType AlarmID, TickType start, TickType cycle) {
+    // A start value equal to the current counter value expires after one full counter revolution
+    TickType MaxAllowedValue;
+    TickType Value;
+    uint64 Delta;
+
+    if (AlarmID >= OS_NUM_OF_ALARMS) {
+        return E_OS_ID;
+    }
+    MaxAllowedValue = Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef].MaxAllowedValue;
+    if (start > MaxAllowedValue) {
+        return E_OS_VALUE;
+    }
+    Value = Os_Counter[Os_AlarmConfig[AlarmID].CounterRef].Value;
+    Delta = (start > Value) ? (uint64)(start - Value) : ((uint64)MaxAllowedValue + 1u - (uint64)(Value - start));
+    return Os_ArmAlarm(AlarmID, Delta, cycle);
+}
+
+FUNC(StatusType, OS_CODE) CancelAlarm(AlarmType AlarmID) {
+    StatusType Status = E_OK;
+
+    if (AlarmID >= OS_NUM_OF_ALARMS) {
+        return E_OS_ID;
+    }
+    SuspendOSInterrupts();
+    if (Os_AlarmSlot[AlarmID] == OS_ALARM_INACTIVE) {
+        Status = E_OS_NOFUNC;
+    } else {
+        Os_AlarmUnlink(&Os_Counter[Os_AlarmConfig[AlarmID].CounterRef], AlarmID);
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+/* Schedule tables: each table owns one internal alarm on its counter (generated
+ * with OS_ALARM_ACTION_SCHEDULETABLE) that is re-armed with the delay to the
+ * next expiry point, so tables share the timing wheel with ordinary alarms.
+ * Explicit synchronization records the deviation from the synchronization
+ * counter; each expiry point then corrects the following delay by at most its
+ * OsScheduleTblMaxRetard / OsScheduleTblMaxAdvance. */
+#define OS_SCHEDULETABLE_NONE   0xFFFFu
+
+typedef struct {
+    ScheduleTableStatusType Status;
+    uint16 NextExpiryPoint;         // Index within the table; NumExpiryPoints: final delay running
+    ScheduleTableType NextTable;    // Set by NextScheduleTable, started when this table ends
+    sint32 Deviation;               // Table position minus synchronization counter, > 0: table is ahead
+} Os_ScheduleTableStateType;
+
+static VAR(Os_ScheduleTableStateType, OS_VAR_NOINIT) Os_ScheduleTable[OS_NUM_OF_SCHEDULE_TABLES];
+
+static FUNC(void, OS_CODE) Os_InitScheduleTables(CoreIdType CoreId) {
+    ScheduleTableType ScheduleTableID;
+
+    for (ScheduleTableID = 0u; ScheduleTableID < OS_NUM_OF_SCHEDULE_TABLES; ScheduleTableID++) {
+        AlarmType AlarmID = Os_ScheduleTableConfig[ScheduleTableID].AlarmRef;
+
+        if (Os_CounterConfig[Os_AlarmConfig[AlarmID].CounterRef].CoreId == CoreId) {
+            Os_ScheduleTable[ScheduleTableID].Status = SCHEDULETABLE_STOPPED;
+            Os_ScheduleTable[ScheduleTableID].NextTable = OS_SCHEDULETABLE_NONE;
+            Os_ScheduleTable[ScheduleTableID].Deviation = 0;
+        }
+    }
+}
+
+static FUNC(void, OS_CODE) Os_ScheduleTableArm(ScheduleTableType ScheduleTableID, uint64 Delta) {
+    AlarmType AlarmID = Os_ScheduleTableConfig[ScheduleTableID].AlarmRef;
+    P2VAR(Os_CounterStateType, AUTOMATIC, OS_VAR_NOINIT) Counter = &Os_Counter[Os_AlarmConfig[AlarmID].CounterRef];
+
+    Os_AlarmExpiry[AlarmID] = Counter->Now + Delta;
+    Os_AlarmCycle[AlarmID] = 0u;
+    Os_AlarmLink(Counter, AlarmID);
+}
+
+static FUNC(uint64, OS_CODE) Os_ScheduleTableAdjust(ScheduleTableType ScheduleTableID,
+                                                   P2CONST(Os_ExpiryPointConfigType, AUTOMATIC, OS_CONST) ExpiryPoint,
+                                                   uint64 Delay) {
+    // Spend part of the recorded deviation on the delay to the next expiry point
+    P2CONST(Os_ScheduleTableConfigType, AUTOMATIC, OS_CONST) Config = &Os_ScheduleTableConfig[ScheduleTableID];
+    P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) State = &Os_ScheduleTable[ScheduleTableID];
+    uint32 Adjust;
+
+    if (State->Deviation > 0) {
+        // Ahead of the synchronization counter: wait longer
+        Adjust = ((uint32)State->Deviation < ExpiryPoint->MaxAdvance) ? (uint32)State->Deviation : ExpiryPoint->MaxAdvance;
+        Delay += Adjust;
+        State->Deviation -= (sint32)Adjust;
+    } else if (State->Deviation < 0) {
+        // Behind: fire earlier, but never in the past
+        Adjust = ((uint32)(-State->Deviation) < ExpiryPoint->MaxRetard) ? (uint32)(-State->Deviation) : ExpiryPoint->MaxRetard;
+        if ((uint64)Adjust >= Delay) {
+            // Keep at least one tick; a zero delay (same-tick expiry point) cannot fire earlier
+            Adjust = (Delay > 0u) ? (uint32)(Delay - 1u) : 0u;
+        }
+        Delay -= Adjust;
+        State->Deviation += (sint32)Adjust;
+    } else {
+        // In sync, nothing to correct
+    }
+
+    if (Config->SyncStrategy == OS_SCHEDULETABLE_SYNC_EXPLICIT) {
+        State->Status = (((State->Deviation < 0) ? (uint32)(-State->Deviation) : (uint32)State->Deviation) <= Config->Precision)
+                        ? SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS : SCHEDULETABLE_RUNNING;
+    }
+    return Delay;
+}
+
+static FUNC(void, OS_CODE) Os_ScheduleTableExpire(ScheduleTableType ScheduleTableID) {
+    // Process the due expiry point (or the end of the final delay), then arm the next delay.
+    // Zero delays (expiry point at offset 0, final delay 0) are processed in the same tick.
+    for (;;) {
+        P2CONST(Os_ScheduleTableConfigType, AUTOMATIC, OS_CONST) Config = &Os_ScheduleTableConfig[ScheduleTableID];
+        P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) State = &Os_ScheduleTable[ScheduleTableID];
+        P2CONST(Os_ExpiryPointConfigType, AUTOMATIC, OS_CONST) ExpiryPoint = &Os_ExpiryPointConfig[Config->FirstExpiryPoint];
+        uint64 Delay;
+
+        if (State->NextExpiryPoint == Config->NumExpiryPoints) {
+            ScheduleTableType NextTable = State->NextTable;
+
+            if ((NextTable != OS_SCHEDULETABLE_NONE) && (Os_ScheduleTable[NextTable].Status == SCHEDULETABLE_NEXT)) {
+                State->Status = SCHEDULETABLE_STOPPED;
+                State->NextTable = OS_SCHEDULETABLE_NONE;
+                ScheduleTableID = NextTable;
+                Config = &Os_ScheduleTableConfig[ScheduleTableID];
+                State = &Os_ScheduleTable[ScheduleTableID];
+                State->Status = SCHEDULETABLE_RUNNING;
+                State->Deviation = 0;
+            } else if (Config->Repeating == TRUE) {
+                State->NextTable = OS_SCHEDULETABLE_NONE;
+            } else {
+                State->Status = SCHEDULETABLE_STOPPED;
+                State->NextTable = OS_SCHEDULETABLE_NONE;
+                return;
+            }
+            State->NextExpiryPoint = 0u;
+            Delay = Os_ExpiryPointConfig[Config->FirstExpiryPoint].Offset;
+        } else {
+            uint16 Action;
+
+            ExpiryPoint = &ExpiryPoint[State->NextExpiryPoint];
+            for (Action = ExpiryPoint->FirstAction; Action < (ExpiryPoint->FirstAction + ExpiryPoint->NumActions); Action++) {
+                P2CONST(Os_ExpiryActionConfigType, AUTOMATIC, OS_CONST) Expiry = &Os_ExpiryActionConfig[Action];
+
+                if (Expiry->Action == OS_ALARM_ACTION_SETEVENT) {
+                    (void)Os_SetEventNoDispatch(Expiry->Task, Expiry->Event);
+                } else {
+                    (void)Os_ActivateTaskNoDispatch(Expiry->Task);
+                }
+            }
+            State->NextExpiryPoint++;
+            Delay = ((State->NextExpiryPoint < Config->NumExpiryPoints)
+                     ? Os_ExpiryPointConfig[Config->FirstExpiryPoint + State->NextExpiryPoint].Offset
+                     : Config->Duration) - ExpiryPoint->Offset;
+            Delay = Os_ScheduleTableAdjust(ScheduleTableID, ExpiryPoint, Delay);
+        }
+
+        if (Delay != 0u) {
+            Os_ScheduleTableArm(ScheduleTableID, Delay);
+            return;
+        }
+    }
+}
+
+static FUNC(void, OS_CODE) Os_ScheduleTableStart(ScheduleTableType ScheduleTableID, uint64 Delta, ScheduleTableStatusType Status) {
+    // Delta: ticks from now until the table's offset 0
+    P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) State = &Os_ScheduleTable[ScheduleTableID];
+    P2CONST(Os_ScheduleTableConfigType, AUTOMATIC, OS_CONST) Config = &Os_ScheduleTableConfig[ScheduleTableID];
+
+    State->Status = Status;
+    State->NextExpiryPoint = 0u;
+    State->NextTable = OS_SCHEDULETABLE_NONE;
+    State->Deviation = 0;
+    Os_ScheduleTableArm(ScheduleTableID, Delta + Os_ExpiryPointConfig[Config->FirstExpiryPoint].Offset);
+}
+
+FUNC(StatusType, OS_CODE) StartScheduleTableRel(ScheduleTableType ScheduleTableID, TickType Offset) {
+    StatusType Status = E_OK;
+    TickType MaxAllowedValue;
+
+    if (ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) {
+        return E_OS_ID;
+    }
+    if (Os_ScheduleTableConfig[ScheduleTableID].SyncStrategy == OS_SCHEDULETABLE_SYNC_IMPLICIT) {
+        return E_OS_ID;
+    }
+    MaxAllowedValue = Os_CounterConfig[Os_AlarmConfig[Os_ScheduleTableConfig[ScheduleTableID].AlarmRef].CounterRef].MaxAllowedValue;
+    if ((Offset == 0u) ||
+        (Offset > (MaxAllowedValue - Os_ExpiryPointConfig[Os_ScheduleTableConfig[ScheduleTableID].FirstExpiryPoint].Offset))) {
+        return E_OS_VALUE;
+    }
+    SuspendOSInterrupts();
+    if (Os_ScheduleTable[ScheduleTableID].Status != SCHEDULETABLE_STOPPED) {
+        Status = E_OS_STATE;
+    } else {
+        Os_ScheduleTableStart(ScheduleTableID, Offset, SCHEDULETABLE_RUNNING);
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) StartScheduleTableAbs(ScheduleTableType ScheduleTableID, TickType Start) {
+    // Offset 0 of the table is reached when the counter next equals Start
+    StatusType Status = E_OK;
+    CounterType CounterID;
+    TickType MaxAllowedValue;
+    TickType Value;
+
+    if (ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) {
+        return E_OS_ID;
+    }
+    CounterID = Os_AlarmConfig[Os_ScheduleTableConfig[ScheduleTableID].AlarmRef].CounterRef;
+    MaxAllowedValue = Os_CounterConfig[CounterID].MaxAllowedValue;
+    if (Start > MaxAllowedValue) {
+        return E_OS_VALUE;
+    }
+    SuspendOSInterrupts();
+    if (Os_ScheduleTable[ScheduleTableID].Status != SCHEDULETABLE_STOPPED) {
+        Status = E_OS_STATE;
+    } else {
+        Value = Os_Counter[CounterID].Value;
+        Os_ScheduleTableStart(ScheduleTableID,
+                              (Start > Value) ? (uint64)(Start - Value) : ((uint64)MaxAllowedValue + 1u - (uint64)(Value - Start)),
+                              (Os_ScheduleTableConfig[ScheduleTableID].SyncStrategy == OS_SCHEDULETABLE_SYNC_IMPLICIT)
+                              ? SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS : SCHEDULETABLE_RUNNING);
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) StartScheduleTableSynchron(ScheduleTableType ScheduleTableID) {
+    // The table waits for the first SyncScheduleTable to learn its position
+    StatusType Status = E_OK;
+
+    if ((ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) ||
+        (Os_ScheduleTableConfig[ScheduleTableID].SyncStrategy != OS_SCHEDULETABLE_SYNC_EXPLICIT)) {
+        return E_OS_ID;
+    }
+    SuspendOSInterrupts();
+    if (Os_ScheduleTable[ScheduleTableID].Status != SCHEDULETABLE_STOPPED) {
+        Status = E_OS_STATE;
+    } else {
+        Os_ScheduleTable[ScheduleTableID].Status = SCHEDULETABLE_WAITING;
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) StopScheduleTable(ScheduleTableType ScheduleTableID) {
+    P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) State;
+    AlarmType AlarmID;
+    StatusType Status = E_OK;
+
+    if (ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) {
+        return E_OS_ID;
+    }
+    State = &Os_ScheduleTable[ScheduleTableID];
+    AlarmID = Os_ScheduleTableConfig[ScheduleTableID].AlarmRef;
+    SuspendOSInterrupts();
+    if ((State->Status == SCHEDULETABLE_STOPPED) || (State->Status == SCHEDULETABLE_NEXT)) {
+        Status = E_OS_NOFUNC;
+    } else {
+        if (Os_AlarmSlot[AlarmID] != OS_ALARM_INACTIVE) {
+            Os_AlarmUnlink(&Os_Counter[Os_AlarmConfig[AlarmID].CounterRef], AlarmID);
+        }
+        if (State->NextTable != OS_SCHEDULETABLE_NONE) {
+            Os_ScheduleTable[State->NextTable].Status = SCHEDULETABLE_STOPPED;
+            State->NextTable = OS_SCHEDULETABLE_NONE;
+        }
+        State->Status = SCHEDULETABLE_STOPPED;
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) NextScheduleTable(ScheduleTableType ScheduleTableID_From, ScheduleTableType ScheduleTableID_To) {
+    // ScheduleTableID_To starts when the final delay of ScheduleTableID_From has elapsed
+    P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) From;
+    StatusType Status = E_OK;
+
+    if ((ScheduleTableID_From >= OS_NUM_OF_SCHEDULE_TABLES) || (ScheduleTableID_To >= OS_NUM_OF_SCHEDULE_TABLES) ||
+        (Os_AlarmConfig[Os_ScheduleTableConfig[ScheduleTableID_From].AlarmRef].CounterRef !=
+         Os_AlarmConfig[Os_ScheduleTableConfig[ScheduleTableID_To].AlarmRef].CounterRef)) {
+        return E_OS_ID;
+    }
+    From = &Os_ScheduleTable[ScheduleTableID_From];
+    SuspendOSInterrupts();
+    if ((From->Status == SCHEDULETABLE_STOPPED) || (From->Status == SCHEDULETABLE_NEXT)) {
+        Status = E_OS_NOFUNC;
+    } else if (Os_ScheduleTable[ScheduleTableID_To].Status != SCHEDULETABLE_STOPPED) {
+        Status = E_OS_STATE;
+    } else {
+        if (From->NextTable != OS_SCHEDULETABLE_NONE) {
+            Os_ScheduleTable[From->NextTable].Status = SCHEDULETABLE_STOPPED;
+        }
+        From->NextTable = ScheduleTableID_To;
+        Os_ScheduleTable[ScheduleTableID_To].Status = SCHEDULETABLE_NEXT;
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) SyncScheduleTable(ScheduleTableType ScheduleTableID, TickType Value) {
+    // Value: position of the synchronization counter within the table duration
+    P2CONST(Os_ScheduleTableConfigType, AUTOMATIC, OS_CONST) Config;
+    P2VAR(Os_ScheduleTableStateType, AUTOMATIC, OS_VAR_NOINIT) State;
+    AlarmType AlarmID;
+    StatusType Status = E_OK;
+
+    if ((ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) ||
+        (Os_ScheduleTableConfig[ScheduleTableID].SyncStrategy != OS_SCHEDULETABLE_SYNC_EXPLICIT)) {
+        return E_OS_ID;
+    }
+    Config = &Os_ScheduleTableConfig[ScheduleTableID];
+    State = &Os_ScheduleTable[ScheduleTableID];
+    AlarmID = Config->AlarmRef;
+    if (Value >= Config->Duration) {
+        return E_OS_VALUE;
+    }
+    SuspendOSInterrupts();
+    if ((State->Status == SCHEDULETABLE_STOPPED) || (State->Status == SCHEDULETABLE_NEXT)) {
+        Status = E_OS_STATE;
+    } else if (State->Status == SCHEDULETABLE_WAITING) {
+        // Start so that offset 0 coincides with the synchronization counter's next wrap
+        Os_ScheduleTableStart(ScheduleTableID, (uint64)(Config->Duration - Value), SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS);
+    } else {
+        // Current position = offset being waited for minus the ticks still to go
+        sint64 Target = (State->NextExpiryPoint < Config->NumExpiryPoints)
+                        ? (sint64)Os_ExpiryPointConfig[Config->FirstExpiryPoint + State->NextExpiryPoint].Offset
+                        : (sint64)Config->Duration;
+        sint64 Position = Target - (sint64)(Os_AlarmExpiry[AlarmID] - Os_Counter[Os_AlarmConfig[AlarmID].CounterRef].Now);
+        sint64 Deviation;
+
+        Position = ((Position % (sint64)Config->Duration) + (sint64)Config->Duration) % (sint64)Config->Duration;
+        Deviation = Position - (sint64)Value;
+        if (Deviation > ((sint64)Config->Duration / 2)) {
+            Deviation -= (sint64)Config->Duration;
+        } else if (Deviation <= -((sint64)Config->Duration / 2)) {
+            Deviation += (sint64)Config->Duration;
+        } else {
+            // Already the shortest way round
+        }
+        State->Deviation = (sint32)Deviation;
+        State->Status = (((Deviation < 0) ? -Deviation : Deviation) <= (sint64)Config->Precision)
+                        ? SCHEDULETABLE_RUNNING_AND_SYNCHRONOUS : SCHEDULETABLE_RUNNING;
+    }
+    ResumeOSInterrupts();
+    return Status;
+}
+
+FUNC(StatusType, OS_CODE) GetScheduleTableStatus(ScheduleTableType ScheduleTableID, ScheduleTableStatusRefType ScheduleStatus) {
+    if (ScheduleTableID >= OS_NUM_OF_SCHEDULE_TABLES) {
+        return E_OS_ID;
+    }
+    *ScheduleStatus = Os_ScheduleTable[ScheduleTableID].Status;
+    return E_OK;
+}
+
+/* =========================================================================
+ * ECU ABSTRACTION LAYER (ECUAL) - ALL INTERFACE STACKS
+ * ========================================================================= */
+
+/* CAN INTERFACE STACK - CANIF */
+// File: CanIf.c
+#include <stdatomic.h>
+
+/* Per-controller Tx queue in front of Can_Write. Producers (any task or core)
+ * enqueue lock-free into a bounded MPSC ring; whichever caller wins the drain
+ * flag moves entries into a min-heap ordered like bus arbitration and feeds
+ * the driver until its hardware objects are busy. Callers that lose the flag
+ * leave a drain request, so a TxConfirmation arriving while another context
+ * drains still gets the freed hardware object refilled. */
+typedef struct {
+    Can_PduType Pdu;
+    Can_HwHandleType Hth;
+    uint32 ArbKey;                              // Lower key wins arbitration
+    uint32 Seq;                                 // FIFO order among equal CAN IDs
+    boolean Pooled;                             // Payload referenced in PduBuf
+    uint8 Data[CANIF_TX_QUEUE_MAX_DATA];        // Copy of non-pooled payloads
+} CanIf_TxQueueEntryType;
+
+typedef struct {
+    atomic_uint_least32_t Sequence;
+    CanIf_TxQueueEntryType Entry;
+} CanIf_TxQueueCellType;
+
+typedef struct {
+    CanIf_TxQueueCellType Cell[CANIF_TX_QUEUE_DEPTH];   // Power of two
+    atomic_uint_least32_t EnqueuePos;
+    atomic_flag DrainLock;
+    atomic_bool DrainRequested;                         // Set by every caller, consumed by the lock holder
+    uint32 DequeuePos;                                  // Drainer only
+    CanIf_TxQueueEntryType Heap[CANIF_TX_QUEUE_DEPTH];  // Drainer only
+    uint16 HeapCount;
+} CanIf_TxQueueType;
+
+static VAR(CanIf_TxQueueType, CANIF_VAR_NOINIT) CanIf_TxQueue[CANIF_NUM_OF_CONTROLLERS];
+
+FUNC(void, CANIF_CODE) CanIf_TxQueueInit(void) {
+    uint8 Ctrl;
+    uint16 i;
+
+    for (Ctrl = 0u; Ctrl < CANIF_NUM_OF_CONTROLLERS; Ctrl++) {
+        P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue = &CanIf_TxQueue[Ctrl];
+        for (i = 0u; i < CANIF_TX_QUEUE_DEPTH; i++) {
+            atomic_init(&Queue->Cell[i].Sequence, i);
+        }
+        atomic_init(&Queue->EnqueuePos, 0u);
+        atomic_flag_clear(&Queue->DrainLock);
+        atomic_init(&Queue->DrainRequested, FALSE);
+        Queue->DequeuePos = 0u;
+        Queue->HeapCount = 0u;
+    }
+}
+
+static FUNC(uint32, CANIF_CODE) CanIf_ArbitrationKey(Can_IdType CanId) {
+    // Arbitration order: 11-bit base ID, then SRR/IDE (standard beats extended), then 18-bit extension
+    if ((CanId & CAN_ID_EXTENDED_FLAG) != 0u) {
+        uint32 Id29 = CanId & 0x1FFFFFFFu;
+        return ((Id29 >> 18) << 20) | (3uL << 18) | (Id29 & 0x3FFFFu);
+    }
+    return (uint32)(CanId & 0x7FFu) << 20;
+}
+
+static FUNC(boolean, CANIF_CODE) CanIf_TxQueueBefore(P2CONST(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) a,
+                                                     P2CONST(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) b) {
+    if (a->ArbKey != b->ArbKey) {
+        return (a->ArbKey < b->ArbKey) ? TRUE : FALSE;
+    }
+    return ((sint32)(a->Seq - b->Seq) < 0) ? TRUE : FALSE;
+}
+
+static FUNC(void, CANIF_CODE) CanIf_TxHeapPush(P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue,
+                                               P2CONST(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) Entry) {
+    uint16 Child = Queue->HeapCount;
+
+    Queue->HeapCount++;
+    while (Child > 0u) {
+        uint16 Parent = (uint16)((Child - 1u) / 2u);
+        if (CanIf_TxQueueBefore(Entry, &Queue->Heap[Parent]) == FALSE) {
+            break;
+        }
+        Queue->Heap[Child] = Queue->Heap[Parent];
+        Child = Parent;
+    }
+    Queue->Heap[Child] = *Entry;
+}
+
+static FUNC(void, CANIF_CODE) CanIf_TxHeapPop(P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue) {
+    uint16 Parent = 0u;
+    P2CONST(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) Last;
+
+    Queue->HeapCount--;
+    Last = &Queue->Heap[Queue->HeapCount];
+    for (;;) {
+        uint16 Child = (uint16)((Parent * 2u) + 1u);
+        if (Child >= Queue->HeapCount) {
+            break;
+        }
+        if (((Child + 1u) < Queue->HeapCount) &&
+            (CanIf_TxQueueBefore(&Queue->Heap[Child + 1u], &Queue->Heap[Child]) == TRUE)) {
+            Child++;
+        }
+        if (CanIf_TxQueueBefore(&Queue->Heap[Child], Last) == FALSE) {
+            break;
+        }
+        Queue->Heap[Parent] = Queue->Heap[Child];
+        Parent = Child;
+    }
+    Queue->Heap[Parent] = *Last;
+}
+
+static FUNC(Std_ReturnType, CANIF_CODE) CanIf_TxQueueEnqueue(uint8 Ctrl, Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CANIF_APPL_CONST) CanPdu) {
+    // Multi-producer ring: claim a cell by CAS on EnqueuePos, publish through its sequence
+    P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue = &CanIf_TxQueue[Ctrl];
+    P2VAR(CanIf_TxQueueCellType, AUTOMATIC, CANIF_VAR_NOINIT) Cell;
+    uint32 Pos = atomic_load_explicit(&Queue->EnqueuePos, memory_order_relaxed);
+
+    for (;;) {
+        uint32 Seq;
+        sint32 Diff;
+
+        Cell = &Queue->Cell[Pos & (CANIF_TX_QUEUE_DEPTH - 1u)];
+        Seq = atomic_load_explicit(&Cell->Sequence, memory_order_acquire);
+        Diff = (sint32)(Seq - Pos);
+        if (Diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&Queue->EnqueuePos, &Pos, Pos + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (Diff < 0) {
+            return E_NOT_OK;        // Queue full
+        } else {
+            Pos = atomic_load_explicit(&Queue->EnqueuePos, memory_order_relaxed);
+        }
+    }
+
+    Cell->Entry.Pdu = *CanPdu;
+    Cell->Entry.Hth = Hth;
+    Cell->Entry.ArbKey = CanIf_ArbitrationKey(CanPdu->id);
+    Cell->Entry.Seq = Pos;
+    Cell->Entry.Pooled = PduBuf_Retain(CanPdu->sdu);
+    if (Cell->Entry.Pooled == FALSE) {
+        (void)memcpy(Cell->Entry.Data, CanPdu->sdu, CanPdu->length);
+    }
+    atomic_store_explicit(&Cell->Sequence, Pos + 1u, memory_order_release);
+    return E_OK;
+}
+
+static FUNC(boolean, CANIF_CODE) CanIf_TxQueueDequeue(P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue,
+                                                      P2VAR(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) Entry) {
+    // Single consumer (drain flag holder)
+    P2VAR(CanIf_TxQueueCellType, AUTOMATIC, CANIF_VAR_NOINIT) Cell = &Queue->Cell[Queue->DequeuePos & (CANIF_TX_QUEUE_DEPTH - 1u)];
+    uint32 Seq = atomic_load_explicit(&Cell->Sequence, memory_order_acquire);
+
+    if ((sint32)(Seq - (Queue->DequeuePos + 1u)) < 0) {
+        return FALSE;
+    }
+    *Entry = Cell->Entry;
+    atomic_store_explicit(&Cell->Sequence, Queue->DequeuePos + CANIF_TX_QUEUE_DEPTH, memory_order_release);
+    Queue->DequeuePos++;
+    return TRUE;
+}
+
+static FUNC(void, CANIF_CODE) CanIf_TxConfirmUpper(PduIdType CanTxPduId, Std_ReturnType Result) {
+    P2CONST(CanIf_TxPduConfigType, AUTOMATIC, CANIF_CONST) TxPduConfig = &CanIf_ConfigPtr->CanIfTxPduConfig[CanTxPduId];
+
+    if (TxPduConfig->CanIfTxPduUserTxConfirmationUL == CANIF_UL_CANTP) {
+        CanTp_TxConfirmation(TxPduConfig->CanIfTxPduUpperPduRef, Result);   // N-PDU of a CanTp channel
+    } else {
+        PduR_CanIfTxConfirmation(TxPduConfig->CanIfTxPduUpperPduRef, Result);
+    }
+}
+
+FUNC(void, CANIF_CODE) CanIf_TxQueueDrain(uint8 Ctrl) {
+    // Feed the driver in arbitration order until no hardware object is free
+    P2VAR(CanIf_TxQueueType, AUTOMATIC, CANIF_VAR_NOINIT) Queue = &CanIf_TxQueue[Ctrl];
+    CanIf_TxQueueEntryType Entry;
+
+    atomic_store_explicit(&Queue->DrainRequested, TRUE, memory_order_seq_cst);
+    do {
+        if (atomic_flag_test_and_set_explicit(&Queue->DrainLock, memory_order_acquire)) {
+            return;     // The holder sees our request before it lets go of the flag
+        }
+
+        // One pass per request: new entries, or a TxConfirmation that freed a hardware object
+        while (atomic_exchange_explicit(&Queue->DrainRequested, FALSE, memory_order_acq_rel) == TRUE) {
+            while ((Queue->HeapCount < CANIF_TX_QUEUE_DEPTH) && (CanIf_TxQueueDequeue(Queue, &Entry) == TRUE)) {
+                CanIf_TxHeapPush(Queue, &Entry);
+            }
+
+            while (Queue->HeapCount > 0u) {
+                P2VAR(CanIf_TxQueueEntryType, AUTOMATIC, CANIF_VAR_NOINIT) Top = &Queue->Heap[0];
+                Std_ReturnType Result;
+                PduIdType TxPduId = Top->Pdu.swPduHandle;
+
+                if (Top->Pooled == FALSE) {
+                    Top->Pdu.sdu = Top->Data;
+                }
+                Result = Can_Write(Top->Hth, &Top->Pdu);
+                if (Result == CAN_BUSY) {
+                    break;  // Hardware busy: resume on the next TxConfirmation
+                }
+                if (Top->Pooled == TRUE) {
+                    PduBuf_Release(Top->Pdu.sdu);
+                }
+                CanIf_TxHeapPop(Queue);
+                if (Result != E_OK) {
+                    CanIf_TxConfirmUpper(TxPduId, E_NOT_OK);    // Rejected for good: drop it, do not block the controller
+                }
+            }
+        }
+
+        atomic_flag_clear_explicit(&Queue->DrainLock, memory_order_release);
+
+        // Re-check: a request may have been left after our last exchange but before the clear
+    } while (atomic_load_explicit(&Queue->DrainRequested, memory_order_seq_cst) == TRUE);
+}
+
+FUNC(Std_ReturnType, CANIF_CODE) CanIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, CANIF_APPL_CONST) PduInfoPtr) {
+    // Step 25: CAN Interface - Message preparation
+    P2CONST(CanIf_TxPduConfigType, AUTOMATIC, CANIF_CONST) TxPduConfig = &CanIf_ConfigPtr->CanIfTxPduConfig[TxPduId];
+    Std_ReturnType Result;
+    
+    // Step 26: Create hardware-independent CAN PDU
+    Can_PduType CanPdu;
+    CanPdu.id = TxPduConfig->CanIfTxPduCanId;        // From configuration
+    CanPdu.length = PduInfoPtr->SduLength;
+    CanPdu.sdu = PduInfoPtr->SduDataPtr;             // Pooled payload by reference (no copy)
+    CanPdu.swPduHandle = TxPduId;
+    
+    // Step 27: Queue in arbitration order and feed the MCAL CAN driver
+    Result = CanIf_TxQueueEnqueue(TxPduConfig->CanIfTxPduCtrlRef, TxPduConfig->CanIfTxPduCanHwObjectRef, &CanPdu);
+    if (Result == E_OK) {
+        CanIf_TxQueueDrain(TxPduConfig->CanIfTxPduCtrlRef);
+    }
+    return Result;
+}
+
+FUNC(void, CANIF_CODE) CanIf_TxConfirmation(PduIdType CanTxPduId) {
+    // A hardware object became free: send the next queued frame, then confirm upwards
+    P2CONST(CanIf_TxPduConfigType, AUTOMATIC, CANIF_CONST) TxPduConfig = &CanIf_ConfigPtr->CanIfTxPduConfig[CanTxPduId];
+    
+    CanIf_TxQueueDrain(TxPduConfig->CanIfTxPduCtrlRef);
+    CanIf_TxConfirmUpper(CanTxPduId, E_OK);
+}
+
+/* LIN INTERFACE STACK - LINIF */
+// File: LinIf.c
+FUNC(Std_ReturnType, LINIF_CODE) LinIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, LINIF_APPL_CONST) PduInfoPtr) {
+    // Step 28: LIN Interface (if LIN communication used)
+    P2CONST(LinIf_TxPduConfigType, AUTOMATIC, LINIF_CONST) TxPduConfig = &LinIf_TxPduConfig[TxPduId];
+#if (VBUS_SIL_TRANSPORT == STD_ON)
+    return Lin_VBus_SendFrame(TxPduConfig->LinChannelRef, TxPduConfig->LinPid, PduInfoPtr);
+#else
+    return Lin_SendFrame(TxPduConfig->LinChannelRef, PduInfoPtr);
+#endif
+}
+
+/* FLEXRAY INTERFACE STACK - FRIF */
+// File: FrIf.c
+FUNC(Std_ReturnType, FRIF_CODE) FrIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, FRIF_APPL_CONST) PduInfoPtr) {
+    // Step 29: FlexRay Interface (if FlexRay used)
+    P2CONST(FrIf_TxPduConfigType, AUTOMATIC, FRIF_CONST) TxPduConfig = &FrIf_TxPduConfig[TxPduId];
+    return Fr_TransmitTxLPdu(TxPduConfig->FrCtrlRef, TxPduConfig->FrLPduRef, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+}
+
+/* ETHERNET INTERFACE STACK - ETHIF */
+// File: EthIf.c
+FUNC(Std_ReturnType, ETHIF_CODE) EthIf_Transmit(uint8 CtrlIdx, PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, ETHIF_APPL_DATA) PduInfoPtr) {
+    // Step 30: Ethernet Interface (if Ethernet used)
+#if (VBUS_SIL_TRANSPORT == STD_ON)
+    return Eth_VBus_Transmit(CtrlIdx, TxPduId, PduInfoPtr);
+#else
+    return Eth_Transmit(CtrlIdx, TxPduId, PduInfoPtr);
+#endif
+}
+
+/* MEMORY INTERFACE STACK - MEMIF */
+// File: MemIf.c
+FUNC(Std_ReturnType, MEMIF_CODE) MemIf_Write(uint8 DeviceIndex, uint16 BlockNumber, P2CONST(uint8, AUTOMATIC, MEMIF_APPL_DATA) DataBufferPtr) {
+    // Step 31: Memory Interface abstraction
+    switch(MemIf_ConfigPtr->MemIfDeviceConfig[DeviceIndex].MemIfDeviceType) {
+        case MEMIF_FEE_DEVICE:
+            return Fee_Write(BlockNumber, DataBufferPtr);
+        case MEMIF_EA_DEVICE:
+            return Ea_Write(BlockNumber, DataBufferPtr);
+        default:
+            return E_NOT_OK;
+    }
+}
+
+/* WATCHDOG INTERFACE STACK - WDGIF */
+// File: WdgIf.c
+FUNC(Std_ReturnType, WDGIF_CODE) WdgIf_SetTriggerCondition(uint8 DeviceIndex, uint16 Timeout) {
+    // Step 32: Watchdog Interface
+    P2CONST(WdgIf_DeviceConfigType, AUTOMATIC, WDGIF_CONST) DeviceConfig = &WdgIf_DeviceConfig[DeviceIndex];
+    
+    switch(DeviceConfig->WdgIfDevice) {
+        case WDGIF_INTERNAL_WDG:
+            return Wdg_SetTriggerCondition(Timeout);
+        case WDGIF_EXTERNAL_WDG:
+            return WdgExt_SetTriggerCondition(DeviceConfig->WdgIfDeviceIndex, Timeout);
+        default:
+            return E_NOT_OK;
+    }
+}
+
+/* =========================================================================
+ * COMPLEX DEVICE DRIVERS (CDD) - CUSTOM DRIVER STACKS
+ * ========================================================================= */
+
+/* HIGH-SPEED SENSOR CDD */
+// File: Cdd_HighSpeedSensor.c
+FUNC(void, CDD_CODE) Cdd_HighSpeedSensor_MainFunction(void) {
+    // Step 33: Complex Device Driver for time-critical sensors
+    // Direct MCAL access for microsecond-precision timing
+    
+    Gpt_ValueType timestamp = Gpt_GetTimeElapsed(GPT_CHANNEL_TIMESTAMP);
+    Adc_ValueType sensor_value = 0;
+    
+    if (Adc_ReadGroup(ADC_GROUP_HIGH_SPEED_SENSORS, &sensor_value) == E_OK) {
+        // Process high-speed sensor data with precise timing
+        Cdd_ProcessSensorData(sensor_value, timestamp);
+    }
+}
+
+/* SAFETY MONITORING CDD */
+// File: Cdd_SafetyMonitor.c
+FUNC(void, CDD_CODE) Cdd_SafetyMonitor_CheckDoorSafety(void) {
+    // Step 34: Safety-critical monitoring
+    // Bypass upper layers for safety-critical checks
+    
+    Dio_LevelType door_sensor_primary = Dio_ReadChannel(DIO_CHANNEL_DOOR_PRIMARY);
+    Dio_LevelType door_sensor_secondary = Dio_ReadChannel(DIO_CHANNEL_DOOR_SECONDARY);
+    
+    // Cross-check multiple sensors for safety. A mismatch is a safety violation and is
+    // qualified at once; only healing is left to the DEM debouncing, where the event has one
+    if (door_sensor_primary != door_sensor_secondary) {
+        Dem_ReportErrorStatus(DEM_EVENT_DOOR_SENSOR_MISMATCH, DEM_EVENT_STATUS_FAILED);
+    } else if (Dem_SetEventStatus(DEM_EVENT_DOOR_SENSOR_MISMATCH, DEM_EVENT_STATUS_PREPASSED) != E_OK) {
+        Dem_ReportErrorStatus(DEM_EVENT_DOOR_SENSOR_MISMATCH, DEM_EVENT_STATUS_PASSED);   // Monitor-internal debouncing
+    }
+}
+
+/* =========================================================================
+ * MICROCONTROLLER ABSTRACTION LAYER (MCAL) - ALL DRIVER STACKS
+ * ========================================================================= */
+
+/* CAN DRIVER STACK */
+// File: Can_Backend.h
+/* Hardware access of the Can driver goes through a backend so the same stack
+ * runs on the TC39x target and on Linux SIL hosts. Selected by CAN_BACKEND
+ * in Can_Cfg.h (Can_Tc39xBackend or Can_VcanBackend). */
+typedef struct {
+    P2FUNC(Std_ReturnType, CAN_CODE, Init)(void);
+    P2FUNC(Std_ReturnType, CAN_CODE, Transmit)(uint8 Controller, Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CAN_APPL_CONST) PduInfo);
+    P2FUNC(void, CAN_CODE, MainFunction_Write)(void);
+    P2FUNC(void, CAN_CODE, MainFunction_Read)(void);
+} Can_BackendType;
+
+// File: Can.c
+static CONST(Can_BackendType, CAN_CONST) Can_Tc39xBackend = {
+    &Can_Infineon_TC39x_Init,
+    &Can_Infineon_TC39x_Transmit,
+    &Can_Infineon_TC39x_MainFunction_Write,
+    &Can_Infineon_TC39x_MainFunction_Read,
+};
+
+static P2CONST(Can_BackendType, CAN_VAR, CAN_CONST) Can_Backend = &CAN_BACKEND;
+
+// Payload and handle of the frame occupying each Tx hardware object
+static VAR(boolean, CAN_VAR_NOINIT) Can_TxInFlight[CAN_NUM_OF_HTH];
+static P2CONST(uint8, CAN_VAR_NOINIT, CAN_APPL_CONST) Can_TxInFlightSdu[CAN_NUM_OF_HTH];
+static VAR(PduIdType, CAN_VAR_NOINIT) Can_TxInFlightPduId[CAN_NUM_OF_HTH];
+
+FUNC(Std_ReturnType, CAN_CODE) Can_Init(P2CONST(Can_ConfigType, AUTOMATIC, CAN_CONST) Config) {
+    Can_HwHandleType Hth;
+
+    Can_ConfigPtr = Config;
+    for (Hth = 0u; Hth < CAN_NUM_OF_HTH; Hth++) {
+        Can_TxInFlight[Hth] = FALSE;
+        Can_TxInFlightSdu[Hth] = NULL_PTR;
+    }
+    return Can_Backend->Init();
+}
+
+FUNC(Std_ReturnType, CAN_CODE) Can_Write(Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CAN_APPL_CONST) PduInfo) {
+    // Step 35: CAN MCAL Driver
+    P2CONST(Can_HwObjectConfigType, AUTOMATIC, CAN_CONST) HwObjConfig = &Can_ConfigPtr->CanHwObjectConfig[Hth];
+    uint8 Controller = HwObjConfig->CanControllerRef;
+    boolean Pooled;
+    Std_ReturnType Result;
+    
+    if (Can_TxInFlight[Hth] == TRUE) {
+        return CAN_BUSY;    // Its record belongs to the frame still on the wire
+    }
+
+    // Keep the pooled payload alive until the hardware confirms transmission. Recorded
+    // before Transmit: the Tx-complete interrupt may run before Transmit returns.
+    Pooled = PduBuf_Retain(PduInfo->sdu);
+    Can_TxInFlightSdu[Hth] = PduInfo->sdu;
+    Can_TxInFlightPduId[Hth] = PduInfo->swPduHandle;
+    Can_TxInFlight[Hth] = TRUE;
+    Result = Can_Backend->Transmit(Controller, Hth, PduInfo);
+    if (Result != E_OK) {
+        Can_TxInFlight[Hth] = FALSE;
+        Can_TxInFlightSdu[Hth] = NULL_PTR;
+        if (Pooled == TRUE) {
+            PduBuf_Release(PduInfo->sdu);
+        }
+    }
+    return Result;
+}
+
+FUNC(void, CAN_CODE) Can_TxConfirmationHandler(Can_HwHandleType Hth) {
+    // Called from the Tx-complete interrupt (or Can_MainFunction_Write polling)
+    P2CONST(uint8, AUTOMATIC, CAN_APPL_CONST) Sdu = Can_TxInFlightSdu[Hth];
+    PduIdType PduId = Can_TxInFlightPduId[Hth];
+
+    // Free the mailbox first: the confirmation may refill it through CanIf's Tx queue
+    Can_TxInFlightSdu[Hth] = NULL_PTR;
+    Can_TxInFlight[Hth] = FALSE;
+    PduBuf_Release(Sdu);
+    
+    CanIf_TxConfirmation(PduId);
+}
+
+FUNC(void, CAN_CODE) Can_MainFunction_Write(void) {
+    Can_Backend->MainFunction_Write();
+}
+
+FUNC(void, CAN_CODE) Can_MainFunction_Read(void) {
+    Can_Backend->MainFunction_Read();
+}
+
+/* CAN DRIVER STACK - SIL BACKEND (LINUX SOCKETCAN VCAN) */
+// File: Can_Vcan.c
+/* Maps each Can controller onto a Linux vcan interface so ECU processes on
+ * one host exchange frames without hardware. Setup (once per host):
+ *   ip link add dev vcan0 type vcan && ip link set up vcan0
+ * Tx frames are collected per controller and flushed with one sendmmsg() per
+ * Can_MainFunction_Write; Rx uses recvmmsg() or, with CAN_VCAN_PACKET_MMAP,
+ * a PF_PACKET TPACKET_V2 ring shared with the kernel. Each Hth behaves like a
+ * hardware mailbox: busy from Can_Write until its frame has been sent.
+ * A controller never receives its own frames. The CAN_RAW socket gets this
+ * from CAN_RAW_RECV_OWN_MSGS being off. The packet ring cannot tell a local
+ * sender from its packet type, so each controller marks its Tx socket
+ * (SO_MARK, needs CAP_NET_ADMIN) and a socket filter on the ring drops
+ * frames carrying that mark. */
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+#include <sys/mman.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#endif
+
+typedef struct {
+    struct canfd_frame Frame[CAN_VCAN_TX_BATCH];
+    struct iovec Iov[CAN_VCAN_TX_BATCH];
+    struct mmsghdr Msg[CAN_VCAN_TX_BATCH];
+    Can_HwHandleType Hth[CAN_VCAN_TX_BATCH];
+    uint16 Count;
+} Can_VcanTxBatchType;
+
+typedef struct {
+    sint32 Socket;
+    Can_VcanTxBatchType Tx;
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+    sint32 PacketSocket;
+    P2VAR(uint8, AUTOMATIC, CAN_VAR_NOINIT) Ring;
+    uint32 RingFrame;
+#endif
+} Can_VcanControllerType;
+
+static VAR(Can_VcanControllerType, CAN_VAR_NOINIT) Can_Vcan[CAN_NUM_OF_CONTROLLERS];
+static VAR(boolean, CAN_VAR_NOINIT) Can_VcanHthBusy[CAN_NUM_OF_HTH];
+
+static FUNC(void, CAN_CODE) Can_Vcan_Close(void) {
+    // Undo a partial Can_Vcan_Init: every controller starts with no socket and no ring
+    uint8 Controller;
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+        P2VAR(Can_VcanControllerType, AUTOMATIC, CAN_VAR_NOINIT) Ctrl = &Can_Vcan[Controller];
+
+        if (Ctrl->Socket >= 0) {
+            (void)close(Ctrl->Socket);
+            Ctrl->Socket = -1;
+        }
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        if (Ctrl->Ring != NULL_PTR) {
+            (void)munmap(Ctrl->Ring, (size_t)CAN_VCAN_RING_BLOCK_SIZE * CAN_VCAN_RING_BLOCKS);
+            Ctrl->Ring = NULL_PTR;
+        }
+        if (Ctrl->PacketSocket >= 0) {
+            (void)close(Ctrl->PacketSocket);
+            Ctrl->PacketSocket = -1;
+        }
+#endif
+    }
+    (void)memset(Can_VcanHthBusy, 0, sizeof(Can_VcanHthBusy));
+}
+
+static FUNC(void, CAN_CODE) Can_Vcan_Deliver(uint8 Controller, P2CONST(struct canfd_frame, AUTOMATIC, CAN_VAR_NOINIT) Frame, boolean IsFd) {
+    // Translate a SocketCAN frame into the AUTOSAR Rx indication
+    Can_HwType Mailbox;
+    PduInfoType PduInfo;
+
+    Mailbox.CanId = Frame->can_id & CAN_EFF_MASK;
+    if ((Frame->can_id & CAN_EFF_FLAG) != 0u) {
+        Mailbox.CanId |= CAN_ID_EXTENDED_FLAG;
+    } else {
+        Mailbox.CanId &= CAN_SFF_MASK;
+    }
+    if (IsFd == TRUE) {
+        Mailbox.CanId |= CAN_ID_FD_FLAG;
+    }
+    Mailbox.Hoh = Can_VcanControllerConfig[Controller].Hrh;
+    Mailbox.ControllerId = Controller;
+
+    PduInfo.SduDataPtr = (uint8*)Frame->data;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = Frame->len;
+    CanIf_RxIndication(&Mailbox, &PduInfo);
+}
+
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+static FUNC(Std_ReturnType, CAN_CODE) Can_Vcan_InitPacketRing(uint8 Controller, sint32 IfIndex, uint32 OwnMark) {
+    // Rx ring mapped from the kernel: frames are consumed without a syscall each
+    P2VAR(Can_VcanControllerType, AUTOMATIC, CAN_VAR_NOINIT) Ctrl = &Can_Vcan[Controller];
+    struct tpacket_req Req;
+    struct sockaddr_ll Addr;
+    sint32 Version = TPACKET_V2;
+    /* Every frame sent on the interface, by any process, is tapped exactly once
+     * as PACKET_OUTGOING; the vcan echo (if enabled) is a second copy. Keep the
+     * tapped copy unless this controller sent it. */
+    struct sock_filter Code[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, (uint32)(SKF_AD_OFF + SKF_AD_PKTTYPE)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 0u, 3u),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, (uint32)(SKF_AD_OFF + SKF_AD_MARK)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, OwnMark, 1u, 0u),
+        BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFFu),
+        BPF_STMT(BPF_RET | BPF_K, 0u),
+    };
+    struct sock_fprog Filter;
+
+    // Protocol 0 receives nothing until bind(), so no frame reaches the ring unfiltered
+    Ctrl->PacketSocket = socket(PF_PACKET, SOCK_RAW, 0);
+    if (Ctrl->PacketSocket < 0) {
+        return E_NOT_OK;
+    }
+    Filter.len = (unsigned short)(sizeof(Code) / sizeof(Code[0]));
+    Filter.filter = Code;
+    if (setsockopt(Ctrl->PacketSocket, SOL_SOCKET, SO_ATTACH_FILTER, &Filter, sizeof(Filter)) != 0) {
+        return E_NOT_OK;
+    }
+    (void)setsockopt(Ctrl->PacketSocket, SOL_PACKET, PACKET_VERSION, &Version, sizeof(Version));
+
+    Req.tp_block_size = CAN_VCAN_RING_BLOCK_SIZE;
+    Req.tp_block_nr = CAN_VCAN_RING_BLOCKS;
+    Req.tp_frame_size = CAN_VCAN_RING_FRAME_SIZE;
+    Req.tp_frame_nr = (CAN_VCAN_RING_BLOCK_SIZE / CAN_VCAN_RING_FRAME_SIZE) * CAN_VCAN_RING_BLOCKS;
+    if (setsockopt(Ctrl->PacketSocket, SOL_PACKET, PACKET_RX_RING, &Req, sizeof(Req)) != 0) {
+        return E_NOT_OK;
+    }
+    Ctrl->Ring = mmap(NULL, (size_t)Req.tp_block_size * Req.tp_block_nr, PROT_READ | PROT_WRITE, MAP_SHARED, Ctrl->PacketSocket, 0);
+    if (Ctrl->Ring == MAP_FAILED) {
+        Ctrl->Ring = NULL_PTR;
+        return E_NOT_OK;
+    }
+    Ctrl->RingFrame = 0u;
+
+    (void)memset(&Addr, 0, sizeof(Addr));
+    Addr.sll_family = AF_PACKET;
+    Addr.sll_protocol = htons(ETH_P_ALL);
+    Addr.sll_ifindex = IfIndex;
+    return (bind(Ctrl->PacketSocket, (struct sockaddr*)&Addr, sizeof(Addr)) == 0) ? E_OK : E_NOT_OK;
+}
+#endif
+
+static FUNC(Std_ReturnType, CAN_CODE) Can_Vcan_Init(void) {
+    uint8 Controller;
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+        Can_Vcan[Controller].Socket = -1;
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        Can_Vcan[Controller].PacketSocket = -1;
+        Can_Vcan[Controller].Ring = NULL_PTR;
+#endif
+    }
+    (void)memset(Can_VcanHthBusy, 0, sizeof(Can_VcanHthBusy));
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+        P2VAR(Can_VcanControllerType, AUTOMATIC, CAN_VAR_NOINIT) Ctrl = &Can_Vcan[Controller];
+        struct sockaddr_can Addr;
+        struct ifreq Ifr;
+        sint32 EnableFd = 1;
+        sint32 RecvOwn = 0;
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        // Unique per controller across the host; carried by every frame this socket sends
+        uint32 OwnMark = ((uint32)getpid() << 8) | Controller;
+#endif
+        uint16 i;
+
+        Ctrl->Socket = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+        if (Ctrl->Socket < 0) {
+            Can_Vcan_Close();
+            return E_NOT_OK;
+        }
+        (void)setsockopt(Ctrl->Socket, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &EnableFd, sizeof(EnableFd));
+        // Off by default; spelled out because a controller must not see its own frames
+        (void)setsockopt(Ctrl->Socket, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &RecvOwn, sizeof(RecvOwn));
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        // Rx comes from the packet ring: an empty filter keeps the kernel from queueing to this socket
+        (void)setsockopt(Ctrl->Socket, SOL_CAN_RAW, CAN_RAW_FILTER, NULL, 0);
+        if (setsockopt(Ctrl->Socket, SOL_SOCKET, SO_MARK, &OwnMark, sizeof(OwnMark)) != 0) {
+            Can_Vcan_Close();
+            return E_NOT_OK;
+        }
+#endif
+
+        (void)strncpy(Ifr.ifr_name, Can_VcanControllerConfig[Controller].IfName, IFNAMSIZ - 1u);
+        Ifr.ifr_name[IFNAMSIZ - 1u] = '\0';
+        if (ioctl(Ctrl->Socket, SIOCGIFINDEX, &Ifr) != 0) {
+            Can_Vcan_Close();
+            return E_NOT_OK;
+        }
+
+        (void)memset(&Addr, 0, sizeof(Addr));
+        Addr.can_family = AF_CAN;
+        Addr.can_ifindex = Ifr.ifr_ifindex;
+        if (bind(Ctrl->Socket, (struct sockaddr*)&Addr, sizeof(Addr)) != 0) {
+            Can_Vcan_Close();
+            return E_NOT_OK;
+        }
+
+        // Message headers point at fixed frame slots; only iov_len changes per frame
+        (void)memset(&Ctrl->Tx, 0, sizeof(Ctrl->Tx));
+        for (i = 0u; i < CAN_VCAN_TX_BATCH; i++) {
+            Ctrl->Tx.Iov[i].iov_base = &Ctrl->Tx.Frame[i];
+            Ctrl->Tx.Msg[i].msg_hdr.msg_iov = &Ctrl->Tx.Iov[i];
+            Ctrl->Tx.Msg[i].msg_hdr.msg_iovlen = 1u;
+        }
+
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        if (Can_Vcan_InitPacketRing(Controller, Ifr.ifr_ifindex, OwnMark) != E_OK) {
+            Can_Vcan_Close();
+            return E_NOT_OK;
+        }
+#endif
+    }
+    return E_OK;
+}
+
+static FUNC(void, CAN_CODE) Can_Vcan_FlushController(uint8 Controller) {
+    // One syscall for the whole batch; unsent frames stay queued for the next flush
+    P2VAR(Can_VcanTxBatchType, AUTOMATIC, CAN_VAR_NOINIT) Tx = &Can_Vcan[Controller].Tx;
+    Can_HwHandleType SentHth[CAN_VCAN_TX_BATCH];
+    sint32 Sent;
+    uint16 Remaining;
+    uint16 i;
+
+    if (Tx->Count == 0u) {
+        return;
+    }
+
+    Sent = sendmmsg(Can_Vcan[Controller].Socket, Tx->Msg, Tx->Count, MSG_DONTWAIT);
+    if (Sent <= 0) {
+        return;     // ENOBUFS/EAGAIN: bus saturated, retry on the next cycle
+    }
+
+    for (i = 0u; i < (uint16)Sent; i++) {
+        SentHth[i] = Tx->Hth[i];
+    }
+    Remaining = (uint16)(Tx->Count - (uint16)Sent);
+    for (i = 0u; i < Remaining; i++) {
+        Tx->Frame[i] = Tx->Frame[Sent + i];
+        Tx->Iov[i].iov_len = Tx->Iov[Sent + i].iov_len;
+        Tx->Hth[i] = Tx->Hth[Sent + i];
+    }
+    Tx->Count = Remaining;
+
+    // Confirmations may refill the batch through CanIf's Tx queue
+    for (i = 0u; i < (uint16)Sent; i++) {
+        Can_VcanHthBusy[SentHth[i]] = FALSE;
+        Can_TxConfirmationHandler(SentHth[i]);
+    }
+}
+
+static FUNC(Std_ReturnType, CAN_CODE) Can_Vcan_Transmit(uint8 Controller, Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CAN_APPL_CONST) PduInfo) {
+    P2VAR(Can_VcanTxBatchType, AUTOMATIC, CAN_VAR_NOINIT) Tx = &Can_Vcan[Controller].Tx;
+    P2VAR(struct canfd_frame, AUTOMATIC, CAN_VAR_NOINIT) Frame;
+    boolean IsFd = (((PduInfo->id & CAN_ID_FD_FLAG) != 0u) || (PduInfo->length > CAN_MAX_DLEN)) ? TRUE : FALSE;
+
+    if (Can_VcanHthBusy[Hth] == TRUE) {
+        return CAN_BUSY;
+    }
+    if (Tx->Count == CAN_VCAN_TX_BATCH) {
+        Can_Vcan_FlushController(Controller);
+        if (Tx->Count == CAN_VCAN_TX_BATCH) {
+            return CAN_BUSY;
+        }
+    }
+
+    Frame = &Tx->Frame[Tx->Count];
+    (void)memset(Frame, 0, sizeof(*Frame));
+    if ((PduInfo->id & CAN_ID_EXTENDED_FLAG) != 0u) {
+        Frame->can_id = (PduInfo->id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    } else {
+        Frame->can_id = PduInfo->id & CAN_SFF_MASK;
+    }
+    Frame->len = PduInfo->length;
+    Frame->flags = (IsFd == TRUE) ? CANFD_BRS : 0u;
+    (void)memcpy(Frame->data, PduInfo->sdu, PduInfo->length);
+
+    Tx->Iov[Tx->Count].iov_len = (IsFd == TRUE) ? CANFD_MTU : CAN_MTU;
+    Tx->Hth[Tx->Count] = Hth;
+    Tx->Count++;
+    Can_VcanHthBusy[Hth] = TRUE;
+    return E_OK;
+}
+
+static FUNC(void, CAN_CODE) Can_Vcan_MainFunction_Write(void) {
+    uint8 Controller;
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+        Can_Vcan_FlushController(Controller);
+    }
+}
+
+static FUNC(void, CAN_CODE) Can_Vcan_MainFunction_Read(void) {
+    uint8 Controller;
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+#if (CAN_VCAN_PACKET_MMAP == STD_ON)
+        // Walk the ring until a frame still owned by the kernel
+        P2VAR(Can_VcanControllerType, AUTOMATIC, CAN_VAR_NOINIT) Ctrl = &Can_Vcan[Controller];
+        uint32 NumFrames = (CAN_VCAN_RING_BLOCK_SIZE / CAN_VCAN_RING_FRAME_SIZE) * CAN_VCAN_RING_BLOCKS;
+
+        for (;;) {
+            struct tpacket2_hdr* Hdr = (struct tpacket2_hdr*)&Ctrl->Ring[Ctrl->RingFrame * CAN_VCAN_RING_FRAME_SIZE];
+            if ((Hdr->tp_status & TP_STATUS_USER) == 0u) {
+                break;
+            }
+            // The socket filter already dropped this controller's own frames and echo copies
+            Can_Vcan_Deliver(Controller, (const struct canfd_frame*)((uint8*)Hdr + Hdr->tp_mac),
+                             (Hdr->tp_len == CANFD_MTU) ? TRUE : FALSE);
+            Hdr->tp_status = TP_STATUS_KERNEL;
+            Ctrl->RingFrame = (Ctrl->RingFrame + 1u) % NumFrames;
+        }
+#else
+        struct canfd_frame Frame[CAN_VCAN_RX_BATCH];
+        struct iovec Iov[CAN_VCAN_RX_BATCH];
+        struct mmsghdr Msg[CAN_VCAN_RX_BATCH];
+        sint32 Received;
+        uint16 i;
+
+        (void)memset(Msg, 0, sizeof(Msg));
+        for (i = 0u; i < CAN_VCAN_RX_BATCH; i++) {
+            Iov[i].iov_base = &Frame[i];
+            Iov[i].iov_len = sizeof(Frame[i]);
+            Msg[i].msg_hdr.msg_iov = &Iov[i];
+            Msg[i].msg_hdr.msg_iovlen = 1u;
+        }
+
+        // Drain everything the socket holds, CAN_VCAN_RX_BATCH frames per syscall
+        do {
+            Received = recvmmsg(Can_Vcan[Controller].Socket, Msg, CAN_VCAN_RX_BATCH, MSG_DONTWAIT, NULL);
+            for (i = 0u; (Received > 0) && (i < (uint16)Received); i++) {
+                Can_Vcan_Deliver(Controller, &Frame[i], (Msg[i].msg_len == CANFD_MTU) ? TRUE : FALSE);
+            }
+        } while (Received == (sint32)CAN_VCAN_RX_BATCH);
+#endif
+    }
+}
+
+CONST(Can_BackendType, CAN_CONST) Can_VcanBackend = {
+    &Can_Vcan_Init,
+    &Can_Vcan_Transmit,
+    &Can_Vcan_MainFunction_Write,
+    &Can_Vcan_MainFunction_Read,
+};
+
+/* SIL SHARED-MEMORY VIRTUAL BUS */
+// File: VBus.c
+/* Inter-process "virtual bus" for running several simulated ECUs on one host
+ * without the kernel network stack. Each configured bus (CAN, LIN or
+ * Ethernet) is a POSIX shared-memory ring of fixed-size slots:
+ * - Senders claim a slot with one fetch_add on WritePos (multi-producer).
+ * - Every attached ECU reads with its own cursor (broadcast, like a bus);
+ *   frames sent by the ECU itself are skipped.
+ * - Slots are published seqlock-style, so a reader that gets lapped detects
+ *   it and counts an overrun instead of delivering a torn frame.
+ * NumSlots must cover the frames in flight between two polls of the slowest reader.
+ * The process that creates a segment (O_EXCL) sizes and formats it; the others
+ * only validate it, so an ECU with a different configuration cannot resize a
+ * segment under the running ones. */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define VBUS_MAGIC              0x56425553u     // "VBUS"
+#define VBUS_STATE_EMPTY        0u
+#define VBUS_STATE_READY        2u
+
+#ifndef VBUS_ATTACH_TIMEOUT_MS
+#define VBUS_ATTACH_TIMEOUT_MS  1000u           // Creator must have formatted the segment by then
+#endif
+
+// Outcome of creating or attaching to one bus segment
+#define VBUS_ATTACH_OK          0u
+#define VBUS_ATTACH_FAILED      1u
+#define VBUS_ATTACH_EXISTS      2u              // Segment already there: attach instead
+#define VBUS_ATTACH_STALE       3u              // Creator died before READY: unlink and recreate
+
+typedef struct {
+    atomic_uint_least64_t Seq;      // 0 while being written, WritePos + 1 once published
+    uint32 FrameId;                 // CAN ID, LIN PID or Ethernet TxPduId
+    uint16 Length;
+    uint8 SrcEcu;
+    uint8 Reserved;
+} VBus_SlotHeaderType;              // Followed by SlotPayload bytes
+
+typedef struct {
+    atomic_uint_least32_t State;
+    uint32 Magic;
+    uint32 NumSlots;                // Power of two
+    uint32 SlotSize;                // Header + payload, multiple of 64 bytes
+    _Alignas(64) atomic_uint_least64_t WritePos;
+    _Alignas(64) uint8 Slots[];
+} VBus_ShmType;
+
+typedef struct {
+    P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm;
+    uint64 ReadPos;                 // Private cursor of this ECU
+    uint32 Overruns;
+} VBus_BusStateType;
+
+static VAR(VBus_BusStateType, VBUS_VAR_NOINIT) VBus_Bus[VBUS_NUM_OF_BUSES];
+static VAR(uint8, VBUS_VAR_NOINIT) VBus_EcuId;
+
+static FUNC_P2VAR(VBus_SlotHeaderType, VBUS_VAR_NOINIT, VBUS_CODE) VBus_Slot(P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm, uint64 Pos) {
+    return (VBus_SlotHeaderType*)&Shm->Slots[(Pos & (Shm->NumSlots - 1u)) * Shm->SlotSize];
+}
+
+static FUNC(void, VBUS_CODE) VBus_Sleep1ms(void) {
+    struct timespec Delay = { 0, 1000000L };
+    (void)nanosleep(&Delay, NULL);
+}
+
+static FUNC(uint8, VBUS_CODE) VBus_Create(P2CONST(VBus_BusConfigType, AUTOMATIC, VBUS_CONST) Cfg, uint32 SlotSize, size_t ShmSize,
+                                         P2VAR(VBus_ShmType*, AUTOMATIC, AUTOMATIC) ShmPtr) {
+    // Only the creator sizes the segment; it is formatted before anyone sees READY
+    P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm;
+    sint32 Fd = shm_open(Cfg->ShmName, O_CREAT | O_EXCL | O_RDWR, 0660);
+
+    if (Fd < 0) {
+        return (errno == EEXIST) ? VBUS_ATTACH_EXISTS : VBUS_ATTACH_FAILED;
+    }
+    if (ftruncate(Fd, (off_t)ShmSize) != 0) {
+        (void)close(Fd);
+        (void)shm_unlink(Cfg->ShmName);
+        return VBUS_ATTACH_FAILED;
+    }
+    Shm = mmap(NULL, ShmSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    (void)close(Fd);
+    if (Shm == MAP_FAILED) {
+        (void)shm_unlink(Cfg->ShmName);
+        return VBUS_ATTACH_FAILED;
+    }
+
+    Shm->Magic = VBUS_MAGIC;
+    Shm->NumSlots = Cfg->NumSlots;
+    Shm->SlotSize = SlotSize;
+    atomic_store_explicit(&Shm->WritePos, 0u, memory_order_relaxed);
+    atomic_store_explicit(&Shm->State, VBUS_STATE_READY, memory_order_release);
+    *ShmPtr = Shm;
+    return VBUS_ATTACH_OK;
+}
+
+static FUNC(uint8, VBUS_CODE) VBus_Attach(P2CONST(VBus_BusConfigType, AUTOMATIC, VBUS_CONST) Cfg, uint32 SlotSize, size_t ShmSize,
+                                         P2VAR(VBus_ShmType*, AUTOMATIC, AUTOMATIC) ShmPtr) {
+    // Validate an existing segment without resizing it; wait a bounded time for its creator
+    P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm;
+    struct stat St;
+    uint32 Waited;
+    sint32 Fd = shm_open(Cfg->ShmName, O_RDWR, 0);
+
+    if (Fd < 0) {
+        return (errno == ENOENT) ? VBUS_ATTACH_STALE : VBUS_ATTACH_FAILED;  // Unlinked meanwhile: create it
+    }
+    for (Waited = 0u; ; Waited++) {
+        if (fstat(Fd, &St) != 0) {
+            (void)close(Fd);
+            return VBUS_ATTACH_FAILED;
+        }
+        if (St.st_size != 0) {
+            break;
+        }
+        if (Waited >= VBUS_ATTACH_TIMEOUT_MS) {
+            (void)close(Fd);
+            return VBUS_ATTACH_STALE;       // Created but never sized
+        }
+        VBus_Sleep1ms();
+    }
+    if ((size_t)St.st_size != ShmSize) {
+        (void)close(Fd);
+        return VBUS_ATTACH_FAILED;          // Segment created with a different configuration
+    }
+    Shm = mmap(NULL, ShmSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    (void)close(Fd);
+    if (Shm == MAP_FAILED) {
+        return VBUS_ATTACH_FAILED;
+    }
+
+    for (Waited = 0u; atomic_load_explicit(&Shm->State, memory_order_acquire) != VBUS_STATE_READY; Waited++) {
+        if (Waited >= VBUS_ATTACH_TIMEOUT_MS) {
+            (void)munmap(Shm, ShmSize);
+            return VBUS_ATTACH_STALE;       // Sized but never formatted
+        }
+        VBus_Sleep1ms();
+    }
+    if ((Shm->Magic != VBUS_MAGIC) || (Shm->SlotSize != SlotSize) || (Shm->NumSlots != Cfg->NumSlots)) {
+        (void)munmap(Shm, ShmSize);
+        return VBUS_ATTACH_FAILED;          // Same size, different configuration
+    }
+    *ShmPtr = Shm;
+    return VBUS_ATTACH_OK;
+}
+
+FUNC(Std_ReturnType, VBUS_CODE) VBus_Init(uint8 EcuId) {
+    // Attach to (or create) every configured bus segment
+    uint8 BusIdx;
+
+    VBus_EcuId = EcuId;
+    for (BusIdx = 0u; BusIdx < VBUS_NUM_OF_BUSES; BusIdx++) {
+        P2CONST(VBus_BusConfigType, AUTOMATIC, VBUS_CONST) Cfg = &VBus_BusConfig[BusIdx];
+        uint32 SlotSize = ((uint32)sizeof(VBus_SlotHeaderType) + Cfg->SlotPayload + 63u) & ~63u;
+        size_t ShmSize = sizeof(VBus_ShmType) + ((size_t)Cfg->NumSlots * SlotSize);
+        P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm = NULL_PTR;
+        uint8 Result = VBUS_ATTACH_STALE;
+        uint8 Attempt;
+
+        // A stale segment is unlinked and recreated once; a second stale one is an error
+        for (Attempt = 0u; (Attempt < 2u) && (Result == VBUS_ATTACH_STALE); Attempt++) {
+            Result = VBus_Create(Cfg, SlotSize, ShmSize, &Shm);
+            if (Result == VBUS_ATTACH_EXISTS) {
+                Result = VBus_Attach(Cfg, SlotSize, ShmSize, &Shm);
+                if (Result == VBUS_ATTACH_STALE) {
+                    (void)shm_unlink(Cfg->ShmName);
+                }
+            }
+        }
+        if (Result != VBUS_ATTACH_OK) {
+            return E_NOT_OK;
+        }
+
+        VBus_Bus[BusIdx].Shm = Shm;
+        VBus_Bus[BusIdx].ReadPos = atomic_load_explicit(&Shm->WritePos, memory_order_acquire);
+        VBus_Bus[BusIdx].Overruns = 0u;
+    }
+    return E_OK;
+}
+
+FUNC(Std_ReturnType, VBUS_CODE) VBus_Transmit(uint8 BusIdx, uint32 FrameId, P2CONST(uint8, AUTOMATIC, VBUS_APPL_DATA) Data, uint16 Length) {
+    P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm = VBus_Bus[BusIdx].Shm;
+    P2VAR(VBus_SlotHeaderType, AUTOMATIC, VBUS_VAR_NOINIT) Slot;
+    uint64 Pos;
+
+    if (Length > VBus_BusConfig[BusIdx].SlotPayload) {
+        return E_NOT_OK;
+    }
+
+    Pos = atomic_fetch_add_explicit(&Shm->WritePos, 1u, memory_order_relaxed);
+    Slot = VBus_Slot(Shm, Pos);
+
+    // Seqlock write: invalidate, fill, publish
+    atomic_store_explicit(&Slot->Seq, 0u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    Slot->FrameId = FrameId;
+    Slot->Length = Length;
+    Slot->SrcEcu = VBus_EcuId;
+    (void)memcpy((uint8*)&Slot[1], Data, Length);
+    atomic_store_explicit(&Slot->Seq, Pos + 1u, memory_order_release);
+    return E_OK;
+}
+
+FUNC(void, VBUS_CODE) VBus_PollBus(uint8 BusIdx) {
+    // Deliver up to VBUS_RX_BUDGET frames of one bus to its configured Rx indication
+    P2VAR(VBus_BusStateType, AUTOMATIC, VBUS_VAR_NOINIT) Bus = &VBus_Bus[BusIdx];
+    P2VAR(VBus_ShmType, AUTOMATIC, VBUS_VAR_NOINIT) Shm = Bus->Shm;
+    uint8 Payload[VBUS_MAX_SLOT_PAYLOAD];
+    uint16 Budget;
+
+    for (Budget = 0u; Budget < VBUS_RX_BUDGET; Budget++) {
+        P2VAR(VBus_SlotHeaderType, AUTOMATIC, VBUS_VAR_NOINIT) Slot;
+        uint64 WritePos = atomic_load_explicit(&Shm->WritePos, memory_order_acquire);
+        uint64 Seq1;
+        uint64 Seq2;
+        uint32 FrameId;
+        uint16 Length;
+        uint8 SrcEcu;
+        PduInfoType PduInfo;
+
+        if (Bus->ReadPos == WritePos) {
+            break;
+        }
+        if ((WritePos - Bus->ReadPos) > Shm->NumSlots) {
+            // Lapped by the writers: skip to the oldest slot still intact
+            Bus->Overruns += (uint32)(WritePos - Bus->ReadPos - Shm->NumSlots);
+            Bus->ReadPos = WritePos - Shm->NumSlots;
+        }
+
+        Slot = VBus_Slot(Shm, Bus->ReadPos);
+        Seq1 = atomic_load_explicit(&Slot->Seq, memory_order_acquire);
+        if (Seq1 != (Bus->ReadPos + 1u)) {
+            if (Seq1 > (Bus->ReadPos + 1u)) {
+                Bus->Overruns++;        // Already overwritten by a newer frame
+                Bus->ReadPos++;
+                continue;
+            }
+            break;                      // Claimed but not yet published
+        }
+
+        FrameId = Slot->FrameId;
+        Length = Slot->Length;
+        SrcEcu = Slot->SrcEcu;
+        if (Length > VBUS_MAX_SLOT_PAYLOAD) {
+            Length = VBUS_MAX_SLOT_PAYLOAD;
+        }
+        (void)memcpy(Payload, (const uint8*)&Slot[1], Length);
+        atomic_thread_fence(memory_order_acquire);
+        Seq2 = atomic_load_explicit(&Slot->Seq, memory_order_relaxed);
+        Bus->ReadPos++;
+
+        if (Seq2 != Seq1) {
+            Bus->Overruns++;            // Torn read: writer reused the slot meanwhile
+            continue;
+        }
+        if (SrcEcu == VBus_EcuId) {
+            continue;                   // Own frame
+        }
+
+        PduInfo.SduDataPtr = Payload;
+        PduInfo.MetaDataPtr = NULL_PTR;
+        PduInfo.SduLength = Length;
+        VBus_BusConfig[BusIdx].RxIndication(BusIdx, FrameId, &PduInfo);
+    }
+}
+
+FUNC(uint32, VBUS_CODE) VBus_GetOverruns(uint8 BusIdx) {
+    // Frames this ECU missed on the bus since VBus_Init (lapped or torn slots)
+    return VBus_Bus[BusIdx].Overruns;
+}
+
+/* SIL DRIVERS ON THE VIRTUAL BUS */
+// File: Can_VBus.c
+#include <string.h>
+
+static VAR(Can_HwHandleType, CAN_VAR_NOINIT) Can_VBusTxDone[CAN_NUM_OF_HTH];
+static VAR(uint16, CAN_VAR_NOINIT) Can_VBusTxDoneCount;
+static VAR(boolean, CAN_VAR_NOINIT) Can_VBusHthBusy[CAN_NUM_OF_HTH];
+
+static FUNC(Std_ReturnType, CAN_CODE) Can_VBus_Init(void) {
+    Can_VBusTxDoneCount = 0u;
+    (void)memset(Can_VBusHthBusy, 0, sizeof(Can_VBusHthBusy));
+    return E_OK;    // Segments are attached by VBus_Init from EcuM
+}
+
+static FUNC(Std_ReturnType, CAN_CODE) Can_VBus_Transmit(uint8 Controller, Can_HwHandleType Hth, P2CONST(Can_PduType, AUTOMATIC, CAN_APPL_CONST) PduInfo) {
+    // The frame is on the bus once copied into the ring; confirm from the next MainFunction_Write
+    if (Can_VBusHthBusy[Hth] == TRUE) {
+        return CAN_BUSY;
+    }
+    if (VBus_Transmit(Can_VBusControllerBus[Controller], PduInfo->id, PduInfo->sdu, PduInfo->length) != E_OK) {
+        return E_NOT_OK;
+    }
+    Can_VBusHthBusy[Hth] = TRUE;
+    Can_VBusTxDone[Can_VBusTxDoneCount] = Hth;
+    Can_VBusTxDoneCount++;
+    return E_OK;
+}
+
+static FUNC(void, CAN_CODE) Can_VBus_MainFunction_Write(void) {
+    // Snapshot the count: confirmations may queue new frames through CanIf
+    uint16 Count = Can_VBusTxDoneCount;
+    Can_HwHandleType Done[CAN_NUM_OF_HTH];
+    uint16 i;
+
+    for (i = 0u; i < Count; i++) {
+        Done[i] = Can_VBusTxDone[i];
+    }
+    Can_VBusTxDoneCount = 0u;
+    for (i = 0u; i < Count; i++) {
+        Can_VBusHthBusy[Done[i]] = FALSE;
+        Can_TxConfirmationHandler(Done[i]);
+    }
+}
+
+static FUNC(void, CAN_CODE) Can_VBus_MainFunction_Read(void) {
+    uint8 Controller;
+
+    for (Controller = 0u; Controller < CAN_NUM_OF_CONTROLLERS; Controller++) {
+        VBus_PollBus(Can_VBusControllerBus[Controller]);
+    }
+}
+
+FUNC(void, CAN_CODE) Can_VBus_RxIndication(uint8 BusIdx, uint32 FrameId, P2CONST(PduInfoType, AUTOMATIC, CAN_APPL_DATA) PduInfoPtr) {
+    Can_HwType Mailbox;
+
+    Mailbox.CanId = FrameId;
+    Mailbox.Hoh = Can_VBusBusConfig[BusIdx].Hrh;
+    Mailbox.ControllerId = Can_VBusBusConfig[BusIdx].Controller;
+    CanIf_RxIndication(&Mailbox, PduInfoPtr);
+}
+
+CONST(Can_BackendType, CAN_CONST) Can_VBusBackend = {
+    &Can_VBus_Init,
+    &Can_VBus_Transmit,
+    &Can_VBus_MainFunction_Write,
+    &Can_VBus_MainFunction_Read,
+};
+
+// File: Lin_VBus.c
+FUNC(Std_ReturnType, LIN_CODE) Lin_VBus_SendFrame(uint8 Channel, uint8 Pid, P2CONST(PduInfoType, AUTOMATIC, LIN_APPL_DATA) PduInfoPtr) {
+    return VBus_Transmit(Lin_VBusChannelBus[Channel], Pid, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+}
+
+FUNC(void, LIN_CODE) Lin_VBus_MainFunction(void) {
+    uint8 Channel;
+
+    for (Channel = 0u; Channel < LIN_NUM_OF_CHANNELS; Channel++) {
+        VBus_PollBus(Lin_VBusChannelBus[Channel]);
+    }
+}
+
+// File: Eth_VBus.c
+FUNC(Std_ReturnType, ETH_CODE) Eth_VBus_Transmit(uint8 CtrlIdx, PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, ETH_APPL_DATA) PduInfoPtr) {
+    return VBus_Transmit(Eth_VBusCtrlBus[CtrlIdx], TxPduId, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+}
+
+FUNC(void, ETH_CODE) Eth_VBus_MainFunction(void) {
+    uint8 CtrlIdx;
+
+    for (CtrlIdx = 0u; CtrlIdx < ETH_NUM_OF_CONTROLLERS; CtrlIdx++) {
+        VBus_PollBus(Eth_VBusCtrlBus[CtrlIdx]);
+    }
+}
+
+/* DIO DRIVER STACK */
+// File: Dio.c
+FUNC(Dio_LevelType, DIO_CODE) Dio_ReadChannel(Dio_ChannelType ChannelId) {
+    // Step 36: Digital I/O MCAL Driver
+    P2CONST(Dio_ChannelConfigType, AUTOMATIC, DIO_CONST) ChannelConfig = &Dio_ConfigPtr->DioChannel[ChannelId];
+    
+    return Dio_Infineon_TC39x_ReadChannel(ChannelConfig->DioPortRef, ChannelConfig->DioBitPosition);
+}
+
+/* PWM DRIVER STACK */
+// File: Pwm.c
+FUNC(void, PWM_CODE) Pwm_SetDutyCycle(Pwm_ChannelType ChannelNumber, uint16 DutyCycle) {
+    // Step 37: PWM MCAL Driver
+    P2CONST(Pwm_ChannelConfigType, AUTOMATIC, PWM_CONST) ChannelConfig = &Pwm_ConfigPtr->PwmChannel[ChannelNumber];
+    
+    Pwm_Infineon_TC39x_SetDutyCycle(ChannelConfig->PwmHwChannel, DutyCycle);
+}
+
+/* ADC DRIVER STACK */
+// File: Adc.c
+FUNC(Std_ReturnType, ADC_CODE) Adc_ReadGroup(Adc_GroupType Group, P2VAR(Adc_ValueType, AUTOMATIC, ADC_APPL_DATA) DataBufferPtr) {
+    // Step 38: ADC MCAL Driver
+    P2CONST(Adc_GroupConfigType, AUTOMATIC, ADC_CONST) GroupConfig = &Adc_ConfigPtr->AdcGroup[Group];
+    
+    return Adc_Infineon_TC39x_ReadGroup(GroupConfig->AdcGroupId, DataBufferPtr);
+}
+
+/* GPT DRIVER STACK */
+// File: Gpt.c
+FUNC(void, GPT_CODE) Gpt_StartTimer(Gpt_ChannelType Channel, Gpt_ValueType Value) {
+    // Step 39: General Purpose Timer MCAL Driver
+    P2CONST(Gpt_ChannelConfigType, AUTOMATIC, GPT_CONST) ChannelConfig = &Gpt_ConfigPtr->GptChannel[Channel];
+    
+    Gpt_Infineon_TC39x_StartTimer(ChannelConfig->GptChannelId, Value);
+}
+
+/* SPI DRIVER STACK */
+// File: Spi.c
+FUNC(Std_ReturnType, SPI_CODE) Spi_WriteIB(Spi_ChannelType Channel, P2CONST(Spi_DataBufferType, AUTOMATIC, SPI_APPL_CONST) DataBufferPtr) {
+    // Step 40: SPI MCAL Driver
+    P2CONST(Spi_ChannelConfigType, AUTOMATIC, SPI_CONST) ChannelConfig = &Spi_ConfigPtr->SpiChannel[Channel];
+    
+    return Spi_Infineon_TC39x_WriteChannel(ChannelConfig->SpiChannelId, DataBufferPtr);
+}
+
+/* ICU DRIVER STACK */
+// File: Icu.c
+FUNC(void, ICU_CODE) Icu_EnableNotification(Icu_ChannelType Channel) {
+    // Step 41: Input Capture Unit MCAL Driver
+    P2CONST(Icu_ChannelConfigType, AUTOMATIC, ICU_CONST) ChannelConfig = &Icu_ConfigPtr->IcuChannel[Channel];
+    
+    Icu_Infineon_TC39x_EnableNotification(ChannelConfig->IcuChannelId);
+}
+
+/* FLASH DRIVER STACK */
+// File: Fls.c
+FUNC(Std_ReturnType, FLS_CODE) Fls_Write(Fls_AddressType TargetAddress, P2CONST(uint8, AUTOMATIC, FLS_APPL_CONST) SourceAddressPtr, Fls_LengthType Length) {
+    // Step 42: Flash MCAL Driver
+    return Fls_Infineon_TC39x_Write(TargetAddress, SourceAddressPtr, Length);
+}
+
+/* MCU DRIVER STACK */
+// File: Mcu.c
+FUNC(Std_ReturnType, MCU_CODE) Mcu_InitClock(Mcu_ClockType ClockSetting) {
+    // Step 43: Microcontroller Unit MCAL Driver
+    P2CONST(Mcu_ClockConfigType, AUTOMATIC, MCU_CONST) ClockConfig = &Mcu_ConfigPtr->McuClockConfig[ClockSetting];
+    
+    return Mcu_Infineon_TC39x_InitClock(ClockConfig);
+}
+
+/* PORT DRIVER STACK */
+// File: Port.c
+FUNC(void, PORT_CODE) Port_SetPinDirection(Port_PinType Pin, Port_PinDirectionType Direction) {
+    // Step 44: Port MCAL Driver
+    P2CONST(Port_PinConfigType, AUTOMATIC, PORT_CONST) PinConfig = &Port_ConfigPtr->PortPin[Pin];
+    
+    Port_Infineon_TC39x_SetPinDirection(PinConfig->PortNumber, PinConfig->PinNumber, Direction);
+}
+
+/* WATCHDOG DRIVER STACK */
+// File: Wdg.c
+FUNC(Std_ReturnType, WDG_CODE) Wdg_SetTriggerCondition(uint16 timeout) {
+    // Step 45: Watchdog MCAL Driver
+    return Wdg_Infineon_TC39x_SetTriggerCondition(timeout);
+}
+
+/* =========================================================================
+ * HOST BENCHMARKS (SIL BUILD ONLY)
+ * ========================================================================= */
+
+/* COMMON BENCHMARK HELPERS */
+// File: Bench_Common.h
+#include <stdio.h>
+#include <time.h>
+
+static inline double Bench_NowSeconds(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/* COM SIGNAL PACKING BENCHMARK */
+// File: Bench_ComPack.c
+#include "Bench_Common.h"
+#include "Com.h"
+#include "PduBuf.h"
+
+#define BENCH_COMPACK_ITERATIONS    100000u
+
+int main(void) {
+    // Compare the per-signal Com_PackSignal path against the table-driven I-PDU pack pass
+    uint64 value = 0x5Au;
+    uint32 iter;
+    Com_SignalIdType SignalId;
+    PduIdType IpduId;
+    double start, perSignal, perIpdu;
+    double signals = (double)BENCH_COMPACK_ITERATIONS * (double)COM_NUM_OF_TX_SIGNALS;
+
+    PduBuf_Init();
+    Com_Init(&Com_Config);
+
+    start = Bench_NowSeconds();
+    for (iter = 0u; iter < BENCH_COMPACK_ITERATIONS; iter++) {
+        for (SignalId = 0u; SignalId < COM_NUM_OF_TX_SIGNALS; SignalId++) {
+            P2CONST(Com_TxSignalType, AUTOMATIC, COM_CONST) SignalPtr = &Com_ConfigPtr->ComTxSignal[SignalId];
+            Com_PackSignal(SignalPtr, &value, Com_GetTxIpduBuffer(SignalPtr->ComIPduRef));
+        }
+        value++;
+    }
+    perSignal = Bench_NowSeconds() - start;
+
+    start = Bench_NowSeconds();
+    for (iter = 0u; iter < BENCH_COMPACK_ITERATIONS; iter++) {
+        for (SignalId = 0u; SignalId < COM_NUM_OF_TX_SIGNALS; SignalId++) {
+            (void)Com_StageTxSignal(SignalId, &value);
+        }
+        for (IpduId = 0u; IpduId < COM_NUM_OF_TX_IPDUS; IpduId++) {
+            (void)Com_PackTxIPdu(IpduId);
+        }
+        value++;
+    }
+    perIpdu = Bench_NowSeconds() - start;
+
+    printf("Com_PackSignal : %.2f Msignals/s\n", (signals / perSignal) * 1e-6);
+    printf("Com_PackTxIPdu : %.2f Msignals/s\n", (signals / perIpdu) * 1e-6);
+    return 0;
+}
+
+/* PDUR ROUTING BENCHMARK */
+// File: Bench_PduRRouting.c
+#include "Bench_Common.h"
+#include "PduR.h"
+
+#define BENCH_PDUR_ITERATIONS       1000000u
+
+// Pre-generator routing: configuration lookup plus module switch per transmit
+static FUNC(Std_ReturnType, PDUR_CODE) Bench_PduR_SwitchTransmit(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info) {
+    P2CONST(PduR_DestPduType, AUTOMATIC, PDUR_CONST) DestPdu = &PduR_ConfigPtr->PduRDestPdu[id];
+
+    switch(DestPdu->DestModuleAPIRef) {
+        case PDUR_CANIF:
+            return CanIf_Transmit(DestPdu->DestPduRef, info);
+        case PDUR_LINIF:
+            return LinIf_Transmit(DestPdu->DestPduRef, info);
+        default:
+            return E_NOT_OK;
+    }
+}
+
+int main(void) {
+    // Per-PDU routing latency of the unicast DoorStatus path, before and after
+    static uint8 payload[8] = { 0u };
+    PduInfoType info = { payload, NULL_PTR, 8u };
+    uint32 iter;
+    double start, before, after;
+
+    start = Bench_NowSeconds();
+    for (iter = 0u; iter < BENCH_PDUR_ITERATIONS; iter++) {
+        (void)Bench_PduR_SwitchTransmit(ComConf_ComIPdu_DoorStatus, &info);
+    }
+    before = Bench_NowSeconds() - start;
+
+    start = Bench_NowSeconds();
+    for (iter = 0u; iter < BENCH_PDUR_ITERATIONS; iter++) {
+        (void)PduR_ComTransmit(ComConf_ComIPdu_DoorStatus, &info);
+    }
+    after = Bench_NowSeconds() - start;
+
+    printf("switch routing : %.1f ns/PDU\n", (before / (double)BENCH_PDUR_ITERATIONS) * 1e9);
+    printf("table routing  : %.1f ns/PDU\n", (after / (double)BENCH_PDUR_ITERATIONS) * 1e9);
+    return 0;
+}
+
+/* VIRTUAL BUS BENCHMARK */
+// File: Bench_VBus.c
+/* Linked with VBus and VBus_Cfg_Bench.c: one bus "/vbus_bench" of 65536
+ * slots with 8-byte payloads, whose RxIndication is Bench_VBusRxIndication.
+ * The writer (ECU 1) and a forked reader (ECU 2) exchange BENCH_VBUS_FRAMES
+ * frames, first paced at BENCH_VBUS_PACED_RATE, then as fast as the writer
+ * can claim slots. The frame ID is the sequence number, so the reader counts
+ * lost frames besides the overruns VBus detects itself. */
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Bench_Common.h"
+#include "VBus.h"
+
+#define BENCH_VBUS_FRAMES       5000000u
+#define BENCH_VBUS_PACED_RATE   3.0e6           // Frames per second
+#define BENCH_VBUS_END_ID       0xFFFFFFFFu     // Closes a run
+
+typedef struct {
+    uint32 Received;
+    uint32 Lost;
+    uint32 Overruns;
+    double Seconds;
+} Bench_VBusResultType;
+
+static uint32 Bench_VBusExpected;
+static uint32 Bench_VBusReceived;
+static uint32 Bench_VBusLost;
+static boolean Bench_VBusEnd;
+
+FUNC(void, VBUS_CODE) Bench_VBusRxIndication(uint8 BusIdx, uint32 FrameId, P2CONST(PduInfoType, AUTOMATIC, VBUS_APPL_DATA) PduInfoPtr) {
+    (void)BusIdx;
+    (void)PduInfoPtr;
+    if (FrameId == BENCH_VBUS_END_ID) {
+        Bench_VBusEnd = TRUE;
+        return;
+    }
+    Bench_VBusLost += FrameId - Bench_VBusExpected;
+    Bench_VBusExpected = FrameId + 1u;
+    Bench_VBusReceived++;
+}
+
+static void Bench_VBusReader(sint32 ReadyFd, sint32 ResultFd) {
+    // ECU 2: attach, report ready, poll until the closing frame
+    Bench_VBusResultType Result;
+    uint8 Ready = 1u;
+    double start;
+
+    if (VBus_Init(2u) != E_OK) {
+        _exit(1);
+    }
+    Bench_VBusExpected = 0u;
+    Bench_VBusReceived = 0u;
+    Bench_VBusLost = 0u;
+    Bench_VBusEnd = FALSE;
+    (void)write(ReadyFd, &Ready, 1u);
+
+    start = Bench_NowSeconds();
+    while (Bench_VBusEnd == FALSE) {
+        VBus_PollBus(0u);
+    }
+    Result.Received = Bench_VBusReceived;
+    Result.Lost = Bench_VBusLost;
+    Result.Overruns = VBus_GetOverruns(0u);
+    Result.Seconds = Bench_NowSeconds() - start;
+    (void)write(ResultFd, &Result, sizeof(Result));
+    _exit(0);
+}
+
+static void Bench_VBusRun(double Rate) {
+    // Rate 0: unpaced writer
+    Bench_VBusResultType Result;
+    sint32 Ready[2];
+    sint32 Done[2];
+    uint8 Data[8] = { 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u, 0x77u, 0x88u };
+    uint8 Byte;
+    uint32 i;
+    pid_t Reader;
+    double start, writer;
+
+    if (pipe(Ready) != 0) {
+        return;
+    }
+    if (pipe(Done) != 0) {
+        (void)close(Ready[0]);
+        (void)close(Ready[1]);
+        return;
+    }
+    Reader = fork();
+    if (Reader == 0) {
+        (void)close(Ready[0]);
+        (void)close(Done[0]);
+        Bench_VBusReader(Ready[1], Done[1]);
+    }
+    // Keep only the read ends: a reader that exits early then reads as EOF instead of blocking
+    (void)close(Ready[1]);
+    (void)close(Done[1]);
+    if ((Reader < 0) || (read(Ready[0], &Byte, 1u) != 1)) {
+        printf("reader did not attach\n");
+        if (Reader > 0) {
+            (void)waitpid(Reader, NULL, 0);
+        }
+        (void)close(Ready[0]);
+        (void)close(Done[0]);
+        return;
+    }
+
+    start = Bench_NowSeconds();
+    for (i = 0u; i < BENCH_VBUS_FRAMES; i++) {
+        if ((Rate > 0.0) && ((i & 63u) == 0u)) {
+            while (Bench_NowSeconds() < (start + ((double)i / Rate))) {
+            }
+        }
+        (void)VBus_Transmit(0u, i, Data, sizeof(Data));
+    }
+    writer = Bench_NowSeconds() - start;
+    (void)VBus_Transmit(0u, BENCH_VBUS_END_ID, Data, 0u);
+
+    if (read(Done[0], &Result, sizeof(Result)) == (ssize_t)sizeof(Result)) {
+        printf("%-8s: writer %5.2f Mframes/s, reader %5.2f Mframes/s, %u received, %u lost, %u overruns\n",
+               (Rate > 0.0) ? "paced" : "unpaced", ((double)BENCH_VBUS_FRAMES / writer) * 1e-6,
+               ((double)Result.Received / Result.Seconds) * 1e-6, Result.Received, Result.Lost, Result.Overruns);
+    }
+    (void)waitpid(Reader, NULL, 0);
+    (void)close(Ready[0]);
+    (void)close(Done[0]);
+}
+
+int main(void) {
+    (void)shm_unlink(VBus_BusConfig[0].ShmName);    // Leftover of an earlier run
+    if (VBus_Init(1u) != E_OK) {
+        printf("VBus_Init failed\n");
+        return 1;
+    }
+    Bench_VBusRun(BENCH_VBUS_PACED_RATE);
+    Bench_VBusRun(0.0);
+    (void)shm_unlink(VBus_BusConfig[0].ShmName);
+    return 0;
+}
+
+/* OS SCHEDULER BENCHMARK */
+// File: Bench_OsSchedule.c
+// Linked with the SIL OS port, whose Os_SwitchContext only records the running task
+#include "Bench_Common.h"
+#include "Os.h"
+
+#define BENCH_OS_NUM_OF_TASKS       256u    // Task i has priority i
+#define BENCH_OS_ACTIVATOR_TASK     255u
+#define BENCH_OS_ROUNDS             10000u
+
+int main(void) {
+    // The top-priority task activates the 255 others in scrambled order, so each
+    // TerminateTask dispatches from a ready queue holding up to 255 entries
+    uint32 round;
+    uint32 i;
+    double start, elapsed;
+
+    Os_InitCore(GetCoreID());
+    start = Bench_NowSeconds();
+    for (round = 0u; round < BENCH_OS_ROUNDS; round++) {
+        (void)ActivateTask(BENCH_OS_ACTIVATOR_TASK);
+        for (i = 0u; i < (BENCH_OS_NUM_OF_TASKS - 1u); i++) {
+            // Multiplying by a number coprime to 255 permutes 0..254
+            (void)ActivateTask((TaskType)((i * 167u) % (BENCH_OS_NUM_OF_TASKS - 1u)));
+        }
+        for (i = 0u; i < BENCH_OS_NUM_OF_TASKS; i++) {
+            (void)TerminateTask();
+        }
+    }
+    elapsed = Bench_NowSeconds() - start;
+
+    printf("activate->dispatch : %.1f ns (%u tasks)\n",
+           (elapsed / ((double)BENCH_OS_ROUNDS * BENCH_OS_NUM_OF_TASKS)) * 1e9, BENCH_OS_NUM_OF_TASKS);
+    return 0;
+}
+
+/* OS ALARM BENCHMARK */
+// File: Bench_OsAlarm.c
+// Linked with a SIL OS configuration of BENCH_ALARM_COUNT callback alarms on counter 0
+#include "Bench_Common.h"
+#include "Os.h"
+
+#define BENCH_ALARM_COUNT           4096u
+#define BENCH_ALARM_TICKS           1000000u
+#define BENCH_ALARM_MAX_CYCLE       1000u
+
+static uint32 Bench_AlarmExpiries;
+static uint32 Bench_ScanRemaining[BENCH_ALARM_COUNT];
+static uint32 Bench_ScanCycle[BENCH_ALARM_COUNT];
+
+FUNC(void, OS_APPL_CODE) Bench_AlarmCallback(void) {
+    // OsAlarmCallbackName of every benchmark alarm
+    Bench_AlarmExpiries++;
+}
+
+int main(void) {
+    // Baseline: one countdown per alarm, decremented by every tick
+    uint32 tick;
+    uint32 i;
+    uint32 scanned = 0u;
+    double start, scan, wheel;
+
+    for (i = 0u; i < BENCH_ALARM_COUNT; i++) {
+        Bench_ScanCycle[i] = 1u + ((i * 7919u) % BENCH_ALARM_MAX_CYCLE);
+        Bench_ScanRemaining[i] = Bench_ScanCycle[i];
+    }
+    start = Bench_NowSeconds();
+    for (tick = 0u; tick < BENCH_ALARM_TICKS; tick++) {
+        for (i = 0u; i < BENCH_ALARM_COUNT; i++) {
+            if (--Bench_ScanRemaining[i] == 0u) {
+                Bench_ScanRemaining[i] = Bench_ScanCycle[i];
+                scanned++;
+            }
+        }
+    }
+    scan = Bench_NowSeconds() - start;
+
+    Os_InitCore(GetCoreID());
+    Os_InitCounters(GetCoreID());
+    for (i = 0u; i < BENCH_ALARM_COUNT; i++) {
+        (void)SetRelAlarm((AlarmType)i, 1u + ((i * 7919u) % BENCH_ALARM_MAX_CYCLE), 1u + ((i * 7919u) % BENCH_ALARM_MAX_CYCLE));
+    }
+    start = Bench_NowSeconds();
+    for (tick = 0u; tick < BENCH_ALARM_TICKS; tick++) {
+        (void)IncrementCounter(0u);
+    }
+    wheel = Bench_NowSeconds() - start;
+
+    printf("linear scan    : %.1f ns/tick (%u expiries)\n", (scan / (double)BENCH_ALARM_TICKS) * 1e9, scanned);
+    printf("timing wheel   : %.1f ns/tick (%u expiries, %.1f ns/expiry)\n", (wheel / (double)BENCH_ALARM_TICKS) * 1e9,
+           Bench_AlarmExpiries, (wheel / (double)Bench_AlarmExpiries) * 1e9);
+    return 0;
+}
+
+/* OS SCHEDULE TABLE SYNCHRONIZATION TEST */
+// File: Test_OsScheduleTable.c
+/* Linked with the SIL OS port and one repeating, explicitly synchronized
+ * schedule table TEST_OS_TABLE on counter 0: duration TEST_OS_DURATION,
+ * expiry points at offsets 0, 4 and 10 (final delay 0) with
+ * OsScheduleTblMaxRetard 0, 0 and 2, precision 0. The table is synchronized
+ * 2 ticks behind, so the whole retard falls on the zero delay after offset
+ * 10: it must stay zero, the deviation must be kept for later expiry points
+ * and the table must keep expiring within one duration. */
+#include "Bench_Common.h"
+#include "Os.h"
+
+#define TEST_OS_TABLE               0u
+#define TEST_OS_DURATION            10u
+#define TEST_OS_ROUNDS              5u
+
+int main(void) {
+    AlarmType AlarmID = Os_ScheduleTableConfig[TEST_OS_TABLE].AlarmRef;
+    ScheduleTableStatusType Status;
+    TickType Ticks;
+    uint32 tick;
+    uint32 Failures = 0u;
+
+    Os_InitCore(GetCoreID());
+    Os_InitCounters(GetCoreID());
+    (void)StartScheduleTableSynchron(TEST_OS_TABLE);
+    (void)SyncScheduleTable(TEST_OS_TABLE, 0u);        // Offset 0 expires in TEST_OS_DURATION ticks
+    for (tick = 0u; tick <= TEST_OS_DURATION; tick++) {
+        (void)IncrementCounter(0u);
+    }
+    (void)SyncScheduleTable(TEST_OS_TABLE, 3u);        // Table at offset 1: 2 ticks behind
+
+    for (tick = 0u; tick < (TEST_OS_ROUNDS * TEST_OS_DURATION); tick++) {
+        (void)IncrementCounter(0u);
+        if ((GetAlarm(AlarmID, &Ticks) != E_OK) || (Ticks == 0u) || (Ticks > TEST_OS_DURATION)) {
+            printf("FAIL tick %u: next expiry point %u ticks away\n", tick, (uint32)Ticks);
+            Failures++;
+            break;
+        }
+    }
+    (void)GetScheduleTableStatus(TEST_OS_TABLE, &Status);
+    if (Status != SCHEDULETABLE_RUNNING) {
+        printf("FAIL status %u after a retard on the zero delay\n", (uint32)Status);
+        Failures++;
+    }
+    if (Failures == 0u) {
+        printf("ok   retard on a zero final delay\n");
+    }
+    return (Failures == 0u) ? 0 : 1;
+}
+
+/* CANTP THROUGHPUT BENCHMARK */
+// File: Bench_CanTpThroughput.c
+/* Linked with CanTp, CanTp_PBcfg_Bench.c and this file in place of CanIf and
+ * PduR. Channels 2k and 2k+1 are looped back to each other; pair 0 is
+ * classic CAN (TX_DL 8), pair 1 CAN-FD (TX_DL 64) with BS 0, pair 2 CAN-FD
+ * with BS 8, pairs 3 and up CAN-FD with BS 0 for the parallel run. STmin is
+ * 0 throughout, so the bus is never idle and the figures are CanTp's own
+ * cost per byte. PduLengthType is uint32 in the SIL configuration. */
+#include <stdlib.h>
+#include "Bench_Common.h"
+#include "CanTp.h"
+
+#define BENCH_CANTP_PAYLOAD         (4uL * 1024uL * 1024uL)    // Flash image size
+#define BENCH_CANTP_PARALLEL_PAIRS  64u
+#define BENCH_CANTP_QUEUE_DEPTH     256u                        // Power of two
+
+typedef struct {
+    PduIdType TxPduId;
+    uint8 Length;
+    uint8 Data[64];
+} Bench_CanTpFrameType;
+
+static Bench_CanTpFrameType Bench_CanTpQueue[BENCH_CANTP_QUEUE_DEPTH];
+static uint32 Bench_CanTpQueueHead;
+static uint32 Bench_CanTpQueueTail;
+static uint32 Bench_CanTpFrames;
+
+static uint8* Bench_CanTpSource;
+static uint8* Bench_CanTpSink;
+static PduLengthType Bench_CanTpTxPos[CANTP_NUM_OF_CHANNELS];
+static PduLengthType Bench_CanTpRxPos[CANTP_NUM_OF_CHANNELS];
+static PduLengthType Bench_CanTpOffset[CANTP_NUM_OF_CHANNELS];   // Of the channel's part of the image
+static uint32 Bench_CanTpDone;
+static uint32 Bench_CanTpFailed;
+
+FUNC(Std_ReturnType, CANIF_CODE) CanIf_Transmit(PduIdType TxPduId, P2CONST(PduInfoType, AUTOMATIC, CANIF_APPL_CONST) PduInfoPtr) {
+    // The bus: one frame at a time, delivered in order by Bench_CanTpPump
+    P2VAR(Bench_CanTpFrameType, AUTOMATIC, AUTOMATIC) Frame;
+
+    if ((Bench_CanTpQueueTail - Bench_CanTpQueueHead) == BENCH_CANTP_QUEUE_DEPTH) {
+        return E_NOT_OK;
+    }
+    Frame = &Bench_CanTpQueue[Bench_CanTpQueueTail & (BENCH_CANTP_QUEUE_DEPTH - 1u)];
+    Frame->TxPduId = TxPduId;
+    Frame->Length = (uint8)PduInfoPtr->SduLength;
+    (void)memcpy(Frame->Data, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+    Bench_CanTpQueueTail++;
+    return E_OK;
+}
+
+static void Bench_CanTpPump(void) {
+    // Receiver first, then the sender's confirmation, as seen on a real bus
+    while (Bench_CanTpQueueHead != Bench_CanTpQueueTail) {
+        P2VAR(Bench_CanTpFrameType, AUTOMATIC, AUTOMATIC) Frame = &Bench_CanTpQueue[Bench_CanTpQueueHead & (BENCH_CANTP_QUEUE_DEPTH - 1u)];
+        PduInfoType PduInfo = { Frame->Data, NULL_PTR, Frame->Length };
+
+        Bench_CanTpQueueHead++;
+        Bench_CanTpFrames++;
+        CanTp_RxIndication((PduIdType)(Frame->TxPduId ^ 1u), &PduInfo);
+        CanTp_TxConfirmation(Frame->TxPduId, E_OK);
+    }
+}
+
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_CanTpCopyTxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                        P2CONST(RetryInfoType, AUTOMATIC, PDUR_APPL_DATA) retry,
+                                                        P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) availableDataPtr) {
+    (void)retry;
+    (void)memcpy(info->SduDataPtr, &Bench_CanTpSource[Bench_CanTpOffset[id] + Bench_CanTpTxPos[id]], info->SduLength);
+    Bench_CanTpTxPos[id] += info->SduLength;
+    *availableDataPtr = 0u;
+    return BUFREQ_OK;
+}
+
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_CanTpStartOfReception(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                              PduLengthType TpSduLength, P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) bufferSizePtr) {
+    (void)info;
+    Bench_CanTpRxPos[id] = 0u;
+    *bufferSizePtr = TpSduLength;   // The whole image fits: one block when BS is 0
+    return BUFREQ_OK;
+}
+
+FUNC(BufReq_ReturnType, PDUR_CODE) PduR_CanTpCopyRxData(PduIdType id, P2CONST(PduInfoType, AUTOMATIC, PDUR_APPL_DATA) info,
+                                                        P2VAR(PduLengthType, AUTOMATIC, PDUR_APPL_DATA) bufferSizePtr) {
+    // The receiving channel is the sender's peer, so its part of the image is at the peer's offset
+    (void)memcpy(&Bench_CanTpSink[Bench_CanTpOffset[id ^ 1u] + Bench_CanTpRxPos[id]], info->SduDataPtr, info->SduLength);
+    Bench_CanTpRxPos[id] += info->SduLength;
+    *bufferSizePtr = BENCH_CANTP_PAYLOAD;
+    return BUFREQ_OK;
+}
+
+FUNC(void, PDUR_CODE) PduR_CanTpRxIndication(PduIdType id, Std_ReturnType result) {
+    (void)id;
+    if (result != E_OK) {
+        Bench_CanTpFailed++;
+    }
+}
+
+FUNC(void, PDUR_CODE) PduR_CanTpTxConfirmation(PduIdType id, Std_ReturnType result) {
+    (void)id;
+    if (result != E_OK) {
+        Bench_CanTpFailed++;
+    }
+    Bench_CanTpDone++;
+}
+
+static void Bench_CanTpRun(const char* Name, uint16 FirstPair, uint16 NumPairs) {
+    // Split the image over NumPairs connections, start them all, then let the bus and main function run
+    PduLengthType Part = (PduLengthType)(BENCH_CANTP_PAYLOAD / NumPairs);
+    PduInfoType PduInfo = { NULL_PTR, NULL_PTR, Part };
+    uint32 Ticks = 0u;
+    uint16 Pair;
+    double start, elapsed;
+
+    (void)memset(Bench_CanTpSink, 0, BENCH_CANTP_PAYLOAD);
+    Bench_CanTpFrames = 0u;
+    Bench_CanTpDone = 0u;
+    Bench_CanTpFailed = 0u;
+
+    start = Bench_NowSeconds();
+    for (Pair = FirstPair; Pair < (FirstPair + NumPairs); Pair++) {
+        PduIdType Tx = (PduIdType)(2u * Pair);
+
+        Bench_CanTpOffset[Tx] = (PduLengthType)((Pair - FirstPair) * Part);
+        Bench_CanTpTxPos[Tx] = 0u;
+        (void)CanTp_Transmit(Tx, &PduInfo);
+    }
+    while (Bench_CanTpDone < NumPairs) {
+        Bench_CanTpPump();
+        if (Bench_CanTpDone < NumPairs) {
+            CanTp_MainFunction();
+            Ticks++;
+        }
+    }
+    elapsed = Bench_NowSeconds() - start;
+
+    printf("%-26s: %7.1f MB/s, %8u frames, %6.1f ns/frame, %u main ticks, %s\n", Name,
+           ((double)Part * NumPairs / elapsed) * 1e-6, Bench_CanTpFrames, (elapsed / (double)Bench_CanTpFrames) * 1e9, Ticks,
+           ((Bench_CanTpFailed == 0u) && (memcmp(Bench_CanTpSource, Bench_CanTpSink, (size_t)Part * NumPairs) == 0)) ? "ok" : "CORRUPT");
+}
+
+int main(void) {
+    // 4 MB image over one connection per frame format, then split over many parallel connections
+    uint32 i;
+
+    Bench_CanTpSource = (uint8*)malloc(BENCH_CANTP_PAYLOAD);
+    Bench_CanTpSink = (uint8*)malloc(BENCH_CANTP_PAYLOAD);
+    for (i = 0u; i < BENCH_CANTP_PAYLOAD; i++) {
+        Bench_CanTpSource[i] = (uint8)((i * 2654435761u) >> 24);
+    }
+    CanTp_Init();
+
+    Bench_CanTpRun("CAN TX_DL 8, BS 0", 0u, 1u);
+    Bench_CanTpRun("CAN-FD TX_DL 64, BS 0", 1u, 1u);
+    Bench_CanTpRun("CAN-FD TX_DL 64, BS 8", 2u, 1u);
+    Bench_CanTpRun("CAN-FD x64 connections", 3u, BENCH_CANTP_PARALLEL_PAIRS);
+
+    free(Bench_CanTpSource);
+    free(Bench_CanTpSink);
+    return 0;
+}
+
+/* DOIP LATENCY BENCHMARK */
+// File: Bench_DoIP.c
+/* Linked with DoIP, PduR, Dcm, Dem and the SIL configuration, where
+ * DOIP_EPOLL_TIMEOUT_MS is the 10 ms main-function period and DID 0xF190
+ * (VIN) is readable. The entity runs in its own thread
+ * (DoIP_MainFunction, Dcm_MainFunction). The testers are TCP clients on
+ * 127.0.0.1 driven from one epoll loop. Every session keeps one UDS 0x22
+ * request outstanding, so with N sessions the entity always has N testers
+ * competing for DCM. */
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "Bench_Common.h"
+#include "DoIP.h"
+#include "Dcm.h"
+
+#define BENCH_DOIP_TESTER_ADDRESS   0x0E00u
+#define BENCH_DOIP_REQUESTS         20000u      // Per run, over all sessions
+#define BENCH_DOIP_MAX_SESSIONS     DOIP_MAX_TESTER_CONNECTIONS
+#define BENCH_DOIP_BUFFER_SIZE      512u
+
+typedef struct {
+    int Socket;
+    uint16 TesterAddress;
+    uint32 RxLength;
+    double RequestStart;
+    uint8 RxBuffer[BENCH_DOIP_BUFFER_SIZE];
+} Bench_DoIpTesterType;
+
+static Bench_DoIpTesterType Bench_DoIpTester[BENCH_DOIP_MAX_SESSIONS];
+static double Bench_DoIpLatency[BENCH_DOIP_REQUESTS];
+static atomic_bool Bench_DoIpStop;
+
+static void* Bench_DoIpEntity(void* Arg) {
+    (void)Arg;
+    while (atomic_load(&Bench_DoIpStop) == FALSE) {
+        DoIP_MainFunction();
+        Dcm_MainFunction();
+    }
+    return NULL;
+}
+
+static struct sockaddr_in Bench_DoIpAddress(void) {
+    struct sockaddr_in Addr;
+
+    (void)memset(&Addr, 0, sizeof(Addr));
+    Addr.sin_family = AF_INET;
+    Addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Addr.sin_port = htons(DOIP_PORT);
+    return Addr;
+}
+
+static uint32 Bench_DoIpMessage(uint8* Buffer, uint16 PayloadType, const uint8* Payload, uint32 PayloadLength) {
+    DoIP_WriteHeader(Buffer, PayloadType, PayloadLength);
+    (void)memcpy(&Buffer[DOIP_HEADER_LENGTH], Payload, PayloadLength);
+    return DOIP_HEADER_LENGTH + PayloadLength;
+}
+
+static int Bench_DoIpConnect(Bench_DoIpTesterType* Tester, uint16 TesterAddress) {
+    // Blocking connect and routing activation, then non-blocking for the request loop
+    struct sockaddr_in Addr = Bench_DoIpAddress();
+    uint8 Payload[7] = { (uint8)(TesterAddress >> 8), (uint8)TesterAddress, 0x00u, 0u, 0u, 0u, 0u };
+    uint8 Message[DOIP_HEADER_LENGTH + 9u];
+    uint32 Length = Bench_DoIpMessage(Message, DOIP_PT_ROUTING_ACTIVATION_REQUEST, Payload, sizeof(Payload));
+    uint32 Received = 0u;
+    int One = 1;
+
+    Tester->Socket = socket(AF_INET, SOCK_STREAM, 0);
+    Tester->TesterAddress = TesterAddress;
+    Tester->RxLength = 0u;
+    if (connect(Tester->Socket, (const struct sockaddr*)&Addr, sizeof(Addr)) != 0) {
+        return -1;
+    }
+    (void)setsockopt(Tester->Socket, IPPROTO_TCP, TCP_NODELAY, &One, sizeof(One));
+    if (send(Tester->Socket, Message, Length, 0) != (ssize_t)Length) {
+        return -1;
+    }
+    while (Received < sizeof(Message)) {
+        ssize_t n = recv(Tester->Socket, &Message[Received], sizeof(Message) - Received, 0);
+        if (n <= 0) {
+            return -1;
+        }
+        Received += (uint32)n;
+    }
+    if ((Message[3] != (uint8)DOIP_PT_ROUTING_ACTIVATION_RESPONSE) || (Message[DOIP_HEADER_LENGTH + 4u] != DOIP_RA_SUCCESS)) {
+        return -1;
+    }
+    (void)fcntl(Tester->Socket, F_SETFL, O_NONBLOCK);
+    return 0;
+}
+
+static void Bench_DoIpSendRequest(Bench_DoIpTesterType* Tester) {
+    // ReadDataByIdentifier 0xF190 (VIN), physically addressed
+    uint8 Payload[7] = { (uint8)(Tester->TesterAddress >> 8), (uint8)Tester->TesterAddress,
+                         (uint8)(DoIP_EntityConfig.LogicalAddress >> 8), (uint8)DoIP_EntityConfig.LogicalAddress, 0x22u, 0xF1u, 0x90u };
+    uint8 Message[DOIP_HEADER_LENGTH + 7u];
+    uint32 Length = Bench_DoIpMessage(Message, DOIP_PT_DIAG_MESSAGE, Payload, sizeof(Payload));
+
+    Tester->RequestStart = Bench_NowSeconds();
+    (void)send(Tester->Socket, Message, Length, MSG_NOSIGNAL);
+}
+
+static uint32 Bench_DoIpReceive(Bench_DoIpTesterType* Tester) {
+    // Number of complete UDS responses read (ACKs are skipped)
+    uint32 Responses = 0u;
+    uint32 Pos = 0u;
+    ssize_t n = recv(Tester->Socket, &Tester->RxBuffer[Tester->RxLength], BENCH_DOIP_BUFFER_SIZE - Tester->RxLength, 0);
+
+    if (n <= 0) {
+        return 0u;
+    }
+    Tester->RxLength += (uint32)n;
+    while ((Tester->RxLength - Pos) >= DOIP_HEADER_LENGTH) {
+        uint16 PayloadType;
+        uint32 PayloadLength;
+
+        (void)DoIP_ReadHeader(&Tester->RxBuffer[Pos], &PayloadType, &PayloadLength);
+        if ((Tester->RxLength - Pos) < (DOIP_HEADER_LENGTH + PayloadLength)) {
+            break;
+        }
+        if ((PayloadType == DOIP_PT_DIAG_MESSAGE) && (Tester->RxBuffer[Pos + DOIP_HEADER_LENGTH + 4u] == 0x62u)) {
+            Responses++;
+        }
+        Pos += DOIP_HEADER_LENGTH + PayloadLength;
+    }
+    (void)memmove(Tester->RxBuffer, &Tester->RxBuffer[Pos], Tester->RxLength - Pos);
+    Tester->RxLength -= Pos;
+    return Responses;
+}
+
+static int Bench_DoIpCompare(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+static void Bench_DoIpRun(uint16 Sessions) {
+    struct epoll_event Events[64];
+    uint32 Issued = 0u;
+    uint32 Completed = 0u;
+    double start, elapsed, sum = 0.0;
+    uint16 s;
+    int Epoll = epoll_create1(0);
+
+    for (s = 0u; s < Sessions; s++) {
+        struct epoll_event Event;
+
+        if (Bench_DoIpConnect(&Bench_DoIpTester[s], (uint16)(BENCH_DOIP_TESTER_ADDRESS + s)) != 0) {
+            printf("%4u sessions: routing activation failed\n", Sessions);
+            return;
+        }
+        Event.events = EPOLLIN;
+        Event.data.u32 = s;
+        (void)epoll_ctl(Epoll, EPOLL_CTL_ADD, Bench_DoIpTester[s].Socket, &Event);
+    }
+
+    start = Bench_NowSeconds();
+    for (s = 0u; (s < Sessions) && (Issued < BENCH_DOIP_REQUESTS); s++) {
+        Bench_DoIpSendRequest(&Bench_DoIpTester[s]);
+        Issued++;
+    }
+    while (Completed < BENCH_DOIP_REQUESTS) {
+        int Count = epoll_wait(Epoll, Events, 64, 1000);
+        int i;
+
+        if (Count <= 0) {
+            printf("%4u sessions: timeout after %u responses\n", Sessions, Completed);
+            break;
+        }
+        for (i = 0; i < Count; i++) {
+            Bench_DoIpTesterType* Tester = &Bench_DoIpTester[Events[i].data.u32];
+
+            if (Bench_DoIpReceive(Tester) > 0u) {
+                Bench_DoIpLatency[Completed] = Bench_NowSeconds() - Tester->RequestStart;
+                sum += Bench_DoIpLatency[Completed];
+                Completed++;
+                if (Issued < BENCH_DOIP_REQUESTS) {
+                    Bench_DoIpSendRequest(Tester);
+                    Issued++;
+                }
+            }
+        }
+    }
+    elapsed = Bench_NowSeconds() - start;
+
+    for (s = 0u; s < Sessions; s++) {
+        (void)close(Bench_DoIpTester[s].Socket);
+    }
+    (void)close(Epoll);
+    if (Completed > 0u) {
+        qsort(Bench_DoIpLatency, Completed, sizeof(double), Bench_DoIpCompare);
+        printf("%4u sessions: %8.0f req/s, latency mean %7.1f us, p50 %7.1f us, p99 %8.1f us\n", Sessions,
+               (double)Completed / elapsed, (sum / (double)Completed) * 1e6,
+               Bench_DoIpLatency[Completed / 2u] * 1e6, Bench_DoIpLatency[(Completed * 99u) / 100u] * 1e6);
+    }
+}
+
+static void Bench_DoIpIdentify(void) {
+    // Vehicle identification request over UDP, answered with the announcement payload
+    struct sockaddr_in Addr = Bench_DoIpAddress();
+    uint8 Message[DOIP_UDP_BUFFER_SIZE];
+    struct timeval Timeout = { 1, 0 };
+    int Socket = socket(AF_INET, SOCK_DGRAM, 0);
+    double start;
+    ssize_t n;
+
+    (void)setsockopt(Socket, SOL_SOCKET, SO_RCVTIMEO, &Timeout, sizeof(Timeout));
+    DoIP_WriteHeader(Message, DOIP_PT_VEHICLE_ID_REQUEST, 0u);
+    start = Bench_NowSeconds();
+    (void)sendto(Socket, Message, DOIP_HEADER_LENGTH, 0, (const struct sockaddr*)&Addr, sizeof(Addr));
+    n = recv(Socket, Message, sizeof(Message), 0);
+    if ((n == (ssize_t)(DOIP_HEADER_LENGTH + 33u)) && (Message[3] == (uint8)DOIP_PT_VEHICLE_ANNOUNCEMENT)) {
+        printf("vehicle identification: %.1f us, VIN %.17s\n", (Bench_NowSeconds() - start) * 1e6, (const char*)&Message[DOIP_HEADER_LENGTH]);
+    } else {
+        printf("vehicle identification: no response\n");
+    }
+    (void)close(Socket);
+}
+
+int main(void) {
+    // Request/response latency with one tester, then with many concurrent sessions
+    pthread_t Entity;
+
+    Dem_Init();
+    Dcm_Init();
+    if (DoIP_Init() != E_OK) {
+        printf("DoIP_Init failed (port %u in use?)\n", DOIP_PORT);
+        return 1;
+    }
+    atomic_init(&Bench_DoIpStop, FALSE);
+    (void)pthread_create(&Entity, NULL, &Bench_DoIpEntity, NULL);
+
+    Bench_DoIpIdentify();
+    Bench_DoIpRun(1u);
+    Bench_DoIpRun(16u);
+    Bench_DoIpRun(BENCH_DOIP_MAX_SESSIONS);
+
+    atomic_store(&Bench_DoIpStop, TRUE);
+    (void)pthread_join(Entity, NULL);
+    return 0;
+}
+
+/* =========================================================================
+ * RTE GENERATOR (HOST TOOL)
+ * ========================================================================= */
+
+/* RTE GENERATOR - COMMON DEFINITIONS */
+// File: RteGen.h
+/* Command-line generator for the "(Auto-generated)" RTE files of this ECU:
+ *   rtegen [-f] [-o <outdir>] <extract.arxml>...
+ * The ARXML is read by a streaming SAX parser: the input is scanned in large
+ * chunks and only the elements of the supported subset are kept, so memory
+ * follows the size of the model rather than the size of the extract.
+ * Supported subset:
+ * - SENDER-RECEIVER-INTERFACE / VARIABLE-DATA-PROTOTYPE (TYPE-TREF, SW-IMPL-POLICY QUEUED)
+ * - APPLICATION-, SENSOR-ACTUATOR- and COMPLEX-DEVICE-DRIVER-SW-COMPONENT-TYPE with
+ *   P-/R-PORT-PROTOTYPE (QUEUE-LENGTH of the receiver com spec) and RUNNABLE-ENTITY
+ *   (SYMBOL, DATA-READ-ACCESSS, DATA-WRITE-ACCESSS, DATA-SEND-POINTS,
+ *   DATA-RECEIVE-POINT-BY-ARGUMENTS) plus RTE events (START-ON-EVENT-REF)
+ * - ASSEMBLY-SW-CONNECTOR (one prototype per component type)
+ * - SENDER-RECEIVER-TO-SIGNAL-MAPPING, generated as ComConf_ComSignal_<SystemSignal>
+ * - ECUC RteEventToTaskMapping (RteEventRef, RteMappedToTaskRef, RtePositionInTask)
+ * Output: Rte_Cfg.h, Rte_Data.h, Rte_Data.c, Rte_<Swc>.c and Rte_Schedule.c,
+ * regenerated incrementally through <outdir>/.rtegen_cache (see RteGen_Cache.c). */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RTEGEN_MAX_DEPTH            64u
+#define RTEGEN_MAX_PATH             2048u
+#define RTEGEN_MAX_ECUC_DEPTH       16u
+#ifndef RTEGEN_READ_CHUNK
+#define RTEGEN_READ_CHUNK           (4u * 1024u * 1024u)
+#endif
+#define RTEGEN_NONE                 0xFFFFFFFFu
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Data;
+    uint32 Length;
+    uint32 Capacity;
+} RteGen_StringType;                // Growable text; output files are built in one of these
+
+typedef struct {
+    P2FUNC(void, RTEGEN_CODE, StartElement)(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, uint32 Length);
+    P2FUNC(void, RTEGEN_CODE, EndElement)(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx);
+    P2FUNC(void, RTEGEN_CODE, Text)(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Text, uint32 Length);
+    P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx;
+} RteGen_SaxHandlerType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Type;        // Last segment of TYPE-TREF, used as C type
+    boolean Queued;
+} RteGen_DataElementType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name;
+} RteGen_SwcType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name;
+    uint32 Swc;
+    boolean Provided;
+    uint16 QueueLength;
+} RteGen_PortType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Symbol;
+    uint32 Swc;
+    uint32 NumTasks;                // Tasks any of its events is mapped to
+} RteGen_RunnableType;
+
+typedef struct {
+    uint32 Runnable;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) PortRef;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) ElementRef;
+    boolean Write;
+} RteGen_AccessType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) RunnableRef;
+    uint32 Swc;
+} RteGen_EventType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;        // ECUC container
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) EventRef;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) TaskRef;
+    uint32 Position;
+} RteGen_TaskMappingType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) ProviderRef;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) RequesterRef;
+} RteGen_ConnectorType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) PortRef;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) ElementRef;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) SignalRef;
+} RteGen_SignalMappingType;
+
+#define RTEGEN_ARRAY(Type, Name) \
+    P2VAR(Type, AUTOMATIC, RTEGEN_VAR) Name; uint32 Num##Name; uint32 Max##Name
+
+typedef struct {
+    RTEGEN_ARRAY(RteGen_DataElementType, Element);
+    RTEGEN_ARRAY(RteGen_SwcType, Swc);
+    RTEGEN_ARRAY(RteGen_PortType, Port);
+    RTEGEN_ARRAY(RteGen_RunnableType, Runnable);
+    RTEGEN_ARRAY(RteGen_AccessType, Access);
+    RTEGEN_ARRAY(RteGen_EventType, Event);
+    RTEGEN_ARRAY(RteGen_TaskMappingType, TaskMapping);
+    RTEGEN_ARRAY(RteGen_ConnectorType, Connector);
+    RTEGEN_ARRAY(RteGen_SignalMappingType, SignalMapping);
+} RteGen_ModelType;
+
+// Append one zeroed element to a model array and return its index
+#define RTEGEN_NEW(Model, Name) \
+    RteGen_Grow((void**)&(Model)->Name, &(Model)->Num##Name, &(Model)->Max##Name, sizeof((Model)->Name[0]))
+
+typedef struct {
+    uint32 Capacity;                // Power of two
+    uint32 Count;
+    P2VAR(P2CONST(char, AUTOMATIC, RTEGEN_VAR), AUTOMATIC, RTEGEN_VAR) Keys;
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) Values;
+} RteGen_MapType;                   // Open-addressing string -> index map
+
+/* RTE GENERATOR - UTILITIES */
+// File: RteGen_Util.c
+#include "RteGen.h"
+
+FUNC(uint32, RTEGEN_CODE) RteGen_Grow(P2VAR(void*, AUTOMATIC, RTEGEN_VAR) Items, P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) Count,
+                                      P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) Capacity, uint32 Size) {
+    if (*Count == *Capacity) {
+        *Capacity = (*Capacity == 0u) ? 64u : (*Capacity * 2u);
+        *Items = realloc(*Items, (size_t)*Capacity * Size);
+        if (*Items == NULL_PTR) {
+            fprintf(stderr, "rtegen: out of memory\n");
+            exit(2);
+        }
+    }
+    (void)memset((uint8*)*Items + ((size_t)*Count * Size), 0, Size);
+    return (*Count)++;
+}
+
+FUNC_P2VAR(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_StrDup(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Text, uint32 Length) {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Copy = malloc((size_t)Length + 1u);
+
+    if (Copy == NULL_PTR) {
+        fprintf(stderr, "rtegen: out of memory\n");
+        exit(2);
+    }
+    (void)memcpy(Copy, Text, Length);
+    Copy[Length] = '\0';
+    return Copy;
+}
+
+FUNC_P2CONST(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_LastSegment(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Ref) {
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Slash = strrchr(Ref, '/');
+
+    return (Slash != NULL_PTR) ? (Slash + 1) : Ref;
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_Append(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) String,
+                                      P2CONST(char, AUTOMATIC, RTEGEN_VAR) Text, uint32 Length) {
+    if ((String->Length + Length + 1u) > String->Capacity) {
+        while ((String->Length + Length + 1u) > String->Capacity) {
+            String->Capacity = (String->Capacity == 0u) ? 4096u : (String->Capacity * 2u);
+        }
+        String->Data = realloc(String->Data, String->Capacity);
+        if (String->Data == NULL_PTR) {
+            fprintf(stderr, "rtegen: out of memory\n");
+            exit(2);
+        }
+    }
+    (void)memcpy(&String->Data[String->Length], Text, Length);
+    String->Length += Length;
+    String->Data[String->Length] = '\0';
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_Printf(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) String,
+                                      P2CONST(char, AUTOMATIC, RTEGEN_VAR) Format, ...) {
+    char Line[1024];
+    va_list Args;
+    sint32 Length;
+
+    va_start(Args, Format);
+    Length = vsnprintf(Line, sizeof(Line), Format, Args);
+    va_end(Args);
+    if (Length >= (sint32)sizeof(Line)) {
+        // Long line (deep paths): format again into a heap buffer
+        P2VAR(char, AUTOMATIC, RTEGEN_VAR) Long = malloc((size_t)Length + 1u);
+
+        va_start(Args, Format);
+        (void)vsnprintf(Long, (size_t)Length + 1u, Format, Args);
+        va_end(Args);
+        RteGen_Append(String, Long, (uint32)Length);
+        free(Long);
+    } else if (Length > 0) {
+        RteGen_Append(String, Line, (uint32)Length);
+    } else {
+        // Nothing to append
+    }
+}
+
+FUNC(uint32, RTEGEN_CODE) RteGen_Hash(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Data, uint32 Length) {
+    // FNV-1a
+    uint32 Hash = 2166136261u;
+    uint32 i;
+
+    for (i = 0u; i < Length; i++) {
+        Hash = (Hash ^ (uint8)Data[i]) * 16777619u;
+    }
+    return Hash;
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_MapPut(P2VAR(RteGen_MapType, AUTOMATIC, RTEGEN_VAR) Map, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Key, uint32 Value) {
+    uint32 Slot;
+
+    if (((Map->Count + 1u) * 2u) > Map->Capacity) {
+        // Keep the load factor below 1/2
+        RteGen_MapType Bigger;
+        uint32 i;
+
+        Bigger.Capacity = (Map->Capacity == 0u) ? 256u : (Map->Capacity * 2u);
+        Bigger.Count = 0u;
+        Bigger.Keys = calloc(Bigger.Capacity, sizeof(Bigger.Keys[0]));
+        Bigger.Values = calloc(Bigger.Capacity, sizeof(Bigger.Values[0]));
+        if ((Bigger.Keys == NULL_PTR) || (Bigger.Values == NULL_PTR)) {
+            fprintf(stderr, "rtegen: out of memory\n");
+            exit(2);
+        }
+        for (i = 0u; i < Map->Capacity; i++) {
+            if (Map->Keys[i] != NULL_PTR) {
+                RteGen_MapPut(&Bigger, Map->Keys[i], Map->Values[i]);
+            }
+        }
+        free(Map->Keys);
+        free(Map->Values);
+        *Map = Bigger;
+    }
+
+    Slot = RteGen_Hash(Key, (uint32)strlen(Key)) & (Map->Capacity - 1u);
+    while (Map->Keys[Slot] != NULL_PTR) {
+        if (strcmp(Map->Keys[Slot], Key) == 0) {
+            Map->Values[Slot] = Value;      // Later definition wins
+            return;
+        }
+        Slot = (Slot + 1u) & (Map->Capacity - 1u);
+    }
+    Map->Keys[Slot] = Key;
+    Map->Values[Slot] = Value;
+    Map->Count++;
+}
+
+FUNC(uint32, RTEGEN_CODE) RteGen_MapGet(P2CONST(RteGen_MapType, AUTOMATIC, RTEGEN_VAR) Map, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Key) {
+    uint32 Slot;
+
+    if ((Map->Capacity == 0u) || (Key == NULL_PTR)) {
+        return RTEGEN_NONE;
+    }
+    Slot = RteGen_Hash(Key, (uint32)strlen(Key)) & (Map->Capacity - 1u);
+    while (Map->Keys[Slot] != NULL_PTR) {
+        if (strcmp(Map->Keys[Slot], Key) == 0) {
+            return Map->Values[Slot];
+        }
+        Slot = (Slot + 1u) & (Map->Capacity - 1u);
+    }
+    return RTEGEN_NONE;
+}
+
+/* RTE GENERATOR - STREAMING XML PARSER */
+// File: RteGen_Sax.c
+/* Minimal non-validating SAX tokenizer. The file is read in RTEGEN_READ_CHUNK
+ * blocks; text is located with memchr and handed out without copying, and a
+ * markup token that straddles a block boundary is moved to the front of the
+ * buffer before the next read. Element names lose their namespace prefix.
+ * Comments, processing instructions and DOCTYPE are skipped, CDATA is
+ * reported as text, attributes are ignored (the subset needs none). */
+#include "RteGen.h"
+
+static FUNC_P2CONST(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_SaxFind(P2CONST(char, AUTOMATIC, RTEGEN_VAR) From, P2CONST(char, AUTOMATIC, RTEGEN_VAR) End,
+                                                                  P2CONST(char, AUTOMATIC, RTEGEN_VAR) Token, uint32 TokenLength) {
+    while (From < End) {
+        P2CONST(char, AUTOMATIC, RTEGEN_VAR) Hit = memchr(From, Token[0], (size_t)(End - From));
+
+        if ((Hit == NULL_PTR) || ((uint32)(End - Hit) < TokenLength)) {
+            return NULL_PTR;
+        }
+        if (memcmp(Hit, Token, TokenLength) == 0) {
+            return Hit;
+        }
+        From = Hit + 1;
+    }
+    return NULL_PTR;
+}
+
+static FUNC_P2CONST(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_SaxTagEnd(P2CONST(char, AUTOMATIC, RTEGEN_VAR) From, P2CONST(char, AUTOMATIC, RTEGEN_VAR) End) {
+    // '>' closing a start tag, skipping quoted attribute values
+    char Quote = '\0';
+
+    for (; From < End; From++) {
+        if (Quote != '\0') {
+            if (*From == Quote) {
+                Quote = '\0';
+            }
+        } else if ((*From == '"') || (*From == '\'')) {
+            Quote = *From;
+        } else if (*From == '>') {
+            return From;
+        } else {
+            // Part of the name or an attribute
+        }
+    }
+    return NULL_PTR;
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_SaxStart(P2CONST(RteGen_SaxHandlerType, AUTOMATIC, RTEGEN_VAR) Handler,
+                                               P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, P2CONST(char, AUTOMATIC, RTEGEN_VAR) End) {
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) NameEnd = Name;
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Colon = NULL_PTR;
+
+    while ((NameEnd < End) && (*NameEnd != ' ') && (*NameEnd != '\t') && (*NameEnd != '\r') && (*NameEnd != '\n') &&
+           (*NameEnd != '/') && (*NameEnd != '>')) {
+        if (*NameEnd == ':') {
+            Colon = NameEnd;
+        }
+        NameEnd++;
+    }
+    if (Colon != NULL_PTR) {
+        Name = Colon + 1;
+    }
+    Handler->StartElement(Handler->Ctx, Name, (uint32)(NameEnd - Name));
+}
+
+FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_SaxParseFile(P2CONST(char, AUTOMATIC, RTEGEN_VAR) FileName,
+                                                      P2CONST(RteGen_SaxHandlerType, AUTOMATIC, RTEGEN_VAR) Handler,
+                                                      P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) BytesRead) {
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File = fopen(FileName, "rb");
+    uint32 Capacity = RTEGEN_READ_CHUNK;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Buffer = malloc(Capacity);
+    uint32 Used = 0u;
+    boolean Eof = FALSE;
+    Std_ReturnType Result = E_OK;
+
+    if ((File == NULL_PTR) || (Buffer == NULL_PTR)) {
+        fprintf(stderr, "rtegen: cannot read %s\n", FileName);
+        if (File != NULL_PTR) {
+            (void)fclose(File);
+        }
+        free(Buffer);
+        return E_NOT_OK;
+    }
+
+    while ((Eof == FALSE) || (Used > 0u)) {
+        P2CONST(char, AUTOMATIC, RTEGEN_VAR) Pos;
+        P2CONST(char, AUTOMATIC, RTEGEN_VAR) End;
+        boolean NeedMore = FALSE;
+
+        if ((Eof == FALSE) && (Used < Capacity)) {
+            size_t Got = fread(&Buffer[Used], 1u, Capacity - Used, File);
+
+            Used += (uint32)Got;
+            *BytesRead += Got;
+            if (Got == 0u) {
+                Eof = TRUE;
+            }
+        }
+        Pos = Buffer;
+        End = &Buffer[Used];
+
+        while ((Pos < End) && (NeedMore == FALSE)) {
+            P2CONST(char, AUTOMATIC, RTEGEN_VAR) Lt = memchr(Pos, '<', (size_t)(End - Pos));
+            P2CONST(char, AUTOMATIC, RTEGEN_VAR) Close;
+
+            if (Lt == NULL_PTR) {
+                Handler->Text(Handler->Ctx, Pos, (uint32)(End - Pos));
+                Pos = End;
+                break;
+            }
+            if (Lt > Pos) {
+                Handler->Text(Handler->Ctx, Pos, (uint32)(Lt - Pos));
+                Pos = Lt;
+            }
+            if (((End - Lt) < 9) && (Eof == FALSE)) {
+                // Too short to classify the markup yet
+                NeedMore = TRUE;
+                continue;
+            }
+
+            if (((End - Lt) >= 4) && (memcmp(Lt, "<!--", 4u) == 0)) {
+                Close = RteGen_SaxFind(Lt + 4, End, "-->", 3u);
+                if (Close != NULL_PTR) {
+                    Pos = Close + 3;
+                }
+            } else if (((End - Lt) >= 9) && (memcmp(Lt, "<![CDATA[", 9u) == 0)) {
+                Close = RteGen_SaxFind(Lt + 9, End, "]]>", 3u);
+                if (Close != NULL_PTR) {
+                    Handler->Text(Handler->Ctx, Lt + 9, (uint32)(Close - (Lt + 9)));
+                    Pos = Close + 3;
+                }
+            } else if ((End - Lt) < 2) {
+                Close = NULL_PTR;
+            } else if ((Lt[1] == '?') || (Lt[1] == '!')) {
+                Close = memchr(Lt, '>', (size_t)(End - Lt));
+                if (Close != NULL_PTR) {
+                    Pos = Close + 1;
+                }
+            } else if (Lt[1] == '/') {
+                Close = memchr(Lt, '>', (size_t)(End - Lt));
+                if (Close != NULL_PTR) {
+                    Handler->EndElement(Handler->Ctx);
+                    Pos = Close + 1;
+                }
+            } else {
+                Close = RteGen_SaxTagEnd(Lt + 1, End);
+                if (Close != NULL_PTR) {
+                    RteGen_SaxStart(Handler, Lt + 1, Close);
+                    if (Close[-1] == '/') {
+                        Handler->EndElement(Handler->Ctx);
+                    }
+                    Pos = Close + 1;
+                }
+            }
+
+            if (Close == NULL_PTR) {
+                // Token continues in the next block
+                NeedMore = TRUE;
+                if (Eof == TRUE) {
+                    fprintf(stderr, "rtegen: %s: unterminated markup at end of file\n", FileName);
+                    Result = E_NOT_OK;
+                    Pos = End;
+                    NeedMore = FALSE;
+                }
+            }
+        }
+
+        // Keep the unconsumed tail; grow the buffer if one token fills all of it
+        Used = (uint32)(End - Pos);
+        (void)memmove(Buffer, Pos, Used);
+        if ((NeedMore == TRUE) && (Used == Capacity)) {
+            Capacity *= 2u;
+            Buffer = realloc(Buffer, Capacity);
+            if (Buffer == NULL_PTR) {
+                fprintf(stderr, "rtegen: out of memory\n");
+                exit(2);
+            }
+        }
+        if ((Eof == TRUE) && (NeedMore == FALSE)) {
+            Used = 0u;
+        }
+    }
+
+    (void)fclose(File);
+    free(Buffer);
+    return Result;
+}
+
+/* RTE GENERATOR - ARXML SUBSET MODEL */
+// File: RteGen_Arxml.c
+/* SAX callbacks that build the model. The parser keeps a stack of open
+ * elements and the AUTOSAR path (joined SHORT-NAMEs) of the innermost
+ * identifiable; text is only collected for the leaf elements it uses. */
+#include "RteGen.h"
+
+typedef enum {
+    RTEGEN_TAG_OTHER = 0,
+    RTEGEN_TAG_SHORT_NAME,
+    RTEGEN_TAG_SENDER_RECEIVER_INTERFACE,
+    RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE,
+    RTEGEN_TAG_TYPE_TREF,
+    RTEGEN_TAG_SW_IMPL_POLICY,
+    RTEGEN_TAG_SW_COMPONENT_TYPE,
+    RTEGEN_TAG_P_PORT_PROTOTYPE,
+    RTEGEN_TAG_R_PORT_PROTOTYPE,
+    RTEGEN_TAG_QUEUE_LENGTH,
+    RTEGEN_TAG_RUNNABLE_ENTITY,
+    RTEGEN_TAG_SYMBOL,
+    RTEGEN_TAG_READ_ACCESSES,
+    RTEGEN_TAG_WRITE_ACCESSES,
+    RTEGEN_TAG_VARIABLE_ACCESS,
+    RTEGEN_TAG_PORT_PROTOTYPE_REF,
+    RTEGEN_TAG_TARGET_DATA_PROTOTYPE_REF,
+    RTEGEN_TAG_START_ON_EVENT_REF,
+    RTEGEN_TAG_ECUC_CONTAINER_VALUE,
+    RTEGEN_TAG_ECUC_REFERENCE_VALUE,
+    RTEGEN_TAG_ECUC_NUMERICAL_PARAM_VALUE,
+    RTEGEN_TAG_DEFINITION_REF,
+    RTEGEN_TAG_VALUE_REF,
+    RTEGEN_TAG_VALUE,
+    RTEGEN_TAG_ASSEMBLY_SW_CONNECTOR,
+    RTEGEN_TAG_TARGET_P_PORT_REF,
+    RTEGEN_TAG_TARGET_R_PORT_REF,
+    RTEGEN_TAG_SIGNAL_MAPPING,
+    RTEGEN_TAG_CONTEXT_PORT_REF,
+    RTEGEN_TAG_SYSTEM_SIGNAL_REF,
+    RTEGEN_NUM_OF_TAGS
+} RteGen_TagType;
+
+typedef struct {
+    P2CONST(char, AUTOMATIC, RTEGEN_CONST) Name;
+    RteGen_TagType Tag;
+    boolean Leaf;                   // Text content is used
+} RteGen_TagInfoType;
+
+static CONST(RteGen_TagInfoType, RTEGEN_CONST) RteGen_TagInfo[] = {
+    { "SHORT-NAME",                             RTEGEN_TAG_SHORT_NAME,                  TRUE  },
+    { "SENDER-RECEIVER-INTERFACE",              RTEGEN_TAG_SENDER_RECEIVER_INTERFACE,   FALSE },
+    { "VARIABLE-DATA-PROTOTYPE",                RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE,     FALSE },
+    { "TYPE-TREF",                              RTEGEN_TAG_TYPE_TREF,                   TRUE  },
+    { "SW-IMPL-POLICY",                         RTEGEN_TAG_SW_IMPL_POLICY,              TRUE  },
+    { "APPLICATION-SW-COMPONENT-TYPE",          RTEGEN_TAG_SW_COMPONENT_TYPE,           FALSE },
+    { "SENSOR-ACTUATOR-SW-COMPONENT-TYPE",      RTEGEN_TAG_SW_COMPONENT_TYPE,           FALSE },
+    { "COMPLEX-DEVICE-DRIVER-SW-COMPONENT-TYPE", RTEGEN_TAG_SW_COMPONENT_TYPE,          FALSE },
+    { "P-PORT-PROTOTYPE",                       RTEGEN_TAG_P_PORT_PROTOTYPE,            FALSE },
+    { "R-PORT-PROTOTYPE",                       RTEGEN_TAG_R_PORT_PROTOTYPE,            FALSE },
+    { "QUEUE-LENGTH",                           RTEGEN_TAG_QUEUE_LENGTH,                TRUE  },
+    { "RUNNABLE-ENTITY",                        RTEGEN_TAG_RUNNABLE_ENTITY,             FALSE },
+    { "SYMBOL",                                 RTEGEN_TAG_SYMBOL,                      TRUE  },
+    { "DATA-READ-ACCESSS",                      RTEGEN_TAG_READ_ACCESSES,               FALSE },
+    { "DATA-RECEIVE-POINT-BY-ARGUMENTS",        RTEGEN_TAG_READ_ACCESSES,               FALSE },
+    { "DATA-WRITE-ACCESSS",                     RTEGEN_TAG_WRITE_ACCESSES,              FALSE },
+    { "DATA-SEND-POINTS",                       RTEGEN_TAG_WRITE_ACCESSES,              FALSE },
+    { "VARIABLE-ACCESS",                        RTEGEN_TAG_VARIABLE_ACCESS,             FALSE },
+    { "PORT-PROTOTYPE-REF",                     RTEGEN_TAG_PORT_PROTOTYPE_REF,          TRUE  },
+    { "TARGET-DATA-PROTOTYPE-REF",              RTEGEN_TAG_TARGET_DATA_PROTOTYPE_REF,   TRUE  },
+    { "START-ON-EVENT-REF",                     RTEGEN_TAG_START_ON_EVENT_REF,          TRUE  },
+    { "ECUC-CONTAINER-VALUE",                   RTEGEN_TAG_ECUC_CONTAINER_VALUE,        FALSE },
+    { "ECUC-REFERENCE-VALUE",                   RTEGEN_TAG_ECUC_REFERENCE_VALUE,        FALSE },
+    { "ECUC-NUMERICAL-PARAM-VALUE",             RTEGEN_TAG_ECUC_NUMERICAL_PARAM_VALUE,  FALSE },
+    { "DEFINITION-REF",                         RTEGEN_TAG_DEFINITION_REF,              TRUE  },
+    { "VALUE-REF",                              RTEGEN_TAG_VALUE_REF,                   TRUE  },
+    { "VALUE",                                  RTEGEN_TAG_VALUE,                       TRUE  },
+    { "ASSEMBLY-SW-CONNECTOR",                  RTEGEN_TAG_ASSEMBLY_SW_CONNECTOR,       FALSE },
+    { "TARGET-P-PORT-REF",                      RTEGEN_TAG_TARGET_P_PORT_REF,           TRUE  },
+    { "TARGET-R-PORT-REF",                      RTEGEN_TAG_TARGET_R_PORT_REF,           TRUE  },
+    { "SENDER-RECEIVER-TO-SIGNAL-MAPPING",      RTEGEN_TAG_SIGNAL_MAPPING,              FALSE },
+    { "CONTEXT-PORT-REF",                       RTEGEN_TAG_CONTEXT_PORT_REF,            TRUE  },
+    { "SYSTEM-SIGNAL-REF",                      RTEGEN_TAG_SYSTEM_SIGNAL_REF,           TRUE  },
+};
+
+#define RTEGEN_NUM_OF_TAG_INFOS     (sizeof(RteGen_TagInfo) / sizeof(RteGen_TagInfo[0]))
+#define RTEGEN_TAG_TABLE_SIZE       256u    // Power of two, > 2 * RTEGEN_NUM_OF_TAG_INFOS
+
+typedef struct {
+    uint8 Tag;
+    uint16 PathLength;              // Length of Path up to and including this element's SHORT-NAME
+} RteGen_FrameType;
+
+typedef struct {
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model;
+    RteGen_FrameType Stack[RTEGEN_MAX_DEPTH + 1u];
+    uint32 Depth;
+    uint32 Overflow;                // Elements nested deeper than RTEGEN_MAX_DEPTH (ignored)
+    char Path[RTEGEN_MAX_PATH];
+    RteGen_StringType Text;
+    boolean Collect;
+    // Records being filled (RTEGEN_NONE when not inside one)
+    uint32 Swc;
+    uint32 Element;
+    uint32 Port;
+    uint32 Runnable;
+    uint32 Access;
+    uint32 Connector;
+    uint32 SignalMapping;
+    boolean AccessWrite;
+    uint32 EcucDepth;
+    uint32 EcucMapping[RTEGEN_MAX_ECUC_DEPTH];
+    char ParamDef[64];              // Last segment of the DEFINITION-REF of the current parameter
+} RteGen_ParserType;
+
+static VAR(uint8, RTEGEN_VAR) RteGen_TagTable[RTEGEN_TAG_TABLE_SIZE];  // Hash -> RteGen_TagInfo index + 1
+
+static FUNC(void, RTEGEN_CODE) RteGen_InitTagTable(void) {
+    uint32 i;
+
+    (void)memset(RteGen_TagTable, 0, sizeof(RteGen_TagTable));
+    for (i = 0u; i < RTEGEN_NUM_OF_TAG_INFOS; i++) {
+        uint32 Slot = RteGen_Hash(RteGen_TagInfo[i].Name, (uint32)strlen(RteGen_TagInfo[i].Name)) & (RTEGEN_TAG_TABLE_SIZE - 1u);
+
+        while (RteGen_TagTable[Slot] != 0u) {
+            Slot = (Slot + 1u) & (RTEGEN_TAG_TABLE_SIZE - 1u);
+        }
+        RteGen_TagTable[Slot] = (uint8)(i + 1u);
+    }
+}
+
+static FUNC_P2CONST(RteGen_TagInfoType, RTEGEN_CONST, RTEGEN_CODE) RteGen_LookupTag(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, uint32 Length) {
+    uint32 Slot = RteGen_Hash(Name, Length) & (RTEGEN_TAG_TABLE_SIZE - 1u);
+
+    while (RteGen_TagTable[Slot] != 0u) {
+        P2CONST(RteGen_TagInfoType, AUTOMATIC, RTEGEN_CONST) Info = &RteGen_TagInfo[RteGen_TagTable[Slot] - 1u];
+
+        if ((strlen(Info->Name) == Length) && (memcmp(Info->Name, Name, Length) == 0)) {
+            return Info;
+        }
+        Slot = (Slot + 1u) & (RTEGEN_TAG_TABLE_SIZE - 1u);
+    }
+    return NULL_PTR;
+}
+
+static FUNC(uint8, RTEGEN_CODE) RteGen_ParentTag(P2CONST(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser) {
+    return (Parser->Depth >= 2u) ? Parser->Stack[Parser->Depth - 2u].Tag : (uint8)RTEGEN_TAG_OTHER;
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_Inside(P2CONST(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser, uint8 Tag) {
+    uint32 i;
+
+    for (i = 0u; i < Parser->Depth; i++) {
+        if (Parser->Stack[i].Tag == Tag) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_OnStart(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, uint32 Length) {
+    P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser = Ctx;
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Parser->Model;
+    P2CONST(RteGen_TagInfoType, AUTOMATIC, RTEGEN_CONST) Info = RteGen_LookupTag(Name, Length);
+    P2VAR(RteGen_FrameType, AUTOMATIC, RTEGEN_VAR) Frame;
+    uint8 Tag = (Info != NULL_PTR) ? (uint8)Info->Tag : (uint8)RTEGEN_TAG_OTHER;
+
+    if (Parser->Depth >= RTEGEN_MAX_DEPTH) {
+        Parser->Overflow++;
+        return;
+    }
+    Frame = &Parser->Stack[Parser->Depth];
+    Frame->Tag = Tag;
+    Frame->PathLength = (Parser->Depth > 0u) ? Parser->Stack[Parser->Depth - 1u].PathLength : 0u;
+    Parser->Depth++;
+    Parser->Collect = ((Info != NULL_PTR) && (Info->Leaf == TRUE)) ? TRUE : FALSE;
+    Parser->Text.Length = 0u;
+
+    switch (Tag) {
+    case RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE:
+        if (RteGen_Inside(Parser, RTEGEN_TAG_SENDER_RECEIVER_INTERFACE) == TRUE) {
+            Parser->Element = RTEGEN_NEW(Model, Element);
+        }
+        break;
+    case RTEGEN_TAG_SW_COMPONENT_TYPE:
+        Parser->Swc = RTEGEN_NEW(Model, Swc);
+        break;
+    case RTEGEN_TAG_P_PORT_PROTOTYPE:
+    case RTEGEN_TAG_R_PORT_PROTOTYPE:
+        if (Parser->Swc != RTEGEN_NONE) {
+            Parser->Port = RTEGEN_NEW(Model, Port);
+            Model->Port[Parser->Port].Swc = Parser->Swc;
+            Model->Port[Parser->Port].Provided = (Tag == RTEGEN_TAG_P_PORT_PROTOTYPE) ? TRUE : FALSE;
+            Model->Port[Parser->Port].QueueLength = 1u;
+        }
+        break;
+    case RTEGEN_TAG_RUNNABLE_ENTITY:
+        if (Parser->Swc != RTEGEN_NONE) {
+            Parser->Runnable = RTEGEN_NEW(Model, Runnable);
+            Model->Runnable[Parser->Runnable].Swc = Parser->Swc;
+        }
+        break;
+    case RTEGEN_TAG_READ_ACCESSES:
+        Parser->AccessWrite = FALSE;
+        break;
+    case RTEGEN_TAG_WRITE_ACCESSES:
+        Parser->AccessWrite = TRUE;
+        break;
+    case RTEGEN_TAG_VARIABLE_ACCESS:
+        if ((Parser->Runnable != RTEGEN_NONE) &&
+            ((RteGen_Inside(Parser, RTEGEN_TAG_READ_ACCESSES) == TRUE) || (RteGen_Inside(Parser, RTEGEN_TAG_WRITE_ACCESSES) == TRUE))) {
+            Parser->Access = RTEGEN_NEW(Model, Access);
+            Model->Access[Parser->Access].Runnable = Parser->Runnable;
+            Model->Access[Parser->Access].Write = Parser->AccessWrite;
+        }
+        break;
+    case RTEGEN_TAG_ECUC_CONTAINER_VALUE:
+        if (Parser->EcucDepth < RTEGEN_MAX_ECUC_DEPTH) {
+            Parser->EcucMapping[Parser->EcucDepth] = RTEGEN_NONE;
+        }
+        Parser->EcucDepth++;
+        break;
+    case RTEGEN_TAG_ECUC_REFERENCE_VALUE:
+    case RTEGEN_TAG_ECUC_NUMERICAL_PARAM_VALUE:
+        Parser->ParamDef[0] = '\0';
+        break;
+    case RTEGEN_TAG_ASSEMBLY_SW_CONNECTOR:
+        Parser->Connector = RTEGEN_NEW(Model, Connector);
+        break;
+    case RTEGEN_TAG_SIGNAL_MAPPING:
+        Parser->SignalMapping = RTEGEN_NEW(Model, SignalMapping);
+        break;
+    default:
+        break;
+    }
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_OnText(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Text, uint32 Length) {
+    P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser = Ctx;
+
+    if (Parser->Collect == TRUE) {
+        RteGen_Append(&Parser->Text, Text, Length);
+    }
+}
+
+static FUNC_P2VAR(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_TakeText(P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser) {
+    // Trimmed, entity-decoded copy of the collected text
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Text;
+    uint32 Start = 0u;
+    uint32 End = Parser->Text.Length;
+    uint32 In;
+    uint32 Out = 0u;
+
+    while ((Start < End) && ((uint8)Parser->Text.Data[Start] <= (uint8)' ')) {
+        Start++;
+    }
+    while ((End > Start) && ((uint8)Parser->Text.Data[End - 1u] <= (uint8)' ')) {
+        End--;
+    }
+    Text = RteGen_StrDup((End > Start) ? &Parser->Text.Data[Start] : "", End - Start);
+    for (In = 0u; Text[In] != '\0'; In++) {
+        if (Text[In] == '&') {
+            if (strncmp(&Text[In], "&lt;", 4u) == 0) {
+                Text[Out++] = '<';
+                In += 3u;
+            } else if (strncmp(&Text[In], "&gt;", 4u) == 0) {
+                Text[Out++] = '>';
+                In += 3u;
+            } else if (strncmp(&Text[In], "&amp;", 5u) == 0) {
+                Text[Out++] = '&';
+                In += 4u;
+            } else if (strncmp(&Text[In], "&quot;", 6u) == 0) {
+                Text[Out++] = '"';
+                In += 5u;
+            } else if (strncmp(&Text[In], "&apos;", 6u) == 0) {
+                Text[Out++] = '\'';
+                In += 5u;
+            } else {
+                Text[Out++] = '&';
+            }
+        } else {
+            Text[Out++] = Text[In];
+        }
+    }
+    Text[Out] = '\0';
+    return Text;
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_OnShortName(P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser, P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name) {
+    // Extend the path of the enclosing identifiable and name the record it opened
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Parser->Model;
+    P2VAR(RteGen_FrameType, AUTOMATIC, RTEGEN_VAR) Owner = &Parser->Stack[Parser->Depth - 2u];
+    uint32 Base = Owner->PathLength;
+    uint32 Length = (uint32)strlen(Name);
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Path;
+
+    if ((Base + 1u + Length) >= RTEGEN_MAX_PATH) {
+        free(Name);
+        return;
+    }
+    Parser->Path[Base] = '/';
+    (void)memcpy(&Parser->Path[Base + 1u], Name, Length);
+    Owner->PathLength = (uint16)(Base + 1u + Length);
+    Path = RteGen_StrDup(Parser->Path, Owner->PathLength);
+
+    switch (Owner->Tag) {
+    case RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE:
+        if (Parser->Element != RTEGEN_NONE) {
+            Model->Element[Parser->Element].Path = Path;
+            Model->Element[Parser->Element].Name = Name;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_SW_COMPONENT_TYPE:
+        Model->Swc[Parser->Swc].Path = Path;
+        Model->Swc[Parser->Swc].Name = Name;
+        return;
+    case RTEGEN_TAG_P_PORT_PROTOTYPE:
+    case RTEGEN_TAG_R_PORT_PROTOTYPE:
+        if (Parser->Port != RTEGEN_NONE) {
+            Model->Port[Parser->Port].Path = Path;
+            Model->Port[Parser->Port].Name = Name;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_RUNNABLE_ENTITY:
+        if (Parser->Runnable != RTEGEN_NONE) {
+            Model->Runnable[Parser->Runnable].Path = Path;
+            Model->Runnable[Parser->Runnable].Name = Name;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_ASSEMBLY_SW_CONNECTOR:
+        if (Parser->Connector != RTEGEN_NONE) {
+            Model->Connector[Parser->Connector].Path = Path;
+            free(Name);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    free(Path);
+    free(Name);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_OnLeaf(P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser, uint8 Tag) {
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Parser->Model;
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Text = RteGen_TakeText(Parser);
+    uint8 Parent = RteGen_ParentTag(Parser);
+    uint32 Mapping = ((Parser->EcucDepth > 0u) && (Parser->EcucDepth <= RTEGEN_MAX_ECUC_DEPTH))
+                     ? Parser->EcucMapping[Parser->EcucDepth - 1u] : RTEGEN_NONE;
+
+    switch (Tag) {
+    case RTEGEN_TAG_SHORT_NAME:
+        RteGen_OnShortName(Parser, Text);
+        return;
+    case RTEGEN_TAG_TYPE_TREF:
+        if ((Parser->Element != RTEGEN_NONE) && (Parent == RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE)) {
+            Model->Element[Parser->Element].Type = RteGen_StrDup(RteGen_LastSegment(Text), (uint32)strlen(RteGen_LastSegment(Text)));
+        }
+        break;
+    case RTEGEN_TAG_SW_IMPL_POLICY:
+        if (Parser->Element != RTEGEN_NONE) {
+            Model->Element[Parser->Element].Queued = (strcmp(Text, "QUEUED") == 0) ? TRUE : FALSE;
+        }
+        break;
+    case RTEGEN_TAG_QUEUE_LENGTH:
+        if (Parser->Port != RTEGEN_NONE) {
+            Model->Port[Parser->Port].QueueLength = (uint16)strtoul(Text, NULL_PTR, 0);
+        }
+        break;
+    case RTEGEN_TAG_SYMBOL:
+        if ((Parser->Runnable != RTEGEN_NONE) && (Parent == RTEGEN_TAG_RUNNABLE_ENTITY)) {
+            Model->Runnable[Parser->Runnable].Symbol = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_PORT_PROTOTYPE_REF:
+        if (Parser->Access != RTEGEN_NONE) {
+            Model->Access[Parser->Access].PortRef = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_TARGET_DATA_PROTOTYPE_REF:
+        if (Parser->Access != RTEGEN_NONE) {
+            Model->Access[Parser->Access].ElementRef = Text;
+            return;
+        }
+        if (Parser->SignalMapping != RTEGEN_NONE) {
+            Model->SignalMapping[Parser->SignalMapping].ElementRef = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_START_ON_EVENT_REF: {
+        // The parent element is the RTE event; its path is the one ECUC mappings refer to
+        uint32 Event = RTEGEN_NEW(Model, Event);
+
+        Model->Event[Event].Path = RteGen_StrDup(Parser->Path, Parser->Stack[Parser->Depth - 2u].PathLength);
+        Model->Event[Event].RunnableRef = Text;
+        Model->Event[Event].Swc = Parser->Swc;
+        return;
+    }
+    case RTEGEN_TAG_DEFINITION_REF:
+        if ((Parent == RTEGEN_TAG_ECUC_CONTAINER_VALUE) && (Parser->EcucDepth <= RTEGEN_MAX_ECUC_DEPTH) &&
+            (strcmp(RteGen_LastSegment(Text), "RteEventToTaskMapping") == 0)) {
+            uint32 NewMapping = RTEGEN_NEW(Model, TaskMapping);
+
+            Model->TaskMapping[NewMapping].Path = RteGen_StrDup(Parser->Path, Parser->Stack[Parser->Depth - 2u].PathLength);
+            Parser->EcucMapping[Parser->EcucDepth - 1u] = NewMapping;
+        } else if ((Parent == RTEGEN_TAG_ECUC_REFERENCE_VALUE) || (Parent == RTEGEN_TAG_ECUC_NUMERICAL_PARAM_VALUE)) {
+            (void)snprintf(Parser->ParamDef, sizeof(Parser->ParamDef), "%s", RteGen_LastSegment(Text));
+        } else {
+            // Definition of a container or parameter outside the subset
+        }
+        break;
+    case RTEGEN_TAG_VALUE_REF:
+        if ((Mapping != RTEGEN_NONE) && (Parent == RTEGEN_TAG_ECUC_REFERENCE_VALUE)) {
+            if (strcmp(Parser->ParamDef, "RteEventRef") == 0) {
+                Model->TaskMapping[Mapping].EventRef = Text;
+                return;
+            }
+            if (strcmp(Parser->ParamDef, "RteMappedToTaskRef") == 0) {
+                Model->TaskMapping[Mapping].TaskRef = Text;
+                return;
+            }
+        }
+        break;
+    case RTEGEN_TAG_VALUE:
+        if ((Mapping != RTEGEN_NONE) && (Parent == RTEGEN_TAG_ECUC_NUMERICAL_PARAM_VALUE) &&
+            (strcmp(Parser->ParamDef, "RtePositionInTask") == 0)) {
+            Model->TaskMapping[Mapping].Position = (uint32)strtoul(Text, NULL_PTR, 0);
+        }
+        break;
+    case RTEGEN_TAG_TARGET_P_PORT_REF:
+        if (Parser->Connector != RTEGEN_NONE) {
+            Model->Connector[Parser->Connector].ProviderRef = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_TARGET_R_PORT_REF:
+        if (Parser->Connector != RTEGEN_NONE) {
+            Model->Connector[Parser->Connector].RequesterRef = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_CONTEXT_PORT_REF:
+        if (Parser->SignalMapping != RTEGEN_NONE) {
+            Model->SignalMapping[Parser->SignalMapping].PortRef = Text;
+            return;
+        }
+        break;
+    case RTEGEN_TAG_SYSTEM_SIGNAL_REF:
+        if (Parser->SignalMapping != RTEGEN_NONE) {
+            Model->SignalMapping[Parser->SignalMapping].SignalRef = Text;
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    free(Text);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_OnEnd(P2VAR(void, AUTOMATIC, RTEGEN_VAR) Ctx) {
+    P2VAR(RteGen_ParserType, AUTOMATIC, RTEGEN_VAR) Parser = Ctx;
+    uint8 Tag;
+
+    if (Parser->Overflow > 0u) {
+        Parser->Overflow--;
+        return;
+    }
+    if (Parser->Depth == 0u) {
+        return;
+    }
+    Tag = Parser->Stack[Parser->Depth - 1u].Tag;
+    if (Parser->Collect == TRUE) {
+        RteGen_OnLeaf(Parser, Tag);
+        Parser->Collect = FALSE;
+    }
+
+    switch (Tag) {
+    case RTEGEN_TAG_VARIABLE_DATA_PROTOTYPE:
+        Parser->Element = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_SW_COMPONENT_TYPE:
+        Parser->Swc = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_P_PORT_PROTOTYPE:
+    case RTEGEN_TAG_R_PORT_PROTOTYPE:
+        Parser->Port = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_RUNNABLE_ENTITY:
+        Parser->Runnable = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_VARIABLE_ACCESS:
+        Parser->Access = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_ECUC_CONTAINER_VALUE:
+        Parser->EcucDepth--;
+        break;
+    case RTEGEN_TAG_ASSEMBLY_SW_CONNECTOR:
+        Parser->Connector = RTEGEN_NONE;
+        break;
+    case RTEGEN_TAG_SIGNAL_MAPPING:
+        Parser->SignalMapping = RTEGEN_NONE;
+        break;
+    default:
+        break;
+    }
+    Parser->Depth--;
+}
+
+FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_LoadArxml(P2CONST(char, AUTOMATIC, RTEGEN_VAR) FileName, P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model,
+                                                   P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) BytesRead) {
+    static VAR(RteGen_ParserType, RTEGEN_VAR) Parser;
+    RteGen_SaxHandlerType Handler;
+    Std_ReturnType Result;
+
+    RteGen_InitTagTable();
+    (void)memset(&Parser, 0, sizeof(Parser));
+    Parser.Model = Model;
+    Parser.Swc = RTEGEN_NONE;
+    Parser.Element = RTEGEN_NONE;
+    Parser.Port = RTEGEN_NONE;
+    Parser.Runnable = RTEGEN_NONE;
+    Parser.Access = RTEGEN_NONE;
+    Parser.Connector = RTEGEN_NONE;
+    Parser.SignalMapping = RTEGEN_NONE;
+
+    Handler.StartElement = RteGen_OnStart;
+    Handler.EndElement = RteGen_OnEnd;
+    Handler.Text = RteGen_OnText;
+    Handler.Ctx = &Parser;
+    Result = RteGen_SaxParseFile(FileName, &Handler, BytesRead);
+    if ((Result == E_OK) && ((Parser.Depth != 0u) || (Parser.Overflow != 0u))) {
+        fprintf(stderr, "rtegen: %s: %u elements not closed at end of file\n", FileName, Parser.Depth + Parser.Overflow);
+        Result = E_NOT_OK;
+    }
+    free(Parser.Text.Data);
+    return Result;
+}
+
+/* RTE GENERATOR - CODE EMITTER */
+// File: RteGen_Emit.c
+/* Turns the model into the RTE C files, following the hand-written reference
+ * in Rte_DoorControl.c / Rte_Data.c:
+ * - P-port element mapped to a system signal: Rte_Write calls Com_SendSignal
+ * - intra-ECU element: last-is-best buffer (atomic word up to 8 bytes, latch otherwise)
+ *   owned by the single sender; a reader whose sender never writes it gets RTE_E_UNCONNECTED
+ * - queued element: SPSC ring per receiver port a runnable receives from, MPSC if
+ *   several senders are connected; a sender skips receiver ports without a ring
+ * A port API is context-proven when every runnable of the component accessing
+ * it is mapped to a task; it then uses RTE_CHECK_PROVEN_CONTEXT() and calls the
+ * BSW directly, otherwise it checks the context at runtime. */
+#include "RteGen.h"
+
+typedef struct {
+    uint32 Port;
+    uint32 Element;
+    boolean Write;
+    boolean Proven;
+} RteGen_ApiType;
+
+typedef struct {
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model;
+    RteGen_MapType SwcByPath;
+    RteGen_MapType PortByPath;
+    RteGen_MapType ElementByPath;
+    RteGen_MapType RunnableByPath;
+    RteGen_MapType EventByPath;
+    RteGen_MapType SignalByPortElement;     // "<port path>|<element path>" -> SignalMapping
+    RteGen_MapType ApiByPortElement;
+    RTEGEN_ARRAY(RteGen_ApiType, Api);
+    // Resolved connectors per port: senders of an R-port, receivers of a P-port (CSR)
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) NumSenders;
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) Sender;
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) FirstReceiver;
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) Receiver;
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) FirstApi;          // Port APIs per component (CSR)
+    P2VAR(uint32, AUTOMATIC, RTEGEN_VAR) SwcApi;
+    uint32 Warnings;
+    uint32 Errors;
+} RteGen_EmitterType;
+
+static CONST(P2CONST(char, AUTOMATIC, RTEGEN_CONST), RTEGEN_CONST) RteGen_WordTypes[] = {
+    "boolean", "uint8", "sint8", "uint16", "sint16", "uint32", "sint32", "uint64", "sint64", "float32", "float64"
+};
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_IsWordType(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Type) {
+    // Fits the 64-bit atomic word of an intra-ECU buffer
+    uint32 i;
+
+    for (i = 0u; i < (sizeof(RteGen_WordTypes) / sizeof(RteGen_WordTypes[0])); i++) {
+        if (strcmp(Type, RteGen_WordTypes[i]) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static FUNC_P2VAR(char, RTEGEN_VAR, RTEGEN_CODE) RteGen_PairKey(P2CONST(char, AUTOMATIC, RTEGEN_VAR) First, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Second) {
+    RteGen_StringType Key = { NULL_PTR, 0u, 0u };
+
+    RteGen_Printf(&Key, "%s|%s", First, Second);
+    return Key.Data;
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_Warn(P2VAR(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter,
+                                           P2CONST(char, AUTOMATIC, RTEGEN_VAR) What, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Ref) {
+    fprintf(stderr, "rtegen: warning: unresolved %s %s\n", What, (Ref != NULL_PTR) ? Ref : "(missing)");
+    Emitter->Warnings++;
+}
+
+static FUNC(uint32, RTEGEN_CODE) RteGen_SignalOf(P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter, uint32 Port, uint32 Element) {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key = RteGen_PairKey(Emitter->Model->Port[Port].Path, Emitter->Model->Element[Element].Path);
+    uint32 Signal = RteGen_MapGet(&Emitter->SignalByPortElement, Key);
+
+    free(Key);
+    return Signal;
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_HasBuffer(P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter, uint32 Port, uint32 Element) {
+    // A last-is-best buffer exists for a P-port element written by some runnable and not mapped to a signal
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key = RteGen_PairKey(Emitter->Model->Port[Port].Path, Emitter->Model->Element[Element].Path);
+    uint32 Api = RteGen_MapGet(&Emitter->ApiByPortElement, Key);
+
+    free(Key);
+    return ((Api != RTEGEN_NONE) && (Emitter->Api[Api].Write == TRUE) && (Emitter->Model->Element[Element].Queued == FALSE) &&
+            (RteGen_SignalOf(Emitter, Port, Element) == RTEGEN_NONE)) ? TRUE : FALSE;
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_HasQueue(P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter, uint32 Port, uint32 Element) {
+    // A queue exists for an R-port element of a queued element some runnable receives from
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key = RteGen_PairKey(Emitter->Model->Port[Port].Path, Emitter->Model->Element[Element].Path);
+    uint32 Api = RteGen_MapGet(&Emitter->ApiByPortElement, Key);
+
+    free(Key);
+    return ((Api != RTEGEN_NONE) && (Emitter->Api[Api].Write == FALSE) && (Emitter->Model->Element[Element].Queued == TRUE)) ? TRUE : FALSE;
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_Resolve(P2VAR(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter) {
+    // Index the model by path, count task mappings per runnable and collect the port APIs
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+    uint32 i;
+
+    for (i = 0u; i < Model->NumSwc; i++) {
+        if (Model->Swc[i].Path != NULL_PTR) {
+            RteGen_MapPut(&Emitter->SwcByPath, Model->Swc[i].Path, i);
+        }
+    }
+    for (i = 0u; i < Model->NumPort; i++) {
+        if (Model->Port[i].Path != NULL_PTR) {
+            RteGen_MapPut(&Emitter->PortByPath, Model->Port[i].Path, i);
+        }
+    }
+    for (i = 0u; i < Model->NumElement; i++) {
+        if (Model->Element[i].Path != NULL_PTR) {
+            RteGen_MapPut(&Emitter->ElementByPath, Model->Element[i].Path, i);
+        }
+        if (Model->Element[i].Type == NULL_PTR) {
+            Model->Element[i].Type = RteGen_StrDup("uint8", 5u);
+        }
+    }
+    for (i = 0u; i < Model->NumRunnable; i++) {
+        if (Model->Runnable[i].Path != NULL_PTR) {
+            RteGen_MapPut(&Emitter->RunnableByPath, Model->Runnable[i].Path, i);
+        }
+    }
+    for (i = 0u; i < Model->NumEvent; i++) {
+        RteGen_MapPut(&Emitter->EventByPath, Model->Event[i].Path, i);
+    }
+    for (i = 0u; i < Model->NumSignalMapping; i++) {
+        P2CONST(RteGen_SignalMappingType, AUTOMATIC, RTEGEN_VAR) Mapping = &Model->SignalMapping[i];
+
+        if ((Mapping->PortRef != NULL_PTR) && (Mapping->ElementRef != NULL_PTR) && (Mapping->SignalRef != NULL_PTR)) {
+            RteGen_MapPut(&Emitter->SignalByPortElement, RteGen_PairKey(Mapping->PortRef, Mapping->ElementRef), i);
+        }
+    }
+
+    // Connectors are scanned once here; emitting then walks the per-port lists
+    Emitter->NumSenders = calloc((size_t)Model->NumPort + 1u, sizeof(uint32));
+    Emitter->Sender = calloc((size_t)Model->NumPort + 1u, sizeof(uint32));
+    Emitter->FirstReceiver = calloc((size_t)Model->NumPort + 2u, sizeof(uint32));
+    Emitter->Receiver = calloc((size_t)Model->NumConnector + 1u, sizeof(uint32));
+    if ((Emitter->NumSenders == NULL_PTR) || (Emitter->Sender == NULL_PTR) || (Emitter->FirstReceiver == NULL_PTR) || (Emitter->Receiver == NULL_PTR)) {
+        fprintf(stderr, "rtegen: out of memory\n");
+        exit(2);
+    }
+    for (i = 0u; i < Model->NumConnector; i++) {
+        uint32 Provider = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].ProviderRef);
+        uint32 Requester = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].RequesterRef);
+
+        if ((Provider == RTEGEN_NONE) || (Requester == RTEGEN_NONE)) {
+            RteGen_Warn(Emitter, "ASSEMBLY-SW-CONNECTOR port", (Provider == RTEGEN_NONE) ? Model->Connector[i].ProviderRef : Model->Connector[i].RequesterRef);
+            continue;
+        }
+        if (Emitter->NumSenders[Requester] == 0u) {
+            Emitter->Sender[Requester] = Provider;
+        }
+        Emitter->NumSenders[Requester]++;
+        Emitter->FirstReceiver[Provider + 2u]++;
+    }
+    for (i = 0u; i < Model->NumPort; i++) {
+        Emitter->FirstReceiver[i + 2u] += Emitter->FirstReceiver[i + 1u];
+    }
+    for (i = 0u; i < Model->NumConnector; i++) {
+        uint32 Provider = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].ProviderRef);
+        uint32 Requester = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].RequesterRef);
+
+        if ((Provider != RTEGEN_NONE) && (Requester != RTEGEN_NONE)) {
+            Emitter->Receiver[Emitter->FirstReceiver[Provider + 1u]++] = Requester;
+        }
+    }
+
+    for (i = 0u; i < Model->NumTaskMapping; i++) {
+        uint32 Event = RteGen_MapGet(&Emitter->EventByPath, Model->TaskMapping[i].EventRef);
+        uint32 Runnable;
+
+        if ((Event == RTEGEN_NONE) || (Model->TaskMapping[i].TaskRef == NULL_PTR)) {
+            RteGen_Warn(Emitter, "RteEventRef", Model->TaskMapping[i].EventRef);
+            continue;
+        }
+        Runnable = RteGen_MapGet(&Emitter->RunnableByPath, Model->Event[Event].RunnableRef);
+        if (Runnable == RTEGEN_NONE) {
+            RteGen_Warn(Emitter, "START-ON-EVENT-REF", Model->Event[Event].RunnableRef);
+            continue;
+        }
+        Model->Runnable[Runnable].NumTasks++;
+    }
+
+    for (i = 0u; i < Model->NumAccess; i++) {
+        P2CONST(RteGen_AccessType, AUTOMATIC, RTEGEN_VAR) Access = &Model->Access[i];
+        uint32 Port = RteGen_MapGet(&Emitter->PortByPath, Access->PortRef);
+        uint32 Element = RteGen_MapGet(&Emitter->ElementByPath, Access->ElementRef);
+        P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key;
+        uint32 Api;
+
+        if ((Port == RTEGEN_NONE) || (Element == RTEGEN_NONE)) {
+            RteGen_Warn(Emitter, "VARIABLE-ACCESS", (Port == RTEGEN_NONE) ? Access->PortRef : Access->ElementRef);
+            continue;
+        }
+        Key = RteGen_PairKey(Access->PortRef, Access->ElementRef);
+        Api = RteGen_MapGet(&Emitter->ApiByPortElement, Key);
+        if (Api == RTEGEN_NONE) {
+            Api = RTEGEN_NEW(Emitter, Api);
+            Emitter->Api[Api].Port = Port;
+            Emitter->Api[Api].Element = Element;
+            Emitter->Api[Api].Write = Model->Port[Port].Provided;
+            Emitter->Api[Api].Proven = TRUE;
+            RteGen_MapPut(&Emitter->ApiByPortElement, Key, Api);
+        } else {
+            free(Key);
+        }
+        if (Model->Runnable[Access->Runnable].NumTasks == 0u) {
+            Emitter->Api[Api].Proven = FALSE;
+        }
+    }
+
+    // A last-is-best buffer has one writer: several senders into a non-queued element is a model error
+    for (i = 0u; i < Emitter->NumApi; i++) {
+        P2CONST(RteGen_ApiType, AUTOMATIC, RTEGEN_VAR) Api = &Emitter->Api[i];
+
+        if ((Api->Write == FALSE) && (Model->Element[Api->Element].Queued == FALSE) && (Emitter->NumSenders[Api->Port] > 1u) &&
+            (RteGen_SignalOf(Emitter, Api->Port, Api->Element) == RTEGEN_NONE)) {
+            fprintf(stderr, "rtegen: error: %u senders connected to non-queued %s of %s\n",
+                    Emitter->NumSenders[Api->Port], Model->Element[Api->Element].Path, Model->Port[Api->Port].Path);
+            Emitter->Errors++;
+        }
+    }
+
+    Emitter->FirstApi = calloc((size_t)Model->NumSwc + 2u, sizeof(uint32));
+    Emitter->SwcApi = calloc((size_t)Emitter->NumApi + 1u, sizeof(uint32));
+    if ((Emitter->FirstApi == NULL_PTR) || (Emitter->SwcApi == NULL_PTR)) {
+        fprintf(stderr, "rtegen: out of memory\n");
+        exit(2);
+    }
+    for (i = 0u; i < Emitter->NumApi; i++) {
+        Emitter->FirstApi[Model->Port[Emitter->Api[i].Port].Swc + 2u]++;
+    }
+    for (i = 0u; i < Model->NumSwc; i++) {
+        Emitter->FirstApi[i + 2u] += Emitter->FirstApi[i + 1u];
+    }
+    for (i = 0u; i < Emitter->NumApi; i++) {
+        Emitter->SwcApi[Emitter->FirstApi[Model->Port[Emitter->Api[i].Port].Swc + 1u]++] = i;
+    }
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_PortName(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out, P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter,
+                                               uint32 Port, uint32 Element) {
+    // <Swc>_<Port>_<Element>, the suffix of every generated API and buffer name
+    P2CONST(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+
+    RteGen_Printf(Out, "%s_%s_%s", Model->Swc[Model->Port[Port].Swc].Name, Model->Port[Port].Name, Model->Element[Element].Name);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitCfg(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out) {
+    RteGen_Printf(Out,
+        "/* Generated by rtegen - do not edit */\n"
+        "#ifndef RTE_CFG_H\n#define RTE_CFG_H\n\n"
+        "#if (RTE_DEV_ERROR_DETECT == STD_ON)\n"
+        "#define RTE_CHECK_PROVEN_CONTEXT()      Rte_CheckTaskContext()\n"
+        "#else\n"
+        "#define RTE_CHECK_PROVEN_CONTEXT()      ((void)0)\n"
+        "#endif\n\n#endif\n");
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitData(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Header, P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Source,
+                                               P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter) {
+    // Buffers of provided intra-ECU elements and queues of required queued elements
+    P2CONST(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+    RteGen_StringType Name = { NULL_PTR, 0u, 0u };
+    RteGen_StringType Init = { NULL_PTR, 0u, 0u };
+    uint32 i;
+
+    RteGen_Printf(Header, "/* Generated by rtegen - do not edit */\n#ifndef RTE_DATA_H\n#define RTE_DATA_H\n\n#include <stdatomic.h>\n#include \"Rte_Buffer.h\"\n\n");
+    RteGen_Printf(Source, "/* Generated by rtegen - do not edit */\n#include \"Rte_Data.h\"\n\n");
+
+    for (i = 0u; i < Emitter->NumApi; i++) {
+        P2CONST(RteGen_ApiType, AUTOMATIC, RTEGEN_VAR) Api = &Emitter->Api[i];
+        P2CONST(RteGen_DataElementType, AUTOMATIC, RTEGEN_VAR) Element = &Model->Element[Api->Element];
+
+        Name.Length = 0u;
+        RteGen_PortName(&Name, Emitter, Api->Port, Api->Element);
+
+        if ((Api->Write == TRUE) && (RteGen_HasBuffer(Emitter, Api->Port, Api->Element) == TRUE)) {
+            if (RteGen_IsWordType(Element->Type) == TRUE) {
+                RteGen_Printf(Header, "extern VAR(atomic_uint_least64_t, RTE_VAR_NOINIT) Rte_Buf_%s;\n", Name.Data);
+                RteGen_Printf(Source, "VAR(atomic_uint_least64_t, RTE_VAR_NOINIT) Rte_Buf_%s;\n\n", Name.Data);
+            } else {
+                RteGen_Printf(Header, "extern VAR(Rte_LatchBufferType, RTE_VAR_NOINIT) Rte_Buf_%s;\n", Name.Data);
+                RteGen_Printf(Source,
+                    "static VAR(uint8, RTE_VAR_NOINIT) Rte_BufCopy_%s[2][sizeof(%s)];\n"
+                    "VAR(Rte_LatchBufferType, RTE_VAR_NOINIT) Rte_Buf_%s = {\n"
+                    "    .Size = sizeof(%s), .Copy = { Rte_BufCopy_%s[0], Rte_BufCopy_%s[1] }\n};\n\n",
+                    Name.Data, Element->Type, Name.Data, Element->Type, Name.Data, Name.Data);
+            }
+        } else if ((Api->Write == FALSE) && (RteGen_HasQueue(Emitter, Api->Port, Api->Element) == TRUE)) {
+            uint32 Capacity = 1u;
+            boolean Mpsc = (Emitter->NumSenders[Api->Port] > 1u) ? TRUE : FALSE;
+
+            while (Capacity < Model->Port[Api->Port].QueueLength) {
+                Capacity *= 2u;
+            }
+            RteGen_Printf(Header, "extern VAR(Rte_QueueType, RTE_VAR_NOINIT) Rte_Queue_%s;\n", Name.Data);
+            RteGen_Printf(Source, "// %s receiver, QUEUE-LENGTH %u\n", (Mpsc == TRUE) ? "MPSC" : "SPSC", Model->Port[Api->Port].QueueLength);
+            RteGen_Printf(Source, "static VAR(%s, RTE_VAR_NOINIT) Rte_QueueStorage_%s[%u];\n", Element->Type, Name.Data, Capacity);
+            if (Mpsc == TRUE) {
+                RteGen_Printf(Source, "static VAR(atomic_uint_least32_t, RTE_VAR_NOINIT) Rte_QueueSequence_%s[%u];\n", Name.Data, Capacity);
+            }
+            RteGen_Printf(Source,
+                "VAR(Rte_QueueType, RTE_VAR_NOINIT) Rte_Queue_%s = {\n"
+                "    .Capacity = %uu, .ElementSize = sizeof(%s), .Storage = (uint8*)Rte_QueueStorage_%s, .Sequence = ",
+                Name.Data, Capacity, Element->Type, Name.Data);
+            if (Mpsc == TRUE) {
+                RteGen_Printf(Source, "Rte_QueueSequence_%s\n};\n\n", Name.Data);
+            } else {
+                RteGen_Printf(Source, "NULL_PTR\n};\n\n");
+            }
+            RteGen_Printf(&Init, "    Rte_QueueInit(&Rte_Queue_%s);\n", Name.Data);
+        } else {
+            // Com signal or the receiving side of a buffer: no storage of its own
+        }
+    }
+
+    RteGen_Printf(Header, "\nextern FUNC(void, RTE_CODE) Rte_InitQueues(void);\n\n#endif\n");
+    RteGen_Printf(Source, "FUNC(void, RTE_CODE) Rte_InitQueues(void) {\n%s}\n", (Init.Data != NULL_PTR) ? Init.Data : "");
+    free(Name.Data);
+    free(Init.Data);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitContextCheck(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out, boolean Proven) {
+    RteGen_Printf(Out, (Proven == TRUE) ? "    RTE_CHECK_PROVEN_CONTEXT();\n" : "    Rte_CheckTaskContext();\n");
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitApi(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out, P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter,
+                                              P2CONST(RteGen_ApiType, AUTOMATIC, RTEGEN_VAR) Api) {
+    P2CONST(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+    P2CONST(RteGen_DataElementType, AUTOMATIC, RTEGEN_VAR) Element = &Model->Element[Api->Element];
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Type = Element->Type;
+    boolean ByValue = RteGen_IsWordType(Type);
+    uint32 Signal = RteGen_SignalOf(Emitter, Api->Port, Api->Element);
+    RteGen_StringType Name = { NULL_PTR, 0u, 0u };
+    RteGen_StringType Peer = { NULL_PTR, 0u, 0u };
+    uint32 i;
+
+    RteGen_PortName(&Name, Emitter, Api->Port, Api->Element);
+
+    if (Api->Write == TRUE) {
+        RteGen_Printf(Out, "FUNC(Std_ReturnType, RTE_CODE) Rte_%s_%s(", (Element->Queued == TRUE) ? "Send" : "Write", Name.Data);
+        if (ByValue == TRUE) {
+            RteGen_Printf(Out, "%s data) {\n", Type);
+        } else {
+            RteGen_Printf(Out, "P2CONST(%s, AUTOMATIC, RTE_APPL_DATA) data) {\n", Type);
+        }
+
+        if (Element->Queued == TRUE) {
+            // One enqueue per connected receiver port that some runnable receives from
+            RteGen_Printf(Out, "    Std_ReturnType Status = RTE_E_OK;\n\n");
+            RteGen_EmitContextCheck(Out, Api->Proven);
+            for (i = Emitter->FirstReceiver[Api->Port]; i < Emitter->FirstReceiver[Api->Port + 1u]; i++) {
+                uint32 RPort = Emitter->Receiver[i];
+
+                if (RteGen_HasQueue(Emitter, RPort, Api->Element) == FALSE) {
+                    continue;
+                }
+                Peer.Length = 0u;
+                RteGen_PortName(&Peer, Emitter, RPort, Api->Element);
+                RteGen_Printf(Out, "    if (Rte_%sSend(&Rte_Queue_%s, %sdata) != RTE_E_OK) {\n        Status = RTE_E_LIMIT;\n    }\n",
+                              (Emitter->NumSenders[RPort] > 1u) ? "Mpsc" : "Spsc", Peer.Data, (ByValue == TRUE) ? "&" : "");
+            }
+            RteGen_Printf(Out, "    return Status;\n}\n\n");
+        } else if (Signal != RTEGEN_NONE) {
+            P2CONST(char, AUTOMATIC, RTEGEN_VAR) SignalName = RteGen_LastSegment(Model->SignalMapping[Signal].SignalRef);
+
+            if (Api->Proven == TRUE) {
+                RteGen_EmitContextCheck(Out, TRUE);
+                RteGen_Printf(Out, "    return Com_SendSignal(ComConf_ComSignal_%s, %sdata);\n}\n\n", SignalName, (ByValue == TRUE) ? "&" : "");
+            } else {
+                RteGen_Printf(Out, "    return Rte_Com_SendSignal(ComConf_ComSignal_%s, %sdata);\n}\n\n", SignalName, (ByValue == TRUE) ? "&" : "");
+            }
+        } else if (ByValue == TRUE) {
+            RteGen_Printf(Out, "    uint64 Word = 0u;\n\n");
+            RteGen_EmitContextCheck(Out, Api->Proven);
+            RteGen_Printf(Out,
+                "    (void)memcpy(&Word, &data, sizeof(data));\n"
+                "    atomic_store_explicit(&Rte_Buf_%s, Word, memory_order_release);\n"
+                "    return RTE_E_OK;\n}\n\n", Name.Data);
+        } else {
+            RteGen_EmitContextCheck(Out, Api->Proven);
+            RteGen_Printf(Out, "    Rte_LatchWrite(&Rte_Buf_%s, data);\n    return RTE_E_OK;\n}\n\n", Name.Data);
+        }
+    } else if (Element->Queued == TRUE) {
+        RteGen_Printf(Out,
+            "FUNC(Std_ReturnType, RTE_CODE) Rte_Receive_%s(P2VAR(%s, AUTOMATIC, RTE_APPL_DATA) data) {\n"
+            "    uint8 Count;\n\n", Name.Data, Type);
+        RteGen_EmitContextCheck(Out, Api->Proven);
+        RteGen_Printf(Out, "    return Rte_QueueReceive(&Rte_Queue_%s, data, 1u, &Count);\n}\n\n", Name.Data);
+        RteGen_Printf(Out,
+            "FUNC(Std_ReturnType, RTE_CODE) Rte_ReceiveBatch_%s(P2VAR(%s, AUTOMATIC, RTE_APPL_DATA) data, uint8 MaxCount, "
+            "P2VAR(uint8, AUTOMATIC, RTE_APPL_DATA) Count) {\n", Name.Data, Type);
+        RteGen_EmitContextCheck(Out, Api->Proven);
+        RteGen_Printf(Out, "    return Rte_QueueReceive(&Rte_Queue_%s, data, MaxCount, Count);\n}\n\n", Name.Data);
+    } else {
+        RteGen_Printf(Out, "FUNC(Std_ReturnType, RTE_CODE) Rte_Read_%s(P2VAR(%s, AUTOMATIC, RTE_APPL_DATA) data) {\n", Name.Data, Type);
+        if (Signal != RTEGEN_NONE) {
+            RteGen_EmitContextCheck(Out, Api->Proven);
+            RteGen_Printf(Out, "    return Com_ReceiveSignal(ComConf_ComSignal_%s, data);\n}\n\n",
+                          RteGen_LastSegment(Model->SignalMapping[Signal].SignalRef));
+        } else {
+            uint32 PPort = Emitter->Sender[Api->Port];
+
+            // No sender, or a sender whose element no runnable writes: nothing to read
+            if ((Emitter->NumSenders[Api->Port] == 0u) || (RteGen_HasBuffer(Emitter, PPort, Api->Element) == FALSE)) {
+                RteGen_Printf(Out, "    return RTE_E_UNCONNECTED;\n}\n\n");
+            } else {
+                Peer.Length = 0u;
+                RteGen_PortName(&Peer, Emitter, PPort, Api->Element);
+                if (ByValue == TRUE) {
+                    RteGen_Printf(Out, "    uint64 Word;\n\n");
+                    RteGen_EmitContextCheck(Out, Api->Proven);
+                    RteGen_Printf(Out,
+                        "    Word = atomic_load_explicit(&Rte_Buf_%s, memory_order_acquire);\n"
+                        "    (void)memcpy(data, &Word, sizeof(*data));\n"
+                        "    return RTE_E_OK;\n}\n\n", Peer.Data);
+                } else {
+                    RteGen_EmitContextCheck(Out, Api->Proven);
+                    RteGen_Printf(Out, "    Rte_LatchRead(&Rte_Buf_%s, data);\n    return RTE_E_OK;\n}\n\n", Peer.Data);
+                }
+            }
+        }
+    }
+    free(Name.Data);
+    free(Peer.Data);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitSwc(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out, P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter,
+                                              uint32 Swc) {
+    uint32 i;
+
+    RteGen_Printf(Out,
+        "/* Generated by rtegen - do not edit */\n"
+        "#include <string.h>\n#include \"Rte_%s.h\"\n#include \"Rte_Cfg.h\"\n#include \"Rte_Data.h\"\n\n",
+        Emitter->Model->Swc[Swc].Name);
+    for (i = Emitter->FirstApi[Swc]; i < Emitter->FirstApi[Swc + 1u]; i++) {
+        RteGen_EmitApi(Out, Emitter, &Emitter->Api[Emitter->SwcApi[i]]);
+    }
+}
+
+static FUNC(sint32, RTEGEN_CODE) RteGen_CompareMapping(P2CONST(void, AUTOMATIC, RTEGEN_VAR) Left, P2CONST(void, AUTOMATIC, RTEGEN_VAR) Right) {
+    // qsort order of Rte_Schedule.c: by task name, then RtePositionInTask
+    P2CONST(RteGen_TaskMappingType, AUTOMATIC, RTEGEN_VAR) A = Left;
+    P2CONST(RteGen_TaskMappingType, AUTOMATIC, RTEGEN_VAR) B = Right;
+    sint32 Order = strcmp(RteGen_LastSegment(A->TaskRef), RteGen_LastSegment(B->TaskRef));
+
+    if (Order != 0) {
+        return Order;
+    }
+    return (A->Position < B->Position) ? -1 : ((A->Position > B->Position) ? 1 : 0);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_EmitSchedule(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Out, P2VAR(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter) {
+    // One TASK body per OS task, calling its runnables in RtePositionInTask order
+    P2VAR(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Task = NULL_PTR;
+    uint32 i;
+    uint32 Valid = 0u;
+
+    // Drop mappings that cannot be resolved, then sort the rest
+    for (i = 0u; i < Model->NumTaskMapping; i++) {
+        if ((Model->TaskMapping[i].TaskRef != NULL_PTR) && (RteGen_MapGet(&Emitter->EventByPath, Model->TaskMapping[i].EventRef) != RTEGEN_NONE)) {
+            Model->TaskMapping[Valid++] = Model->TaskMapping[i];
+        }
+    }
+    Model->NumTaskMapping = Valid;
+    if (Valid > 1u) {
+        qsort(Model->TaskMapping, Valid, sizeof(Model->TaskMapping[0]), RteGen_CompareMapping);
+    }
+
+    RteGen_Printf(Out, "/* Generated by rtegen - do not edit */\n#include \"Os.h\"\n#include \"Rte_Cfg.h\"\n\n");
+    for (i = 0u; i < Model->NumTaskMapping; i++) {
+        P2CONST(RteGen_TaskMappingType, AUTOMATIC, RTEGEN_VAR) Mapping = &Model->TaskMapping[i];
+        uint32 Runnable = RteGen_MapGet(&Emitter->RunnableByPath,
+                                        Model->Event[RteGen_MapGet(&Emitter->EventByPath, Mapping->EventRef)].RunnableRef);
+
+        if ((Task == NULL_PTR) || (strcmp(Task, RteGen_LastSegment(Mapping->TaskRef)) != 0)) {
+            if (Task != NULL_PTR) {
+                RteGen_Printf(Out, "    (void)TerminateTask();\n}\n\n");
+            }
+            Task = RteGen_LastSegment(Mapping->TaskRef);
+            RteGen_Printf(Out, "TASK(%s) {\n", Task);
+        }
+        if (Runnable != RTEGEN_NONE) {
+            RteGen_Printf(Out, "    %s();\n",
+                          (Model->Runnable[Runnable].Symbol != NULL_PTR) ? Model->Runnable[Runnable].Symbol : Model->Runnable[Runnable].Name);
+        }
+    }
+    if (Task != NULL_PTR) {
+        RteGen_Printf(Out, "    (void)TerminateTask();\n}\n");
+    }
+}
+
+/* RTE GENERATOR - INCREMENTAL REGENERATION CACHE */
+// File: RteGen_Cache.c
+/* Keeps regeneration proportional to the change. Every model record gets a
+ * 64-bit FNV-1a hash of its fields; each output's input hash folds the hashes
+ * of the records it is generated from (its edges in the dependency graph):
+ * - Rte_<Swc>.c: the component, the data elements and signal mappings of its
+ *   accesses, the task mappings of its runnables, the connectors at its ports
+ *   together with the peer components, the connectors into peer R-ports and
+ *   the writer accesses and signal mappings of peer P-ports
+ * - Rte_Data.h/.c: all components, data elements, connectors, signal mappings
+ * - Rte_Schedule.c: all components and task mappings
+ * <outdir>/.rtegen_cache keeps the record hashes and, per output, the input
+ * hash, content hash and size. An output whose input hash is unchanged is not
+ * generated at all; a regenerated output is only written when its bytes
+ * differ, so the build sees no new timestamps for untouched files. Outputs of
+ * a previous run that are no longer generated are removed. */
+#include <sys/stat.h>
+#include "RteGen.h"
+
+#define RTEGEN_CACHE_FILE           ".rtegen_cache"
+#define RTEGEN_CACHE_HEADER         "rtegen-cache 1"
+#define RTEGEN_VERSION              "rtegen 2"     // Part of every input hash: bump when the emitted code changes
+#define RTEGEN_FNV64_BASIS          14695981039346656037ull
+#define RTEGEN_FNV64_PRIME          1099511628211ull
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key;         // Record path, or a synthesized key for unnamed records
+    uint64 Hash;
+} RteGen_CacheRecordType;
+
+typedef struct {
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Name;
+    uint64 InputHash;
+    uint64 ContentHash;
+    uint64 Size;
+} RteGen_CacheOutputType;
+
+typedef struct {
+    boolean Force;                  // -f: trust nothing from the previous run, compare every output with the disk
+    RteGen_MapType OldRecordByKey;
+    RteGen_MapType OldOutputByName;
+    RTEGEN_ARRAY(RteGen_CacheRecordType, OldRecord);
+    RTEGEN_ARRAY(RteGen_CacheOutputType, OldOutput);
+    RTEGEN_ARRAY(RteGen_CacheRecordType, Record);
+    RTEGEN_ARRAY(RteGen_CacheOutputType, Output);
+    // Input hashes of this run
+    uint64 CfgInput;
+    uint64 DataInput;
+    uint64 ScheduleInput;
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) SwcInput;
+    // Statistics
+    uint32 MatchedRecords;
+    uint32 ChangedRecords;          // Added, modified or deleted
+    uint32 Regenerated;
+    uint32 Rewritten;
+    uint32 Removed;
+} RteGen_CacheType;
+
+static FUNC(uint64, RTEGEN_CODE) RteGen_Hash64(uint64 Hash, P2CONST(void, AUTOMATIC, RTEGEN_VAR) Data, uint32 Length) {
+    P2CONST(uint8, AUTOMATIC, RTEGEN_VAR) Bytes = Data;
+    uint32 i;
+
+    for (i = 0u; i < Length; i++) {
+        Hash = (Hash ^ Bytes[i]) * RTEGEN_FNV64_PRIME;
+    }
+    return Hash;
+}
+
+static FUNC(uint64, RTEGEN_CODE) RteGen_HashString(uint64 Hash, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Text) {
+    // The terminator separates fields; a missing field hashes differently from an empty one
+    static CONST(uint8, RTEGEN_CONST) Missing = 0xFFu;
+
+    return (Text != NULL_PTR) ? RteGen_Hash64(Hash, Text, (uint32)strlen(Text) + 1u) : RteGen_Hash64(Hash, &Missing, 1u);
+}
+
+static FUNC(uint64, RTEGEN_CODE) RteGen_HashWord(uint64 Hash, uint64 Value) {
+    return RteGen_Hash64(Hash, &Value, (uint32)sizeof(Value));
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_CacheRecord(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Kind,
+                                                  P2CONST(char, AUTOMATIC, RTEGEN_VAR) Key, uint64 Hash) {
+    // Register one graph node of this run and compare it with the previous run
+    uint32 Record = RTEGEN_NEW(Cache, Record);
+    uint32 Old;
+    RteGen_StringType Name = { NULL_PTR, 0u, 0u };
+
+    RteGen_Printf(&Name, "%s:%s", Kind, (Key != NULL_PTR) ? Key : "");
+    Cache->Record[Record].Key = Name.Data;
+    Cache->Record[Record].Hash = Hash;
+    Old = RteGen_MapGet(&Cache->OldRecordByKey, Name.Data);
+    if (Old == RTEGEN_NONE) {
+        Cache->ChangedRecords++;
+    } else {
+        Cache->MatchedRecords++;
+        if (Cache->OldRecord[Old].Hash != Hash) {
+            Cache->ChangedRecords++;
+        }
+    }
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_CacheLoad(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir) {
+    RteGen_StringType FileName = { NULL_PTR, 0u, 0u };
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File;
+    static char Line[RTEGEN_MAX_PATH + 128u];
+
+    RteGen_Printf(&FileName, "%s/%s", OutDir, RTEGEN_CACHE_FILE);
+    File = fopen(FileName.Data, "r");
+    free(FileName.Data);
+    if (File == NULL_PTR) {
+        return;                     // First run: every output is compared with what is on disk
+    }
+    if ((fgets(Line, (int)sizeof(Line), File) == NULL_PTR) || (strncmp(Line, RTEGEN_CACHE_HEADER, strlen(RTEGEN_CACHE_HEADER)) != 0)) {
+        (void)fclose(File);
+        return;
+    }
+
+    while (fgets(Line, (int)sizeof(Line), File) != NULL_PTR) {
+        unsigned long long Input;
+        unsigned long long Content;
+        unsigned long long Size;
+        int Offset = 0;
+
+        Line[strcspn(Line, "\n")] = '\0';
+        if ((sscanf(Line, "R %llx %n", &Input, &Offset) == 1) && (Offset > 0)) {
+            uint32 Record = RTEGEN_NEW(Cache, OldRecord);
+
+            Cache->OldRecord[Record].Key = RteGen_StrDup(&Line[Offset], (uint32)strlen(&Line[Offset]));
+            Cache->OldRecord[Record].Hash = Input;
+            RteGen_MapPut(&Cache->OldRecordByKey, Cache->OldRecord[Record].Key, Record);
+        } else if ((sscanf(Line, "O %llx %llx %llu %n", &Input, &Content, &Size, &Offset) == 3) && (Offset > 0)) {
+            uint32 Output = RTEGEN_NEW(Cache, OldOutput);
+
+            Cache->OldOutput[Output].Name = RteGen_StrDup(&Line[Offset], (uint32)strlen(&Line[Offset]));
+            Cache->OldOutput[Output].InputHash = Input;
+            Cache->OldOutput[Output].ContentHash = Content;
+            Cache->OldOutput[Output].Size = Size;
+            RteGen_MapPut(&Cache->OldOutputByName, Cache->OldOutput[Output].Name, Output);
+        } else {
+            // Unknown line: ignored, the next save drops it
+        }
+    }
+    (void)fclose(File);
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_CacheHashModel(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(RteGen_EmitterType, AUTOMATIC, RTEGEN_VAR) Emitter) {
+    P2CONST(RteGen_ModelType, AUTOMATIC, RTEGEN_VAR) Model = Emitter->Model;
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) SwcHash = calloc((size_t)Model->NumSwc + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) PortHash = calloc((size_t)Model->NumPort + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) IntoPortHash = calloc((size_t)Model->NumPort + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) FromPortHash = calloc((size_t)Model->NumPort + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) ElementHash = calloc((size_t)Model->NumElement + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) ConnectorHash = calloc((size_t)Model->NumConnector + 1u, sizeof(uint64));
+    P2VAR(uint64, AUTOMATIC, RTEGEN_VAR) SignalHash = calloc((size_t)Model->NumSignalMapping + 1u, sizeof(uint64));
+    uint64 Version = RteGen_HashString(RTEGEN_FNV64_BASIS, RTEGEN_VERSION);
+    uint32 i;
+
+    Cache->SwcInput = calloc((size_t)Model->NumSwc + 1u, sizeof(uint64));
+    if ((SwcHash == NULL_PTR) || (PortHash == NULL_PTR) || (IntoPortHash == NULL_PTR) || (FromPortHash == NULL_PTR) || (ElementHash == NULL_PTR) ||
+        (ConnectorHash == NULL_PTR) || (SignalHash == NULL_PTR) || (Cache->SwcInput == NULL_PTR)) {
+        fprintf(stderr, "rtegen: out of memory\n");
+        exit(2);
+    }
+
+    // Record hashes. A component covers everything declared inside it, in document order.
+    for (i = 0u; i < Model->NumSwc; i++) {
+        SwcHash[i] = RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Model->Swc[i].Path), Model->Swc[i].Name);
+    }
+    for (i = 0u; i < Model->NumPort; i++) {
+        P2CONST(RteGen_PortType, AUTOMATIC, RTEGEN_VAR) Port = &Model->Port[i];
+        uint64 Hash = RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Port->Path), Port->Name);
+
+        Hash = RteGen_HashWord(RteGen_HashWord(Hash, Port->Provided), Port->QueueLength);
+        SwcHash[Port->Swc] = RteGen_HashWord(SwcHash[Port->Swc], Hash);
+    }
+    for (i = 0u; i < Model->NumRunnable; i++) {
+        P2CONST(RteGen_RunnableType, AUTOMATIC, RTEGEN_VAR) Runnable = &Model->Runnable[i];
+        uint64 Hash = RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Runnable->Path), Runnable->Symbol);
+
+        SwcHash[Runnable->Swc] = RteGen_HashWord(SwcHash[Runnable->Swc], RteGen_HashString(Hash, Runnable->Name));
+    }
+    for (i = 0u; i < Model->NumAccess; i++) {
+        P2CONST(RteGen_AccessType, AUTOMATIC, RTEGEN_VAR) Access = &Model->Access[i];
+        uint64 Hash = RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Access->PortRef), Access->ElementRef);
+        uint32 Swc = Model->Runnable[Access->Runnable].Swc;
+        uint32 Port = RteGen_MapGet(&Emitter->PortByPath, Access->PortRef);
+
+        // The runnable by path, not by index: a runnable added to another component shifts the indices
+        Hash = RteGen_HashString(RteGen_HashWord(Hash, Access->Write), Model->Runnable[Access->Runnable].Path);
+        SwcHash[Swc] = RteGen_HashWord(SwcHash[Swc], Hash);
+        if ((Port != RTEGEN_NONE) && (Model->Port[Port].Provided == TRUE)) {
+            FromPortHash[Port] = RteGen_HashWord(FromPortHash[Port], Hash);
+        }
+    }
+    for (i = 0u; i < Model->NumEvent; i++) {
+        if (Model->Event[i].Swc != RTEGEN_NONE) {
+            uint64 Hash = RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Model->Event[i].Path), Model->Event[i].RunnableRef);
+
+            SwcHash[Model->Event[i].Swc] = RteGen_HashWord(SwcHash[Model->Event[i].Swc], Hash);
+        }
+    }
+    for (i = 0u; i < Model->NumSwc; i++) {
+        RteGen_CacheRecord(Cache, "swc", Model->Swc[i].Path, SwcHash[i]);
+    }
+    for (i = 0u; i < Model->NumElement; i++) {
+        P2CONST(RteGen_DataElementType, AUTOMATIC, RTEGEN_VAR) Element = &Model->Element[i];
+
+        ElementHash[i] = RteGen_HashWord(RteGen_HashString(RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Element->Path), Element->Name),
+                                                           Element->Type), Element->Queued);
+        RteGen_CacheRecord(Cache, "element", Element->Path, ElementHash[i]);
+    }
+    for (i = 0u; i < Model->NumSignalMapping; i++) {
+        P2CONST(RteGen_SignalMappingType, AUTOMATIC, RTEGEN_VAR) Mapping = &Model->SignalMapping[i];
+        P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key = RteGen_PairKey((Mapping->PortRef != NULL_PTR) ? Mapping->PortRef : "",
+                                                                (Mapping->ElementRef != NULL_PTR) ? Mapping->ElementRef : "");
+
+        uint32 Port = RteGen_MapGet(&Emitter->PortByPath, Mapping->PortRef);
+
+        SignalHash[i] = RteGen_HashString(RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Mapping->PortRef), Mapping->ElementRef),
+                                          Mapping->SignalRef);
+        RteGen_CacheRecord(Cache, "signal-mapping", Key, SignalHash[i]);
+        free(Key);
+        if (Port != RTEGEN_NONE) {
+            FromPortHash[Port] = RteGen_HashWord(FromPortHash[Port], SignalHash[i]);
+        }
+    }
+
+    // Connectors: a sender's API names the receiver queues and depends on how many
+    // senders feed each of them, so a P-port also sees the connectors into its peers.
+    // A receiver's API reads the sender's buffer only while some runnable writes the
+    // element and no signal mapping takes it, so an R-port sees the accesses and
+    // mappings of the P-ports connected to it (RteGen_HasBuffer()).
+    // Only connectors with both ends resolved count, as in RteGen_Resolve().
+    for (i = 0u; i < Model->NumConnector; i++) {
+        uint32 Provider = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].ProviderRef);
+        uint32 Requester = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].RequesterRef);
+
+        ConnectorHash[i] = RteGen_HashString(RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Model->Connector[i].Path),
+                                                               Model->Connector[i].ProviderRef), Model->Connector[i].RequesterRef);
+        RteGen_CacheRecord(Cache, "connector", Model->Connector[i].Path, ConnectorHash[i]);
+        if ((Provider != RTEGEN_NONE) && (Requester != RTEGEN_NONE)) {
+            IntoPortHash[Requester] = RteGen_HashWord(IntoPortHash[Requester], ConnectorHash[i]);
+        }
+    }
+    for (i = 0u; i < Model->NumConnector; i++) {
+        uint32 Provider = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].ProviderRef);
+        uint32 Requester = RteGen_MapGet(&Emitter->PortByPath, Model->Connector[i].RequesterRef);
+
+        if ((Provider == RTEGEN_NONE) || (Requester == RTEGEN_NONE)) {
+            continue;
+        }
+        PortHash[Provider] = RteGen_HashWord(RteGen_HashWord(RteGen_HashWord(PortHash[Provider], ConnectorHash[i]),
+                                                             SwcHash[Model->Port[Requester].Swc]), IntoPortHash[Requester]);
+        PortHash[Requester] = RteGen_HashWord(RteGen_HashWord(RteGen_HashWord(PortHash[Requester], ConnectorHash[i]),
+                                                              SwcHash[Model->Port[Provider].Swc]), FromPortHash[Provider]);
+    }
+
+    // Rte_<Swc>.c
+    for (i = 0u; i < Model->NumSwc; i++) {
+        Cache->SwcInput[i] = RteGen_HashWord(Version, SwcHash[i]);
+    }
+    for (i = 0u; i < Model->NumPort; i++) {
+        Cache->SwcInput[Model->Port[i].Swc] = RteGen_HashWord(Cache->SwcInput[Model->Port[i].Swc], PortHash[i]);
+    }
+    for (i = 0u; i < Model->NumAccess; i++) {
+        P2CONST(RteGen_AccessType, AUTOMATIC, RTEGEN_VAR) Access = &Model->Access[i];
+        uint32 Swc = Model->Runnable[Access->Runnable].Swc;
+        uint32 Element = RteGen_MapGet(&Emitter->ElementByPath, Access->ElementRef);
+        uint32 Signal = RTEGEN_NONE;
+
+        if ((Access->PortRef != NULL_PTR) && (Access->ElementRef != NULL_PTR)) {
+            P2VAR(char, AUTOMATIC, RTEGEN_VAR) Key = RteGen_PairKey(Access->PortRef, Access->ElementRef);
+
+            Signal = RteGen_MapGet(&Emitter->SignalByPortElement, Key);
+            free(Key);
+        }
+        Cache->SwcInput[Swc] = RteGen_HashWord(RteGen_HashWord(Cache->SwcInput[Swc], (Element != RTEGEN_NONE) ? ElementHash[Element] : 0u),
+                                               (Signal != RTEGEN_NONE) ? SignalHash[Signal] : 0u);
+    }
+
+    // Task mappings decide which port APIs are context-proven and what Rte_Schedule.c calls
+    Cache->ScheduleInput = Version;
+    for (i = 0u; i < Model->NumTaskMapping; i++) {
+        P2CONST(RteGen_TaskMappingType, AUTOMATIC, RTEGEN_VAR) Mapping = &Model->TaskMapping[i];
+        uint64 Hash = RteGen_HashString(RteGen_HashString(RteGen_HashString(RTEGEN_FNV64_BASIS, Mapping->Path), Mapping->EventRef), Mapping->TaskRef);
+        uint32 Event = RteGen_MapGet(&Emitter->EventByPath, Mapping->EventRef);
+
+        Hash = RteGen_HashWord(Hash, Mapping->Position);
+        RteGen_CacheRecord(Cache, "task-mapping", Mapping->Path, Hash);
+        Cache->ScheduleInput = RteGen_HashWord(Cache->ScheduleInput, Hash);
+        if (Event != RTEGEN_NONE) {
+            uint32 Runnable = RteGen_MapGet(&Emitter->RunnableByPath, Model->Event[Event].RunnableRef);
+
+            if (Runnable != RTEGEN_NONE) {
+                uint32 Swc = Model->Runnable[Runnable].Swc;
+
+                Cache->SwcInput[Swc] = RteGen_HashWord(Cache->SwcInput[Swc], Hash);
+            }
+        }
+    }
+
+    Cache->CfgInput = Version;
+    Cache->DataInput = Version;
+    for (i = 0u; i < Model->NumSwc; i++) {
+        Cache->DataInput = RteGen_HashWord(Cache->DataInput, SwcHash[i]);
+        Cache->ScheduleInput = RteGen_HashWord(Cache->ScheduleInput, SwcHash[i]);
+    }
+    for (i = 0u; i < Model->NumElement; i++) {
+        Cache->DataInput = RteGen_HashWord(Cache->DataInput, ElementHash[i]);
+    }
+    for (i = 0u; i < Model->NumConnector; i++) {
+        Cache->DataInput = RteGen_HashWord(Cache->DataInput, ConnectorHash[i]);
+    }
+    for (i = 0u; i < Model->NumSignalMapping; i++) {
+        Cache->DataInput = RteGen_HashWord(Cache->DataInput, SignalHash[i]);
+    }
+
+    if (Cache->NumOldRecord > Cache->MatchedRecords) {
+        Cache->ChangedRecords += Cache->NumOldRecord - Cache->MatchedRecords;
+    }
+
+    free(SwcHash);
+    free(PortHash);
+    free(IntoPortHash);
+    free(FromPortHash);
+    free(ElementHash);
+    free(ConnectorHash);
+    free(SignalHash);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_CachePath(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Path, P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir,
+                                                P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name) {
+    Path->Length = 0u;
+    RteGen_Printf(Path, "%s/%s", OutDir, Name);
+}
+
+static FUNC(void, RTEGEN_CODE) RteGen_CacheAddOutput(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name,
+                                                     uint64 InputHash, uint64 ContentHash, uint64 Size) {
+    uint32 Output = RTEGEN_NEW(Cache, Output);
+
+    Cache->Output[Output].Name = RteGen_StrDup(Name, (uint32)strlen(Name));
+    Cache->Output[Output].InputHash = InputHash;
+    Cache->Output[Output].ContentHash = ContentHash;
+    Cache->Output[Output].Size = Size;
+}
+
+FUNC(boolean, RTEGEN_CODE) RteGen_CacheIsCurrent(P2CONST(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir,
+                                                 P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, uint64 InputHash) {
+    // Same inputs as last run and the file is still the one written then
+    uint32 Old = RteGen_MapGet(&Cache->OldOutputByName, Name);
+    RteGen_StringType Path = { NULL_PTR, 0u, 0u };
+    struct stat Info;
+    boolean Current = FALSE;
+
+    if ((Cache->Force == FALSE) && (Old != RTEGEN_NONE) && (Cache->OldOutput[Old].InputHash == InputHash)) {
+        RteGen_CachePath(&Path, OutDir, Name);
+        Current = ((stat(Path.Data, &Info) == 0) && ((uint64)Info.st_size == Cache->OldOutput[Old].Size)) ? TRUE : FALSE;
+        free(Path.Data);
+    }
+    return Current;
+}
+
+FUNC(void, RTEGEN_CODE) RteGen_CacheKeep(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name) {
+    P2CONST(RteGen_CacheOutputType, AUTOMATIC, RTEGEN_VAR) Old = &Cache->OldOutput[RteGen_MapGet(&Cache->OldOutputByName, Name)];
+
+    RteGen_CacheAddOutput(Cache, Name, Old->InputHash, Old->ContentHash, Old->Size);
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_SameOnDisk(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Path, P2CONST(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Content) {
+    // Byte comparison for outputs the cache does not know (first run, lost cache)
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File = fopen(Path, "rb");
+    P2VAR(char, AUTOMATIC, RTEGEN_VAR) Data;
+    struct stat Info;
+    boolean Same = FALSE;
+
+    if (File == NULL_PTR) {
+        return FALSE;
+    }
+    if ((fstat(fileno(File), &Info) == 0) && ((uint64)Info.st_size == Content->Length)) {
+        Data = malloc((size_t)Content->Length + 1u);
+        if ((Data != NULL_PTR) && (fread(Data, 1u, Content->Length, File) == Content->Length) && (memcmp(Data, Content->Data, Content->Length) == 0)) {
+            Same = TRUE;
+        }
+        free(Data);
+    }
+    (void)fclose(File);
+    return Same;
+}
+
+static FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_WriteFile(P2CONST(char, AUTOMATIC, RTEGEN_VAR) Path, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Data, uint32 Length) {
+    // Written next to the target and renamed, so a failed run never leaves a half file
+    RteGen_StringType Temp = { NULL_PTR, 0u, 0u };
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File;
+    Std_ReturnType Result = E_OK;
+
+    RteGen_Printf(&Temp, "%s.tmp", Path);
+    File = fopen(Temp.Data, "wb");
+    if ((File == NULL_PTR) || (fwrite(Data, 1u, Length, File) != Length)) {
+        Result = E_NOT_OK;
+    }
+    if ((File != NULL_PTR) && (fclose(File) != 0)) {
+        Result = E_NOT_OK;
+    }
+    if ((Result == E_OK) && (rename(Temp.Data, Path) != 0)) {
+        Result = E_NOT_OK;
+    }
+    if (Result != E_OK) {
+        fprintf(stderr, "rtegen: cannot write %s\n", Path);
+        (void)remove(Temp.Data);
+    }
+    free(Temp.Data);
+    return Result;
+}
+
+FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_CacheCommit(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir,
+                                                     P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name, uint64 InputHash,
+                                                     P2CONST(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) Content) {
+    // Write a regenerated output unless the file already has exactly this content
+    uint64 ContentHash = RteGen_Hash64(RTEGEN_FNV64_BASIS, Content->Data, Content->Length);
+    uint32 Old = RteGen_MapGet(&Cache->OldOutputByName, Name);
+    RteGen_StringType Path = { NULL_PTR, 0u, 0u };
+    struct stat Info;
+    boolean Same;
+    Std_ReturnType Result = E_OK;
+
+    Cache->Regenerated++;
+    RteGen_CachePath(&Path, OutDir, Name);
+    if ((Cache->Force == FALSE) && (Old != RTEGEN_NONE) && (Cache->OldOutput[Old].ContentHash == ContentHash) &&
+        (Cache->OldOutput[Old].Size == Content->Length)) {
+        Same = ((stat(Path.Data, &Info) == 0) && ((uint64)Info.st_size == Content->Length)) ? TRUE : FALSE;
+    } else {
+        Same = RteGen_SameOnDisk(Path.Data, Content);
+    }
+    if (Same == FALSE) {
+        Result = RteGen_WriteFile(Path.Data, Content->Data, Content->Length);
+        Cache->Rewritten++;
+    }
+    // A failed write is kept with zero hashes: regenerated next run, never removed as stale
+    RteGen_CacheAddOutput(Cache, Name, (Result == E_OK) ? InputHash : 0u, (Result == E_OK) ? ContentHash : 0u, Content->Length);
+    free(Path.Data);
+    return Result;
+}
+
+FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_CacheSave(P2VAR(RteGen_CacheType, AUTOMATIC, RTEGEN_VAR) Cache, P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir) {
+    RteGen_MapType NewOutputByName = { 0u, 0u, NULL_PTR, NULL_PTR };
+    RteGen_StringType Text = { NULL_PTR, 0u, 0u };
+    RteGen_StringType Path = { NULL_PTR, 0u, 0u };
+    Std_ReturnType Result;
+    uint32 i;
+
+    // Outputs of the previous run that this model no longer produces
+    for (i = 0u; i < Cache->NumOutput; i++) {
+        RteGen_MapPut(&NewOutputByName, Cache->Output[i].Name, i);
+    }
+    for (i = 0u; i < Cache->NumOldOutput; i++) {
+        if (RteGen_MapGet(&NewOutputByName, Cache->OldOutput[i].Name) == RTEGEN_NONE) {
+            RteGen_CachePath(&Path, OutDir, Cache->OldOutput[i].Name);
+            if (remove(Path.Data) == 0) {
+                Cache->Removed++;
+            }
+        }
+    }
+
+    RteGen_Printf(&Text, "%s\n", RTEGEN_CACHE_HEADER);
+    for (i = 0u; i < Cache->NumRecord; i++) {
+        RteGen_Printf(&Text, "R %016llx %s\n", (unsigned long long)Cache->Record[i].Hash, Cache->Record[i].Key);
+    }
+    for (i = 0u; i < Cache->NumOutput; i++) {
+        RteGen_Printf(&Text, "O %016llx %016llx %llu %s\n", (unsigned long long)Cache->Output[i].InputHash,
+                      (unsigned long long)Cache->Output[i].ContentHash, (unsigned long long)Cache->Output[i].Size, Cache->Output[i].Name);
+    }
+    RteGen_CachePath(&Path, OutDir, RTEGEN_CACHE_FILE);
+    Result = RteGen_WriteFile(Path.Data, Text.Data, Text.Length);
+    free(Text.Data);
+    free(Path.Data);
+    free(NewOutputByName.Keys);
+    free(NewOutputByName.Values);
+    return Result;
+}
+
+/* RTE GENERATOR - COMMAND LINE */
+// File: RteGen_Main.c
+#include "RteGen.h"
+
+static FUNC(void, RTEGEN_CODE) RteGen_Reset(P2VAR(RteGen_StringType, AUTOMATIC, RTEGEN_VAR) String) {
+    String->Length = 0u;
+    RteGen_Append(String, "", 0u);
+}
+
+int main(int argc, char** argv) {
+    static VAR(RteGen_ModelType, RTEGEN_VAR) Model;
+    static VAR(RteGen_EmitterType, RTEGEN_VAR) Emitter;
+    static VAR(RteGen_CacheType, RTEGEN_VAR) Cache;
+    RteGen_StringType Out = { NULL_PTR, 0u, 0u };
+    RteGen_StringType Extra = { NULL_PTR, 0u, 0u };
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) OutDir = ".";
+    uint64 Bytes = 0u;
+    uint32 Inputs = 0u;
+    Std_ReturnType Result = E_OK;
+    struct timespec Start, Parsed, Done;
+    sint32 i;
+    uint32 Swc;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &Start);
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc)) {
+            OutDir = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0) {
+            Cache.Force = TRUE;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: rtegen [-f] [-o <outdir>] <extract.arxml>...\n");
+            return 2;
+        } else {
+            if (RteGen_LoadArxml(argv[i], &Model, &Bytes) != E_OK) {
+                Result = E_NOT_OK;
+            }
+            Inputs++;
+        }
+    }
+    if ((Inputs == 0u) || (Result != E_OK)) {
+        if (Inputs == 0u) {
+            fprintf(stderr, "usage: rtegen [-f] [-o <outdir>] <extract.arxml>...\n");
+        }
+        return 2;
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &Parsed);
+
+    Emitter.Model = &Model;
+    RteGen_Resolve(&Emitter);
+    if (Emitter.Errors > 0u) {
+        fprintf(stderr, "rtegen: %u model errors, nothing generated\n", Emitter.Errors);
+        return 1;
+    }
+    RteGen_CacheLoad(&Cache, OutDir);
+    RteGen_CacheHashModel(&Cache, &Emitter);
+
+    if (RteGen_CacheIsCurrent(&Cache, OutDir, "Rte_Cfg.h", Cache.CfgInput) == TRUE) {
+        RteGen_CacheKeep(&Cache, "Rte_Cfg.h");
+    } else {
+        RteGen_Reset(&Out);
+        RteGen_EmitCfg(&Out);
+        Result |= RteGen_CacheCommit(&Cache, OutDir, "Rte_Cfg.h", Cache.CfgInput, &Out);
+    }
+
+    if ((RteGen_CacheIsCurrent(&Cache, OutDir, "Rte_Data.h", Cache.DataInput) == TRUE) &&
+        (RteGen_CacheIsCurrent(&Cache, OutDir, "Rte_Data.c", Cache.DataInput) == TRUE)) {
+        RteGen_CacheKeep(&Cache, "Rte_Data.h");
+        RteGen_CacheKeep(&Cache, "Rte_Data.c");
+    } else {
+        RteGen_Reset(&Out);
+        RteGen_Reset(&Extra);
+        RteGen_EmitData(&Extra, &Out, &Emitter);
+        Result |= RteGen_CacheCommit(&Cache, OutDir, "Rte_Data.h", Cache.DataInput, &Extra);
+        Result |= RteGen_CacheCommit(&Cache, OutDir, "Rte_Data.c", Cache.DataInput, &Out);
+    }
+
+    for (Swc = 0u; Swc < Model.NumSwc; Swc++) {
+        if (Model.Swc[Swc].Name == NULL_PTR) {
+            continue;
+        }
+        RteGen_Reset(&Extra);
+        RteGen_Printf(&Extra, "Rte_%s.c", Model.Swc[Swc].Name);
+        if (RteGen_CacheIsCurrent(&Cache, OutDir, Extra.Data, Cache.SwcInput[Swc]) == TRUE) {
+            RteGen_CacheKeep(&Cache, Extra.Data);
+        } else {
+            RteGen_Reset(&Out);
+            RteGen_EmitSwc(&Out, &Emitter, Swc);
+            Result |= RteGen_CacheCommit(&Cache, OutDir, Extra.Data, Cache.SwcInput[Swc], &Out);
+        }
+    }
+
+    if (RteGen_CacheIsCurrent(&Cache, OutDir, "Rte_Schedule.c", Cache.ScheduleInput) == TRUE) {
+        RteGen_CacheKeep(&Cache, "Rte_Schedule.c");
+    } else {
+        RteGen_Reset(&Out);
+        RteGen_EmitSchedule(&Out, &Emitter);
+        Result |= RteGen_CacheCommit(&Cache, OutDir, "Rte_Schedule.c", Cache.ScheduleInput, &Out);
+    }
+    Result |= RteGen_CacheSave(&Cache, OutDir);
+    (void)clock_gettime(CLOCK_MONOTONIC, &Done);
+
+    printf("rtegen: parsed %.1f MB in %.2f s (%u SWCs, %u ports, %u runnables, %u task mappings)\n",
+           (double)Bytes / 1e6,
+           (double)(Parsed.tv_sec - Start.tv_sec) + ((double)(Parsed.tv_nsec - Start.tv_nsec) * 1e-9),
+           Model.NumSwc, Model.NumPort, Model.NumRunnable, Model.NumTaskMapping);
+    printf("rtegen: %u of %u elements changed, %u of %u outputs regenerated, %u rewritten, %u removed in %.2f s\n",
+           Cache.ChangedRecords, Cache.NumRecord, Cache.Regenerated, Cache.NumOutput, Cache.Rewritten, Cache.Removed,
+           (double)(Done.tv_sec - Parsed.tv_sec) + ((double)(Done.tv_nsec - Parsed.tv_nsec) * 1e-9));
+    if (Emitter.Warnings > 0u) {
+        printf("rtegen: %u unresolved references\n", Emitter.Warnings);
+    }
+    free(Out.Data);
+    free(Extra.Data);
+    return (Result == E_OK) ? 0 : 1;
+}
+
+/* RTE GENERATOR - REGENERATION TEST */
+// File: RteGen_Test.c
+/* Host test of the incremental regeneration, run against the rtegen binary:
+ *   rtegen_test <path to rtegen>
+ * Two unconnected components, Front and Rear, are generated into a fresh
+ * directory; Gauge reads Rear's P-port. The model is then edited inside one
+ * component and generated again. The input hashes that rtegen records in
+ * .rtegen_cache tell which outputs were regenerated: the edited component's
+ * Rte_<Swc>.c, the files of its receivers and the outputs built from all
+ * components (Rte_Data.h/.c, Rte_Schedule.c), never an unrelated
+ * component's file or Rte_Cfg.h. Front comes first in the document, so a
+ * runnable added to it moves the runnable indices of Rear; a signal mapping
+ * added to Rear takes away the buffer Gauge reads. After every step the
+ * incremental output must equal a full generation of the same model. */
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "RteGen.h"
+
+#define RTEGEN_TEST_MAX_OUTPUTS     16u
+
+typedef struct {
+    char Name[64];
+    unsigned long long InputHash;
+} RteGen_TestOutputType;
+
+typedef struct {
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name;
+    boolean FrontExtraRunnable;
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) RearSymbol;
+    boolean RearMapped;                                     // Rear's element mapped to a system signal
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Regenerated;     // Outputs expected to change, space separated
+} RteGen_TestStepType;
+
+static CONST(RteGen_TestStepType, RTEGEN_CONST) RteGen_TestStep[] = {
+    { "runnable added to Front",      TRUE, "Rear_Run",   FALSE, "Rte_Front.c Rte_Data.h Rte_Data.c Rte_Schedule.c" },
+    { "symbol changed in Rear",       TRUE, "Rear_RunV2", FALSE, "Rte_Rear.c Rte_Gauge.c Rte_Data.h Rte_Data.c Rte_Schedule.c" },
+    { "signal mapping added to Rear", TRUE, "Rear_RunV2", TRUE,  "Rte_Rear.c Rte_Gauge.c Rte_Data.h Rte_Data.c" },
+    { "no change",                    TRUE, "Rear_RunV2", TRUE,  "" },
+};
+
+static FUNC(void, RTEGEN_CODE) RteGen_TestWriteSwc(P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Swc,
+                                                   P2CONST(char, AUTOMATIC, RTEGEN_VAR) Runnable, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Symbol) {
+    // One runnable writing the component's P-port
+    fprintf(File,
+            "  <RUNNABLE-ENTITY><SHORT-NAME>%s</SHORT-NAME><SYMBOL>%s</SYMBOL>\n"
+            "   <DATA-WRITE-ACCESSS><VARIABLE-ACCESS><SHORT-NAME>Write</SHORT-NAME><ACCESSED-VARIABLE><AUTOSAR-VARIABLE-IREF>\n"
+            "    <PORT-PROTOTYPE-REF DEST=\"P-PORT-PROTOTYPE\">/Swcs/%s/PP_Level</PORT-PROTOTYPE-REF>\n"
+            "    <TARGET-DATA-PROTOTYPE-REF DEST=\"VARIABLE-DATA-PROTOTYPE\">/Interfaces/Level_If/Level</TARGET-DATA-PROTOTYPE-REF>\n"
+            "   </AUTOSAR-VARIABLE-IREF></ACCESSED-VARIABLE></VARIABLE-ACCESS></DATA-WRITE-ACCESSS>\n"
+            "  </RUNNABLE-ENTITY>\n",
+            Runnable, Symbol, Swc);
+}
+
+static FUNC(Std_ReturnType, RTEGEN_CODE) RteGen_TestWriteModel(P2CONST(char, AUTOMATIC, RTEGEN_VAR) FileName,
+                                                               P2CONST(RteGen_TestStepType, AUTOMATIC, RTEGEN_CONST) Step) {
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File = fopen(FileName, "w");
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Swc[2] = { "Front", "Rear" };
+    uint32 i;
+
+    if (File == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    fprintf(File,
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<AUTOSAR xmlns=\"http://autosar.org/schema/r4.0\"><AR-PACKAGES>\n"
+            "<AR-PACKAGE><SHORT-NAME>Interfaces</SHORT-NAME><ELEMENTS>\n"
+            " <SENDER-RECEIVER-INTERFACE><SHORT-NAME>Level_If</SHORT-NAME><DATA-ELEMENTS>\n"
+            "  <VARIABLE-DATA-PROTOTYPE><SHORT-NAME>Level</SHORT-NAME><TYPE-TREF DEST=\"IMPLEMENTATION-DATA-TYPE\">/Types/uint8</TYPE-TREF></VARIABLE-DATA-PROTOTYPE>\n"
+            " </DATA-ELEMENTS></SENDER-RECEIVER-INTERFACE>\n"
+            "</ELEMENTS></AR-PACKAGE>\n"
+            "<AR-PACKAGE><SHORT-NAME>Swcs</SHORT-NAME><ELEMENTS>\n");
+    for (i = 0u; i < 2u; i++) {
+        fprintf(File,
+                "<APPLICATION-SW-COMPONENT-TYPE><SHORT-NAME>%s</SHORT-NAME>\n"
+                " <PORTS><P-PORT-PROTOTYPE><SHORT-NAME>PP_Level</SHORT-NAME>"
+                "<PROVIDED-INTERFACE-TREF DEST=\"SENDER-RECEIVER-INTERFACE\">/Interfaces/Level_If</PROVIDED-INTERFACE-TREF></P-PORT-PROTOTYPE></PORTS>\n"
+                " <INTERNAL-BEHAVIORS><SWC-INTERNAL-BEHAVIOR><SHORT-NAME>IB</SHORT-NAME><RUNNABLES>\n", Swc[i]);
+        if (i == 0u) {
+            RteGen_TestWriteSwc(File, Swc[i], "Front_Run", "Front_Run");
+            if (Step->FrontExtraRunnable == TRUE) {
+                RteGen_TestWriteSwc(File, Swc[i], "Front_Init", "Front_Init");
+            }
+        } else {
+            RteGen_TestWriteSwc(File, Swc[i], "Rear_Run", Step->RearSymbol);
+        }
+        fprintf(File, " </RUNNABLES></SWC-INTERNAL-BEHAVIOR></INTERNAL-BEHAVIORS>\n</APPLICATION-SW-COMPONENT-TYPE>\n");
+    }
+    fprintf(File,
+            "<APPLICATION-SW-COMPONENT-TYPE><SHORT-NAME>Gauge</SHORT-NAME>\n"
+            " <PORTS><R-PORT-PROTOTYPE><SHORT-NAME>RP_Level</SHORT-NAME>"
+            "<REQUIRED-INTERFACE-TREF DEST=\"SENDER-RECEIVER-INTERFACE\">/Interfaces/Level_If</REQUIRED-INTERFACE-TREF></R-PORT-PROTOTYPE></PORTS>\n"
+            " <INTERNAL-BEHAVIORS><SWC-INTERNAL-BEHAVIOR><SHORT-NAME>IB</SHORT-NAME><RUNNABLES>\n"
+            "  <RUNNABLE-ENTITY><SHORT-NAME>Gauge_Run</SHORT-NAME><SYMBOL>Gauge_Run</SYMBOL>\n"
+            "   <DATA-READ-ACCESSS><VARIABLE-ACCESS><SHORT-NAME>Read</SHORT-NAME><ACCESSED-VARIABLE><AUTOSAR-VARIABLE-IREF>\n"
+            "    <PORT-PROTOTYPE-REF DEST=\"R-PORT-PROTOTYPE\">/Swcs/Gauge/RP_Level</PORT-PROTOTYPE-REF>\n"
+            "    <TARGET-DATA-PROTOTYPE-REF DEST=\"VARIABLE-DATA-PROTOTYPE\">/Interfaces/Level_If/Level</TARGET-DATA-PROTOTYPE-REF>\n"
+            "   </AUTOSAR-VARIABLE-IREF></ACCESSED-VARIABLE></VARIABLE-ACCESS></DATA-READ-ACCESSS>\n"
+            "  </RUNNABLE-ENTITY>\n"
+            " </RUNNABLES></SWC-INTERNAL-BEHAVIOR></INTERNAL-BEHAVIORS>\n</APPLICATION-SW-COMPONENT-TYPE>\n"
+            "<COMPOSITION-SW-COMPONENT-TYPE><SHORT-NAME>Ecu</SHORT-NAME><CONNECTORS>\n"
+            " <ASSEMBLY-SW-CONNECTOR><SHORT-NAME>RearToGauge</SHORT-NAME>\n"
+            "  <PROVIDER-IREF><TARGET-P-PORT-REF DEST=\"P-PORT-PROTOTYPE\">/Swcs/Rear/PP_Level</TARGET-P-PORT-REF></PROVIDER-IREF>\n"
+            "  <REQUESTER-IREF><TARGET-R-PORT-REF DEST=\"R-PORT-PROTOTYPE\">/Swcs/Gauge/RP_Level</TARGET-R-PORT-REF></REQUESTER-IREF></ASSEMBLY-SW-CONNECTOR>\n"
+            "</CONNECTORS></COMPOSITION-SW-COMPONENT-TYPE>\n"
+            "</ELEMENTS></AR-PACKAGE>\n");
+    if (Step->RearMapped == TRUE) {
+        fprintf(File,
+                "<AR-PACKAGE><SHORT-NAME>System</SHORT-NAME><ELEMENTS><SYSTEM><SHORT-NAME>Sys</SHORT-NAME><MAPPINGS><SYSTEM-MAPPING><SHORT-NAME>M</SHORT-NAME><DATA-MAPPINGS>\n"
+                " <SENDER-RECEIVER-TO-SIGNAL-MAPPING><DATA-ELEMENT-IREF>\n"
+                "  <CONTEXT-PORT-REF DEST=\"P-PORT-PROTOTYPE\">/Swcs/Rear/PP_Level</CONTEXT-PORT-REF>\n"
+                "  <TARGET-DATA-PROTOTYPE-REF DEST=\"VARIABLE-DATA-PROTOTYPE\">/Interfaces/Level_If/Level</TARGET-DATA-PROTOTYPE-REF>\n"
+                " </DATA-ELEMENT-IREF><SYSTEM-SIGNAL-REF DEST=\"SYSTEM-SIGNAL\">/Signals/RearLevel</SYSTEM-SIGNAL-REF></SENDER-RECEIVER-TO-SIGNAL-MAPPING>\n"
+                "</DATA-MAPPINGS></SYSTEM-MAPPING></MAPPINGS></SYSTEM></ELEMENTS></AR-PACKAGE>\n");
+    }
+    fprintf(File, "</AR-PACKAGES></AUTOSAR>\n");
+    return (fclose(File) == 0) ? E_OK : E_NOT_OK;
+}
+
+static FUNC(uint32, RTEGEN_CODE) RteGen_TestRun(P2CONST(char, AUTOMATIC, RTEGEN_VAR) RteGen, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Dir,
+                                                P2VAR(RteGen_TestOutputType, AUTOMATIC, RTEGEN_VAR) Outputs) {
+    // Generate into <Dir>/inc, then read the output lines of the cache; 0 on failure
+    char Line[512];
+    P2VAR(FILE, AUTOMATIC, RTEGEN_VAR) File;
+    uint32 Count = 0u;
+
+    (void)snprintf(Line, sizeof(Line), "'%s' -o '%s/inc' '%s/model.arxml' >/dev/null", RteGen, Dir, Dir);
+    if (system(Line) != 0) {
+        return 0u;
+    }
+    (void)snprintf(Line, sizeof(Line), "%s/inc/.rtegen_cache", Dir);
+    File = fopen(Line, "r");
+    if (File == NULL_PTR) {
+        return 0u;
+    }
+    while ((Count < RTEGEN_TEST_MAX_OUTPUTS) && (fgets(Line, sizeof(Line), File) != NULL_PTR)) {
+        unsigned long long Content;
+        unsigned long long Size;
+
+        if (sscanf(Line, "O %llx %llx %llu %63s", &Outputs[Count].InputHash, &Content, &Size, Outputs[Count].Name) == 4) {
+            Count++;
+        }
+    }
+    (void)fclose(File);
+    return Count;
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_TestMatchesFull(P2CONST(char, AUTOMATIC, RTEGEN_VAR) RteGen, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Dir) {
+    // Generate the same model from scratch into <Dir>/full and compare every output
+    char Line[512];
+
+    (void)snprintf(Line, sizeof(Line), "rm -rf '%s/full' && mkdir '%s/full' && '%s' -o '%s/full' '%s/model.arxml' >/dev/null && "
+                   "diff -r -x .rtegen_cache '%s/inc' '%s/full' >/dev/null", Dir, Dir, RteGen, Dir, Dir, Dir, Dir);
+    return (system(Line) == 0) ? TRUE : FALSE;
+}
+
+static FUNC(boolean, RTEGEN_CODE) RteGen_TestExpected(P2CONST(char, AUTOMATIC, RTEGEN_VAR) List, P2CONST(char, AUTOMATIC, RTEGEN_VAR) Name) {
+    size_t Length = strlen(Name);
+    P2CONST(char, AUTOMATIC, RTEGEN_VAR) Found = strstr(List, Name);
+
+    while (Found != NULL_PTR) {
+        if (((Found == List) || (Found[-1] == ' ')) && ((Found[Length] == '\0') || (Found[Length] == ' '))) {
+            return TRUE;
+        }
+        Found = strstr(&Found[1], Name);
+    }
+    return FALSE;
+}
+
+int main(int argc, char** argv) {
+    static RteGen_TestOutputType Before[RTEGEN_TEST_MAX_OUTPUTS];
+    static RteGen_TestOutputType After[RTEGEN_TEST_MAX_OUTPUTS];
+    static const RteGen_TestStepType Initial = { "initial", FALSE, "Rear_Run", FALSE, "" };
+    char Dir[] = "/tmp/rtegen_test_XXXXXX";
+    char Model[sizeof(Dir) + 16u];
+    uint32 NumBefore;
+    uint32 NumAfter;
+    uint32 Failures = 0u;
+    uint32 Step;
+    uint32 i;
+    uint32 j;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: rtegen_test <rtegen>\n");
+        return 2;
+    }
+    if (mkdtemp(Dir) == NULL_PTR) {
+        perror("rtegen_test: mkdtemp");
+        return 2;
+    }
+    (void)snprintf(Model, sizeof(Model), "%s/inc", Dir);
+    if (mkdir(Model, 0777) != 0) {
+        perror("rtegen_test: mkdir");
+        return 2;
+    }
+    (void)snprintf(Model, sizeof(Model), "%s/model.arxml", Dir);
+    if ((RteGen_TestWriteModel(Model, &Initial) != E_OK) || ((NumBefore = RteGen_TestRun(argv[1], Dir, Before)) == 0u)) {
+        fprintf(stderr, "rtegen_test: initial generation failed\n");
+        return 1;
+    }
+
+    for (Step = 0u; Step < (uint32)(sizeof(RteGen_TestStep) / sizeof(RteGen_TestStep[0])); Step++) {
+        P2CONST(RteGen_TestStepType, AUTOMATIC, RTEGEN_CONST) Test = &RteGen_TestStep[Step];
+        uint32 StepFailures = 0u;
+
+        if ((RteGen_TestWriteModel(Model, Test) != E_OK) || ((NumAfter = RteGen_TestRun(argv[1], Dir, After)) != NumBefore)) {
+            printf("FAIL %s: generation failed or outputs added/removed\n", Test->Name);
+            Failures++;
+            continue;
+        }
+        for (i = 0u; i < NumAfter; i++) {
+            boolean Changed = TRUE;
+
+            for (j = 0u; j < NumBefore; j++) {
+                if (strcmp(Before[j].Name, After[i].Name) == 0) {
+                    Changed = (Before[j].InputHash != After[i].InputHash) ? TRUE : FALSE;
+                }
+            }
+            if (Changed != RteGen_TestExpected(Test->Regenerated, After[i].Name)) {
+                printf("FAIL %s: %s %s\n", Test->Name, After[i].Name, (Changed == TRUE) ? "regenerated" : "not regenerated");
+                StepFailures++;
+            }
+        }
+        if (RteGen_TestMatchesFull(argv[1], Dir) == FALSE) {
+            printf("FAIL %s: incremental output differs from a full generation\n", Test->Name);
+            StepFailures++;
+        }
+        if (StepFailures == 0u) {
+            printf("ok   %s\n", Test->Name);
+        }
+        Failures += StepFailures;
+        (void)memcpy(Before, After, sizeof(Before));
+    }
+
+    (void)snprintf(Model, sizeof(Model), "rm -rf '%s'", Dir);
+    (void)system(Model);
+    return (Failures == 0u) ? 0 : 1;
 }
 
 /*
@@ -479,13 +9443,17 @@ FUNC(Std_ReturnType, WDG_CODE) Wdg_SetTriggerCondition(uint16 timeout) {
  * RTE LAYER STACKS:
  * - RTE Interface: Port access and data conversion
  * - RTE Core: Message routing and scheduling
- * - RTE Generator: Code generation framework
+ * - RTE Generator: rtegen host tool, ARXML subset -> Rte_*.c via a streaming SAX parser,
+ *   incremental regeneration through a content-hashed dependency cache
  * 
  * SERVICE LAYER STACKS:
  * - COM: Signal packing/unpacking, transmission modes
  * - PduR: Message routing between modules
- * - DEM: Diagnostic event management
- * - DCM: Diagnostic communication
+ * - CanTp: ISO 15765-2 transport (CAN-FD frames up to 64 bytes, BS/STmin flow control, per-channel timers on a timing wheel)
+ * - DoIP: ISO 13400 entity on UDP/TCP 13400 (vehicle announcement, routing activation, epoll-served tester connections, diagnostic messages into DCM)
+ * - DEM: Diagnostic event management (SoA event memory, SWAR status-mask scans, counter/time debouncing in Dem_MainFunction, batched monitor reports, lock-free DTC status change log, DTC index by status bit)
+ * - DCM: Diagnostic communication (DTC mirror fed from the DEM change log, 0x19/0x22 responses streamed into TP frames)
+ * - FiM: Function inhibition from failed events
  * - NvM: Non-volatile memory management
  * - BswM: Mode management
  * - ComM: Communication management